@@ -0,0 +1,89 @@
+#include "bench_util.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace {
+
+std::atomic<size_t> numAllocations(0);
+std::atomic<size_t> numAllocatedBytes(0);
+
+void *allocate(size_t size) {
+  numAllocations.fetch_add(1, std::memory_order_relaxed);
+  numAllocatedBytes.fetch_add(size, std::memory_order_relaxed);
+  if (void *p = std::malloc(size ? size : 1)) {
+    return p;
+  }
+  throw std::bad_alloc();
+}
+
+} // namespace
+
+void *operator new(size_t size) { return allocate(size); }
+void *operator new[](size_t size) { return allocate(size); }
+void operator delete(void *p) noexcept { std::free(p); }
+void operator delete[](void *p) noexcept { std::free(p); }
+void operator delete(void *p, size_t) noexcept { std::free(p); }
+void operator delete[](void *p, size_t) noexcept { std::free(p); }
+
+namespace clangmetatool {
+namespace bench {
+
+AllocationSnapshot AllocationSnapshot::now() {
+  return {numAllocations.load(std::memory_order_relaxed),
+          numAllocatedBytes.load(std::memory_order_relaxed)};
+}
+
+void reportAllocations(benchmark::State &state,
+                       const AllocationSnapshot &start) {
+  AllocationSnapshot end = AllocationSnapshot::now();
+  state.counters["allocs"] =
+      benchmark::Counter(static_cast<double>(end.allocations -
+                                             start.allocations),
+                         benchmark::Counter::kAvgIterations);
+  state.counters["allocBytes"] = benchmark::Counter(
+      static_cast<double>(end.bytes - start.bytes),
+      benchmark::Counter::kAvgIterations, benchmark::Counter::OneK::kIs1024);
+}
+
+void corpusShapes(benchmark::internal::Benchmark *b) {
+  b->ArgNames({"depth", "fanout", "macros", "stmts", "loops", "vars"});
+  // Small, deep, wide, macro heavy, and with large functions
+  b->Args({2, 2, 2, 8, 1, 4});
+  b->Args({6, 2, 4, 16, 2, 8});
+  b->Args({2, 12, 4, 16, 2, 8});
+  b->Args({3, 3, 64, 16, 2, 8});
+  b->Args({2, 2, 4, 256, 4, 64});
+  b->Unit(benchmark::kMillisecond);
+}
+
+SyntheticCorpusParameters corpusParameters(const benchmark::State &state) {
+  SyntheticCorpusParameters p;
+  p.includeDepth = static_cast<unsigned>(state.range(0));
+  p.includeFanOut = static_cast<unsigned>(state.range(1));
+  p.macrosPerHeader = static_cast<unsigned>(state.range(2));
+  p.statementsPerFunction = static_cast<unsigned>(state.range(3));
+  p.loopNesting = static_cast<unsigned>(state.range(4));
+  p.variablesPerFunction = static_cast<unsigned>(state.range(5));
+  return p;
+}
+
+} // namespace bench
+} // namespace clangmetatool
+
+// ----------------------------------------------------------------------------
+// Copyright 2026 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,88 @@
+#ifndef INCLUDED_CLANGMETATOOL_BENCH_BENCH_UTIL_H
+#define INCLUDED_CLANGMETATOOL_BENCH_BENCH_UTIL_H
+
+#include "synthetic_corpus.h"
+
+#include <cstddef>
+#include <map>
+#include <string>
+
+#include <benchmark/benchmark.h>
+
+#include <clangmetatool/meta_tool.h>
+#include <clangmetatool/meta_tool_factory.h>
+
+#include <clang/Tooling/CompilationDatabase.h>
+#include <clang/Tooling/Core/Replacement.h>
+#include <clang/Tooling/Tooling.h>
+#include <llvm/Support/ErrorHandling.h>
+
+namespace clangmetatool {
+namespace bench {
+
+/**
+ * Number and size of the heap allocations made by the process so far,
+ * counted by the replacement of the global operator new in this
+ * executable.
+ */
+struct AllocationSnapshot {
+  size_t allocations;
+  size_t bytes;
+
+  static AllocationSnapshot now();
+};
+
+/**
+ * Report the allocations made since start, per iteration, as the
+ * "allocs" and "allocBytes" counters of the benchmark.
+ */
+void reportAllocations(benchmark::State &state,
+                       const AllocationSnapshot &start);
+
+/**
+ * Name the arguments of a benchmark taking its corpus from
+ * corpusParameters, and register the corpus shapes it runs with.
+ */
+void corpusShapes(benchmark::internal::Benchmark *b);
+
+/**
+ * Corpus parameters of a benchmark registered with corpusShapes.
+ */
+SyntheticCorpusParameters corpusParameters(const benchmark::State &state);
+
+/**
+ * Run Action<WrappedTool>, MetaTool by default, over every source file
+ * of the corpus.
+ */
+template <class WrappedTool, template <class> class Action = MetaTool>
+void runTool(const SyntheticCorpus &corpus) {
+  clang::tooling::FixedCompilationDatabase compilations(
+      corpus.getDirectory(), SyntheticCorpus::compileArguments());
+  clang::tooling::ClangTool tool(compilations, corpus.getSourceFiles());
+  std::map<std::string, clang::tooling::Replacements> replacements;
+  clangmetatool::MetaToolFactory<Action<WrappedTool>> factory(replacements);
+  if (tool.run(&factory) != 0) {
+    llvm::report_fatal_error("The synthetic corpus failed to compile");
+  }
+}
+
+} // namespace bench
+} // namespace clangmetatool
+
+#endif
+
+// ----------------------------------------------------------------------------
+// Copyright 2026 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
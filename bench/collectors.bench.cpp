@@ -0,0 +1,163 @@
+#include "bench_util.h"
+#include "synthetic_corpus.h"
+
+#include <map>
+#include <string>
+
+#include <benchmark/benchmark.h>
+
+#include <clangmetatool/collectors/definitions.h>
+#include <clangmetatool/collectors/find_calls.h>
+#include <clangmetatool/collectors/find_cxx_member_calls.h>
+#include <clangmetatool/collectors/find_functions.h>
+#include <clangmetatool/collectors/include_graph.h>
+#include <clangmetatool/collectors/member_method_decls.h>
+#include <clangmetatool/collectors/references.h>
+#include <clangmetatool/collectors/variable_refs.h>
+#include <clangmetatool/preprocessor_meta_tool.h>
+
+#include <clang/ASTMatchers/ASTMatchFinder.h>
+#include <clang/Frontend/CompilerInstance.h>
+#include <clang/Tooling/Core/Replacement.h>
+
+namespace {
+
+using namespace clangmetatool::bench;
+using namespace clangmetatool::collectors;
+
+/**
+ * Only parses, to tell the cost of the frontend from the cost of the
+ * collectors.
+ */
+class NoCollector {
+public:
+  NoCollector(clang::CompilerInstance *ci,
+              clang::ast_matchers::MatchFinder *f) {}
+
+  void postProcessing(
+      std::map<std::string, clang::tooling::Replacements> &replacementsMap) {}
+};
+
+template <class Collector> class CollectorTool {
+private:
+  Collector collector;
+
+public:
+  CollectorTool(clang::CompilerInstance *ci,
+                clang::ast_matchers::MatchFinder *f)
+      : collector(ci, f) {}
+
+  void postProcessing(
+      std::map<std::string, clang::tooling::Replacements> &replacementsMap) {
+    benchmark::DoNotOptimize(collector.getData());
+  }
+};
+
+class FindCallsTool {
+private:
+  FindCalls collector;
+
+public:
+  FindCallsTool(clang::CompilerInstance *ci,
+                clang::ast_matchers::MatchFinder *f)
+      : collector(ci, f, "f0") {}
+
+  void postProcessing(
+      std::map<std::string, clang::tooling::Replacements> &replacementsMap) {
+    benchmark::DoNotOptimize(collector.getData());
+  }
+};
+
+class FindCXXMemberCallsTool {
+private:
+  FindCXXMemberCalls collector;
+
+public:
+  FindCXXMemberCallsTool(clang::CompilerInstance *ci,
+                         clang::ast_matchers::MatchFinder *f)
+      : collector(ci, f, "S0", "get") {}
+
+  void postProcessing(
+      std::map<std::string, clang::tooling::Replacements> &replacementsMap) {
+    benchmark::DoNotOptimize(collector.getData());
+  }
+};
+
+/**
+ * The include graph without the details of every reference.
+ */
+class CountingIncludeGraphTool {
+private:
+  IncludeGraph collector;
+
+public:
+  CountingIncludeGraphTool(clang::CompilerInstance *ci,
+                           clang::ast_matchers::MatchFinder *f)
+      : collector(ci, f, IncludeGraphData::NoDetails) {}
+
+  void postProcessing(
+      std::map<std::string, clang::tooling::Replacements> &replacementsMap) {
+    benchmark::DoNotOptimize(collector.getData());
+  }
+};
+
+template <class Tool> void BM_Collector(benchmark::State &state) {
+  SyntheticCorpus corpus(corpusParameters(state));
+  AllocationSnapshot start = AllocationSnapshot::now();
+  for (auto _ : state) {
+    runTool<Tool>(corpus);
+  }
+  reportAllocations(state, start);
+}
+
+/**
+ * Same as BM_Collector, only preprocessing the translation units.
+ */
+template <class Tool> void BM_PreprocessorCollector(benchmark::State &state) {
+  SyntheticCorpus corpus(corpusParameters(state));
+  AllocationSnapshot start = AllocationSnapshot::now();
+  for (auto _ : state) {
+    runTool<Tool, clangmetatool::PreprocessorMetaTool>(corpus);
+  }
+  reportAllocations(state, start);
+}
+
+} // namespace
+
+BENCHMARK_TEMPLATE(BM_Collector, NoCollector)->Apply(corpusShapes);
+BENCHMARK_TEMPLATE(BM_Collector, CollectorTool<Definitions>)
+    ->Apply(corpusShapes);
+BENCHMARK_TEMPLATE(BM_Collector, FindCallsTool)->Apply(corpusShapes);
+BENCHMARK_TEMPLATE(BM_Collector, FindCXXMemberCallsTool)->Apply(corpusShapes);
+BENCHMARK_TEMPLATE(BM_Collector, CollectorTool<FindFunctions>)
+    ->Apply(corpusShapes);
+BENCHMARK_TEMPLATE(BM_Collector, CollectorTool<IncludeGraph>)
+    ->Apply(corpusShapes);
+BENCHMARK_TEMPLATE(BM_Collector, CountingIncludeGraphTool)
+    ->Apply(corpusShapes);
+BENCHMARK_TEMPLATE(BM_PreprocessorCollector, NoCollector)
+    ->Apply(corpusShapes);
+BENCHMARK_TEMPLATE(BM_PreprocessorCollector, CollectorTool<IncludeGraph>)
+    ->Apply(corpusShapes);
+BENCHMARK_TEMPLATE(BM_Collector, CollectorTool<MemberMethodDecls>)
+    ->Apply(corpusShapes);
+BENCHMARK_TEMPLATE(BM_Collector, CollectorTool<References>)
+    ->Apply(corpusShapes);
+BENCHMARK_TEMPLATE(BM_Collector, CollectorTool<VariableRefs>)
+    ->Apply(corpusShapes);
+
+// ----------------------------------------------------------------------------
+// Copyright 2026 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,279 @@
+#include "bench_util.h"
+#include "synthetic_corpus.h"
+
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <clangmetatool/collectors/include_graph.h>
+#include <clangmetatool/collectors/include_graph_data.h>
+#include <clangmetatool/include_graph_csr.h>
+#include <clangmetatool/include_graph_dependencies.h>
+#include <clangmetatool/include_graph_reachability.h>
+#include <clangmetatool/types/file_uid.h>
+
+#include <clang/ASTMatchers/ASTMatchFinder.h>
+#include <clang/Basic/SourceManager.h>
+#include <clang/Frontend/CompilerInstance.h>
+#include <clang/Tooling/Core/Replacement.h>
+
+namespace {
+
+using namespace clangmetatool::bench;
+using clangmetatool::IncludeGraphCSR;
+using clangmetatool::IncludeGraphDependencies;
+using clangmetatool::IncludeGraphReachability;
+using clangmetatool::collectors::IncludeGraphData;
+using clangmetatool::types::FileUID;
+
+/**
+ * The parts of the include graph of a translation unit that the
+ * dependency queries look at, which outlive the AST, and the files to
+ * query.
+ */
+struct TranslationUnitGraph {
+  IncludeGraphData data;
+  std::vector<FileUID> files;
+  std::unique_ptr<IncludeGraphCSR> csr;
+  std::unique_ptr<IncludeGraphReachability> reachability;
+};
+
+std::vector<TranslationUnitGraph> *collectedGraphs = nullptr;
+
+class CollectGraph {
+private:
+  clang::CompilerInstance *ci;
+  clangmetatool::collectors::IncludeGraph includeGraph;
+
+public:
+  CollectGraph(clang::CompilerInstance *ci,
+               clang::ast_matchers::MatchFinder *f)
+      : ci(ci), includeGraph(ci, f) {}
+
+  void postProcessing(
+      std::map<std::string, clang::tooling::Replacements> &replacementsMap) {
+    const IncludeGraphData *data = includeGraph.getData();
+    TranslationUnitGraph graph;
+    graph.data.fuid2name = data->fuid2name;
+    graph.data.include_graph = data->include_graph;
+    graph.data.use_graph = data->use_graph;
+    graph.data.usage_reference_count = data->usage_reference_count;
+
+    clang::SourceManager &sm = ci->getSourceManager();
+    graph.files.push_back(
+        sm.getFileEntryForID(sm.getMainFileID())->getUID());
+    for (const auto &file : data->fuid2name) {
+      graph.files.push_back(file.first);
+    }
+    collectedGraphs->push_back(std::move(graph));
+  }
+};
+
+std::vector<TranslationUnitGraph> collectGraphs(const SyntheticCorpus &corpus) {
+  std::vector<TranslationUnitGraph> graphs;
+  collectedGraphs = &graphs;
+  runTool<CollectGraph>(corpus);
+  collectedGraphs = nullptr;
+  return graphs;
+}
+
+/**
+ * Run the queries on the IncludeGraphData itself.
+ */
+struct OnData {
+  static void prepare(TranslationUnitGraph &graph) {}
+  static const IncludeGraphData *get(const TranslationUnitGraph &graph) {
+    return &graph.data;
+  }
+};
+
+/**
+ * Run the queries on an IncludeGraphCSR built beforehand.
+ */
+struct OnCSR {
+  static void prepare(TranslationUnitGraph &graph) {
+    graph.csr = std::make_unique<IncludeGraphCSR>(&graph.data);
+  }
+  static const IncludeGraphCSR *get(const TranslationUnitGraph &graph) {
+    return graph.csr.get();
+  }
+};
+
+/**
+ * Run the queries on an IncludeGraphReachability built beforehand.
+ */
+struct OnReachability {
+  static void prepare(TranslationUnitGraph &graph) {
+    OnCSR::prepare(graph);
+    graph.reachability =
+        std::make_unique<IncludeGraphReachability>(graph.csr.get());
+  }
+  static const IncludeGraphReachability *
+  get(const TranslationUnitGraph &graph) {
+    return graph.reachability.get();
+  }
+};
+
+struct CollectAllIncludes {
+  template <class Graph>
+  std::set<FileUID> operator()(const Graph *graph, FileUID file) const {
+    return IncludeGraphDependencies::collectAllIncludes(graph, file);
+  }
+};
+
+struct LiveDependencies {
+  template <class Graph>
+  std::set<FileUID> operator()(const Graph *graph, FileUID file) const {
+    return IncludeGraphDependencies::liveDependencies(graph, file);
+  }
+};
+
+struct LiveWeakDependencies {
+  template <class Graph>
+  IncludeGraphDependencies::DirectDependenciesMap
+  operator()(const Graph *graph, FileUID file) const {
+    return IncludeGraphDependencies::liveWeakDependencies(graph, file);
+  }
+};
+
+/**
+ * Run the query for every file of every translation unit.
+ */
+template <class Query, class View>
+void BM_DependencyQuery(benchmark::State &state) {
+  SyntheticCorpus corpus(corpusParameters(state));
+  std::vector<TranslationUnitGraph> graphs = collectGraphs(corpus);
+  for (TranslationUnitGraph &graph : graphs) {
+    View::prepare(graph);
+  }
+
+  Query query;
+  size_t numQueries = 0;
+  AllocationSnapshot start = AllocationSnapshot::now();
+  for (auto _ : state) {
+    for (const TranslationUnitGraph &graph : graphs) {
+      for (FileUID file : graph.files) {
+        benchmark::DoNotOptimize(query(View::get(graph), file));
+        ++numQueries;
+      }
+    }
+  }
+  reportAllocations(state, start);
+  state.counters["queries"] = benchmark::Counter(
+      static_cast<double>(numQueries), benchmark::Counter::kIsRate);
+}
+
+/**
+ * Building the IncludeGraphCSR of every translation unit.
+ */
+void BM_BuildIncludeGraphCSR(benchmark::State &state) {
+  SyntheticCorpus corpus(corpusParameters(state));
+  std::vector<TranslationUnitGraph> graphs = collectGraphs(corpus);
+
+  AllocationSnapshot start = AllocationSnapshot::now();
+  for (auto _ : state) {
+    for (const TranslationUnitGraph &graph : graphs) {
+      IncludeGraphCSR view(&graph.data);
+      benchmark::DoNotOptimize(view.numNodes());
+    }
+  }
+  reportAllocations(state, start);
+}
+
+/**
+ * Building the IncludeGraphReachability of every translation unit, from
+ * its IncludeGraphCSR.
+ */
+void BM_BuildIncludeGraphReachability(benchmark::State &state) {
+  SyntheticCorpus corpus(corpusParameters(state));
+  std::vector<TranslationUnitGraph> graphs = collectGraphs(corpus);
+  for (TranslationUnitGraph &graph : graphs) {
+    OnCSR::prepare(graph);
+  }
+
+  AllocationSnapshot start = AllocationSnapshot::now();
+  for (auto _ : state) {
+    for (const TranslationUnitGraph &graph : graphs) {
+      IncludeGraphReachability reachability(graph.csr.get());
+      benchmark::DoNotOptimize(reachability.numComponents());
+    }
+  }
+  reportAllocations(state, start);
+}
+
+/**
+ * The live dependencies of every file of every translation unit in one
+ * batch, including building the views they need, to compare with
+ * running liveDependencies for every file.
+ */
+void BM_AllLiveDependencies(benchmark::State &state) {
+  SyntheticCorpus corpus(corpusParameters(state));
+  std::vector<TranslationUnitGraph> graphs = collectGraphs(corpus);
+
+  AllocationSnapshot start = AllocationSnapshot::now();
+  for (auto _ : state) {
+    for (const TranslationUnitGraph &graph : graphs) {
+      IncludeGraphCSR csr(&graph.data);
+      IncludeGraphReachability reachability(&csr);
+      benchmark::DoNotOptimize(
+          IncludeGraphDependencies::allLiveDependencies(&reachability));
+    }
+  }
+  reportAllocations(state, start);
+}
+
+} // namespace
+
+BENCHMARK_TEMPLATE(BM_DependencyQuery, CollectAllIncludes, OnData)
+    ->Apply(corpusShapes)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_DependencyQuery, CollectAllIncludes, OnCSR)
+    ->Apply(corpusShapes)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_DependencyQuery, CollectAllIncludes, OnReachability)
+    ->Apply(corpusShapes)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_DependencyQuery, LiveDependencies, OnData)
+    ->Apply(corpusShapes)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_DependencyQuery, LiveDependencies, OnCSR)
+    ->Apply(corpusShapes)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_DependencyQuery, LiveDependencies, OnReachability)
+    ->Apply(corpusShapes)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_AllLiveDependencies)
+    ->Apply(corpusShapes)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_DependencyQuery, LiveWeakDependencies, OnData)
+    ->Apply(corpusShapes)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_DependencyQuery, LiveWeakDependencies, OnCSR)
+    ->Apply(corpusShapes)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_BuildIncludeGraphCSR)
+    ->Apply(corpusShapes)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_BuildIncludeGraphReachability)
+    ->Apply(corpusShapes)
+    ->Unit(benchmark::kMicrosecond);
+
+// ----------------------------------------------------------------------------
+// Copyright 2026 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,160 @@
+#include "bench_util.h"
+
+#include <cstdint>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <clangmetatool/collectors/include_graph_data.h>
+#include <clangmetatool/include_graph_csr.h>
+#include <clangmetatool/include_graph_dependencies.h>
+#include <clangmetatool/parallel_executor.h>
+#include <clangmetatool/parallel_include_graph_traversal.h>
+#include <clangmetatool/types/file_uid.h>
+
+namespace {
+
+using namespace clangmetatool::bench;
+using clangmetatool::IncludeGraphCSR;
+using clangmetatool::IncludeGraphDependencies;
+using clangmetatool::ParallelExecutor;
+using clangmetatool::ParallelIncludeGraphTraversal;
+using clangmetatool::collectors::IncludeGraphData;
+using clangmetatool::types::FileUID;
+
+/**
+ * The merged include graph of a large project, too large to get from
+ * the synthetic corpus: every file includes a few files after it, and
+ * now and then one before it to make cycles, and uses some of them.
+ */
+IncludeGraphData projectGraph(unsigned numFiles) {
+  std::mt19937 rng(25);
+  IncludeGraphData data;
+  for (FileUID file = 0; file < numFiles; ++file) {
+    data.fuid2name[file] = "file" + std::to_string(file);
+    for (unsigned i = 0; i < 8; ++i) {
+      FileUID included = rng() % numFiles;
+      if (included > file || rng() % 50 == 0) {
+        data.include_graph.insert({file, included});
+        if (rng() % 2 == 0) {
+          data.usage_reference_count[{file, included}] = 1;
+        }
+      }
+      if (rng() % 2 == 0) {
+        data.usage_reference_count[{file, FileUID(rng() % numFiles)}] = 1;
+      }
+    }
+  }
+  return data;
+}
+
+/**
+ * Run the query on the IncludeGraphCSR, one file at a time.
+ */
+struct OnCSR {
+  static const IncludeGraphCSR *get(const IncludeGraphCSR *csr,
+                                    const ParallelIncludeGraphTraversal *) {
+    return csr;
+  }
+};
+
+/**
+ * Run the query on a ParallelIncludeGraphTraversal.
+ */
+struct OnTraversal {
+  static const ParallelIncludeGraphTraversal *
+  get(const IncludeGraphCSR *, const ParallelIncludeGraphTraversal *t) {
+    return t;
+  }
+};
+
+struct LiveDependencies {
+  template <class Graph>
+  std::set<FileUID> operator()(const Graph *graph, FileUID file) const {
+    return IncludeGraphDependencies::liveDependencies(graph, file);
+  }
+};
+
+struct LiveWeakDependencies {
+  template <class Graph>
+  IncludeGraphDependencies::DirectDependenciesMap
+  operator()(const Graph *graph, FileUID file) const {
+    return IncludeGraphDependencies::liveWeakDependencies(graph, file);
+  }
+};
+
+/**
+ * Run the query for the first files of a project graph of range(0)
+ * files, which reach most of the graph, with range(1) worker threads.
+ */
+template <class Query, class View>
+void BM_ProjectGraphQuery(benchmark::State &state) {
+  IncludeGraphData data = projectGraph(state.range(0));
+  IncludeGraphCSR csr(&data);
+  ParallelExecutor executor(state.range(1));
+  ParallelIncludeGraphTraversal traversal(&csr, &executor);
+
+  Query query;
+  size_t numQueries = 0;
+  AllocationSnapshot start = AllocationSnapshot::now();
+  for (auto _ : state) {
+    for (FileUID file = 0; file < 8; ++file) {
+      benchmark::DoNotOptimize(query(View::get(&csr, &traversal), file));
+      ++numQueries;
+    }
+  }
+  reportAllocations(state, start);
+  state.counters["queries"] = benchmark::Counter(
+      static_cast<double>(numQueries), benchmark::Counter::kIsRate);
+}
+
+void projectShapes(benchmark::internal::Benchmark *b) {
+  b->ArgNames({"files", "threads"});
+  for (int64_t files : {10000, 200000}) {
+    for (int64_t threads : {1, 4}) {
+      b->Args({files, threads});
+    }
+  }
+}
+
+} // namespace
+
+BENCHMARK_TEMPLATE(BM_ProjectGraphQuery, LiveDependencies, OnCSR)
+    ->Args({10000, 1})
+    ->Args({200000, 1})
+    ->ArgNames({"files", "threads"})
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_ProjectGraphQuery, LiveDependencies, OnTraversal)
+    ->Apply(projectShapes)
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_ProjectGraphQuery, LiveWeakDependencies, OnCSR)
+    ->Args({10000, 1})
+    ->Args({200000, 1})
+    ->ArgNames({"files", "threads"})
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_ProjectGraphQuery, LiveWeakDependencies, OnTraversal)
+    ->Apply(projectShapes)
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+
+// ----------------------------------------------------------------------------
+// Copyright 2026 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
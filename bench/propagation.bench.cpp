@@ -0,0 +1,118 @@
+#include "bench_util.h"
+#include "synthetic_corpus.h"
+
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <clangmetatool/propagation/constant_cstring_propagator.h>
+#include <clangmetatool/propagation/constant_integer_propagator.h>
+
+#include <clang/ASTMatchers/ASTMatchFinder.h>
+#include <clang/ASTMatchers/ASTMatchers.h>
+#include <clang/Frontend/CompilerInstance.h>
+#include <clang/Tooling/Core/Replacement.h>
+
+namespace {
+
+using namespace clang::ast_matchers;
+using namespace clangmetatool::bench;
+
+using VariableUse =
+    std::pair<const clang::FunctionDecl *, const clang::DeclRefExpr *>;
+
+class FindVariableUses : public MatchFinder::MatchCallback {
+private:
+  std::vector<VariableUse> &uses;
+
+public:
+  explicit FindVariableUses(std::vector<VariableUse> &uses) : uses(uses) {}
+
+  virtual void run(const MatchFinder::MatchResult &r) override {
+    uses.emplace_back(r.Nodes.getNodeAs<clang::FunctionDecl>("func"),
+                      r.Nodes.getNodeAs<clang::DeclRefExpr>("declRef"));
+  }
+};
+
+/**
+ * Propagate the value of every use of a local variable matched by
+ * Variables::matcher(), with Propagator.
+ */
+template <class Propagator, class Variables> class PropagationTool {
+private:
+  clang::CompilerInstance *ci;
+  std::vector<VariableUse> uses;
+  FindVariableUses callback;
+
+public:
+  PropagationTool(clang::CompilerInstance *ci, MatchFinder *f)
+      : ci(ci), callback(uses) {
+    f->addMatcher(
+        declRefExpr(to(varDecl(hasLocalStorage(), Variables::matcher())),
+                    hasAncestor(functionDecl(isDefinition()).bind("func")))
+            .bind("declRef"),
+        &callback);
+  }
+
+  void postProcessing(
+      std::map<std::string, clang::tooling::Replacements> &replacementsMap) {
+    Propagator propagator(ci);
+    for (const VariableUse &use : uses) {
+      auto result = propagator.runPropagation(use.first, use.second);
+      benchmark::DoNotOptimize(result.isUnresolved());
+    }
+  }
+};
+
+struct Integers {
+  static DeclarationMatcher matcher() {
+    return varDecl(hasType(isInteger()));
+  }
+};
+
+struct CStrings {
+  static DeclarationMatcher matcher() {
+    return varDecl(hasType(pointerType(pointee(isAnyCharacter()))));
+  }
+};
+
+template <class Tool> void BM_Propagation(benchmark::State &state) {
+  SyntheticCorpus corpus(corpusParameters(state));
+  AllocationSnapshot start = AllocationSnapshot::now();
+  for (auto _ : state) {
+    runTool<Tool>(corpus);
+  }
+  reportAllocations(state, start);
+}
+
+} // namespace
+
+BENCHMARK_TEMPLATE(
+    BM_Propagation,
+    PropagationTool<clangmetatool::propagation::ConstantIntegerPropagator,
+                    Integers>)
+    ->Apply(corpusShapes);
+BENCHMARK_TEMPLATE(
+    BM_Propagation,
+    PropagationTool<clangmetatool::propagation::ConstantCStringPropagator,
+                    CStrings>)
+    ->Apply(corpusShapes);
+
+// ----------------------------------------------------------------------------
+// Copyright 2026 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,238 @@
+#include "synthetic_corpus.h"
+
+#include <llvm/ADT/SmallString.h>
+#include <llvm/ADT/Twine.h>
+#include <llvm/Support/ErrorHandling.h>
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/Path.h>
+#include <llvm/Support/raw_ostream.h>
+
+#include <algorithm>
+#include <random>
+#include <system_error>
+
+namespace clangmetatool {
+namespace bench {
+
+namespace {
+
+std::string headerName(unsigned n) { return "h" + std::to_string(n) + ".h"; }
+
+std::string writeFile(const std::string &directory, const std::string &name,
+                      const std::string &contents) {
+  llvm::SmallString<256> path(directory);
+  llvm::sys::path::append(path, name);
+  std::error_code ec;
+  llvm::raw_fd_ostream ofs(path, ec);
+  if (ec) {
+    llvm::report_fatal_error("Unable to write " + path + ": " + ec.message());
+  }
+  ofs << contents;
+  return path.str().str();
+}
+
+/**
+ * The headers of each level, from the ones included by the source files
+ * to the ones that include nothing.
+ */
+std::vector<std::vector<unsigned>>
+headerLevels(const SyntheticCorpusParameters &p) {
+  std::vector<std::vector<unsigned>> levels;
+  unsigned next = 0;
+  size_t width = p.includeFanOut;
+  for (unsigned d = 0; d < p.includeDepth; ++d) {
+    std::vector<unsigned> level;
+    for (size_t i = 0; i < width; ++i) {
+      level.push_back(next++);
+    }
+    levels.push_back(std::move(level));
+    width *= p.includeFanOut;
+  }
+  return levels;
+}
+
+std::string headerContents(const SyntheticCorpusParameters &p, unsigned n,
+                           const std::vector<unsigned> &includes) {
+  std::string guard = "INCLUDED_H" + std::to_string(n);
+  std::string id = std::to_string(n);
+  std::string s;
+  s += "#ifndef " + guard + "\n#define " + guard + "\n\n";
+  for (unsigned child : includes) {
+    s += "#include \"" + headerName(child) + "\"\n";
+  }
+  s += "\n";
+  for (unsigned k = 0; k < p.macrosPerHeader; ++k) {
+    s += "#define M" + id + "_" + std::to_string(k) + " (" + id + " + " +
+         std::to_string(k) + ")\n";
+  }
+  s += "\nstruct S" + id + " {\n  int value;\n  int get() const { return value";
+  if (p.macrosPerHeader > 0) {
+    s += " + M" + id + "_0";
+  }
+  s += "; }\n};\n\n";
+  s += "int f" + id + "(int x);\n";
+  s += "extern int v" + id + ";\n\n";
+  s += "#endif\n";
+  return s;
+}
+
+class FunctionWriter {
+private:
+  const SyntheticCorpusParameters &p;
+  unsigned numHeaders;
+  unsigned numInts;
+  unsigned numStrings;
+  std::mt19937 &random;
+
+  unsigned pick(unsigned n) {
+    return std::uniform_int_distribution<unsigned>(0, n - 1)(random);
+  }
+
+  std::string anInt() { return "a" + std::to_string(pick(numInts)); }
+
+  std::string aMacro(const std::string &header) {
+    if (p.macrosPerHeader == 0) {
+      return "1";
+    }
+    return "M" + header + "_" + std::to_string(pick(p.macrosPerHeader));
+  }
+
+  std::string statement(unsigned k) {
+    std::string header = std::to_string(pick(numHeaders));
+    switch (k % 4) {
+    case 0:
+      return anInt() + " = " + anInt() + " + " + aMacro(header) + ";";
+    case 1:
+      return anInt() + " += f" + header + "(" + anInt() + ") + v" + header +
+             ";";
+    case 2:
+      return "{ S" + header + " o = {" + anInt() + "}; " + anInt() +
+             " = o.get() + " + aMacro(header) + "; }";
+    default:
+      return "if (" + anInt() + " > " + std::to_string(k) + ") { c" +
+             std::to_string(pick(numStrings)) + " = \"s" + std::to_string(k) +
+             "\"; }";
+    }
+  }
+
+public:
+  FunctionWriter(const SyntheticCorpusParameters &p, unsigned numHeaders,
+                 std::mt19937 &random)
+      : p(p), numHeaders(numHeaders),
+        numInts(std::max(1u, p.variablesPerFunction)),
+        numStrings(std::max(1u, p.variablesPerFunction / 2)), random(random) {
+  }
+
+  std::string write(const std::string &name) {
+    std::string s = "int " + name + "(int arg) {\n";
+    for (unsigned i = 0; i < numInts; ++i) {
+      s += "  int a" + std::to_string(i) + " = " +
+           (i == 0 ? std::string("arg") : std::to_string(i)) + ";\n";
+    }
+    for (unsigned i = 0; i < numStrings; ++i) {
+      s += "  const char *c" + std::to_string(i) + " = \"c" +
+           std::to_string(i) + "\";\n";
+    }
+
+    std::string indent = "  ";
+    for (unsigned d = 0; d < p.loopNesting; ++d) {
+      std::string l = "l" + std::to_string(d);
+      s += indent + "for (int " + l + " = 0; " + l + " < 4; ++" + l +
+           ") {\n";
+      indent += "  ";
+    }
+    for (unsigned k = 0; k < p.statementsPerFunction; ++k) {
+      s += indent + statement(k) + "\n";
+    }
+    for (unsigned d = 0; d < p.loopNesting; ++d) {
+      indent.resize(indent.size() - 2);
+      s += indent + "}\n";
+    }
+
+    s += "  int result = 0;\n";
+    for (unsigned i = 0; i < numInts; ++i) {
+      s += "  result += a" + std::to_string(i) + ";\n";
+    }
+    for (unsigned i = 0; i < numStrings; ++i) {
+      s += "  result += c" + std::to_string(i) + "[0];\n";
+    }
+    s += "  return result;\n}\n\n";
+    return s;
+  }
+};
+
+} // namespace
+
+SyntheticCorpus::SyntheticCorpus(const SyntheticCorpusParameters &p) {
+  if (p.includeDepth == 0 || p.includeFanOut == 0) {
+    llvm::report_fatal_error("A synthetic corpus needs at least one header");
+  }
+
+  llvm::SmallString<256> path;
+  std::error_code ec =
+      llvm::sys::fs::createUniqueDirectory("clangmetatool-bench", path);
+  if (ec) {
+    llvm::report_fatal_error(
+        llvm::Twine("Unable to create a corpus directory: ") + ec.message());
+  }
+  directory = path.str().str();
+
+  auto levels = headerLevels(p);
+  unsigned numHeaders = 0;
+  for (size_t d = 0; d < levels.size(); ++d) {
+    for (size_t i = 0; i < levels[d].size(); ++i) {
+      std::vector<unsigned> includes;
+      if (d + 1 < levels.size()) {
+        for (unsigned k = 0; k < p.includeFanOut; ++k) {
+          includes.push_back(levels[d + 1][i * p.includeFanOut + k]);
+        }
+      }
+      unsigned n = levels[d][i];
+      headers.push_back(writeFile(directory, headerName(n),
+                                  headerContents(p, n, includes)));
+      ++numHeaders;
+    }
+  }
+
+  std::mt19937 random(p.seed);
+  for (unsigned f = 0; f < p.sourceFiles; ++f) {
+    std::string s;
+    for (unsigned n : levels[0]) {
+      s += "#include \"" + headerName(n) + "\"\n";
+    }
+    s += "\n";
+    FunctionWriter writer(p, numHeaders, random);
+    for (unsigned i = 0; i < p.functionsPerFile; ++i) {
+      s += writer.write("g" + std::to_string(f) + "_" + std::to_string(i));
+    }
+    sourceFiles.push_back(
+        writeFile(directory, "s" + std::to_string(f) + ".cpp", s));
+  }
+}
+
+SyntheticCorpus::~SyntheticCorpus() {
+  llvm::sys::fs::remove_directories(directory);
+}
+
+std::vector<std::string> SyntheticCorpus::compileArguments() {
+  return {"-xc++", "-std=c++14"};
+}
+
+} // namespace bench
+} // namespace clangmetatool
+
+// ----------------------------------------------------------------------------
+// Copyright 2026 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
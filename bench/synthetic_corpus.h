@@ -0,0 +1,133 @@
+#ifndef INCLUDED_CLANGMETATOOL_BENCH_SYNTHETIC_CORPUS_H
+#define INCLUDED_CLANGMETATOOL_BENCH_SYNTHETIC_CORPUS_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace clangmetatool {
+namespace bench {
+
+/**
+ * Shape of a generated corpus.
+ */
+struct SyntheticCorpusParameters {
+  /**
+   * Levels of headers below each source file, at least one.
+   */
+  unsigned includeDepth = 3;
+
+  /**
+   * Headers included by each source file and by each header that is not
+   * on the last level, at least one. Level d has includeFanOut^(d+1)
+   * headers.
+   */
+  unsigned includeFanOut = 3;
+
+  /**
+   * Macros defined by each header. Every other statement of the
+   * generated functions uses one of them.
+   */
+  unsigned macrosPerHeader = 4;
+
+  /**
+   * Statements in the innermost loop of each function.
+   */
+  unsigned statementsPerFunction = 16;
+
+  /**
+   * Loops nested around the statements of each function.
+   */
+  unsigned loopNesting = 2;
+
+  /**
+   * Local integer variables of each function, there are half as many
+   * local string variables.
+   */
+  unsigned variablesPerFunction = 8;
+
+  /**
+   * Number of source files.
+   */
+  unsigned sourceFiles = 4;
+
+  /**
+   * Functions defined in each source file.
+   */
+  unsigned functionsPerFile = 8;
+
+  /**
+   * Seed of the choices of headers and variables used by the statements.
+   */
+  uint32_t seed = 1;
+};
+
+/**
+ * A corpus of C++ files generated in a temporary directory, which is
+ * removed along with the object.
+ *
+ * Header number n declares a struct "S<n>" with a const method "get", a
+ * function "f<n>", a variable "v<n>" and the macros "M<n>_<k>". The
+ * source files define functions "g<file>_<function>" that use them.
+ */
+class SyntheticCorpus {
+private:
+  std::string directory;
+  std::vector<std::string> headers;
+  std::vector<std::string> sourceFiles;
+
+public:
+  /**
+   * Generate the corpus, calling llvm::report_fatal_error if it can't be
+   * written.
+   */
+  explicit SyntheticCorpus(const SyntheticCorpusParameters &parameters);
+
+  ~SyntheticCorpus();
+
+  SyntheticCorpus(const SyntheticCorpus &) = delete;
+  SyntheticCorpus &operator=(const SyntheticCorpus &) = delete;
+
+  /**
+   * Directory holding every file of the corpus.
+   */
+  const std::string &getDirectory() const { return directory; }
+
+  /**
+   * Absolute paths of the headers.
+   */
+  const std::vector<std::string> &getHeaders() const { return headers; }
+
+  /**
+   * Absolute paths of the source files.
+   */
+  const std::vector<std::string> &getSourceFiles() const {
+    return sourceFiles;
+  }
+
+  /**
+   * Arguments to compile any of the source files with.
+   */
+  static std::vector<std::string> compileArguments();
+};
+
+} // namespace bench
+} // namespace clangmetatool
+
+#endif
+
+// ----------------------------------------------------------------------------
+// Copyright 2026 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
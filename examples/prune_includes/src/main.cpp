@@ -0,0 +1,169 @@
+#include <map>
+#include <string>
+#include <system_error>
+#include <tuple>
+#include <vector>
+
+#include <clang/ASTMatchers/ASTMatchFinder.h>
+#include <clang/Frontend/CompilerInstance.h>
+#include <clang/Tooling/CommonOptionsParser.h>
+#include <clang/Tooling/Core/Replacement.h>
+#include <llvm/Support/CommandLine.h>
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/MemoryBuffer.h>
+#include <llvm/Support/raw_ostream.h>
+
+#include <clangmetatool/collectors/include_graph.h>
+#include <clangmetatool/collectors/include_graph_data.h>
+#include <clangmetatool/include_pruner.h>
+#include <clangmetatool/meta_tool.h>
+#include <clangmetatool/meta_tool_factory.h>
+
+namespace {
+
+/**
+ * Collects the include graph of every translation unit, without the
+ * details of each reference, and hands it to the pruner shared by all
+ * of them.
+ */
+class PruneIncludesTool {
+private:
+  clang::CompilerInstance *ci;
+  clangmetatool::collectors::IncludeGraph includeGraph;
+  clangmetatool::IncludePruner *pruner;
+
+public:
+  typedef std::tuple<clangmetatool::IncludePruner *> ArgTypes;
+
+  PruneIncludesTool(clang::CompilerInstance *ci,
+                    clang::ast_matchers::MatchFinder *f, ArgTypes args)
+      : ci(ci),
+        includeGraph(ci, f,
+                     clangmetatool::collectors::IncludeGraphData::NoDetails),
+        pruner(std::get<0>(args)) {}
+
+  void postProcessing(
+      std::map<std::string, clang::tooling::Replacements> &replacementsMap) {
+    pruner->add(includeGraph.getData(), ci->getSourceManager());
+  }
+};
+
+/**
+ * Apply the replacements to the files they are for. Returns false if
+ * any file could not be rewritten.
+ */
+bool applyReplacements(
+    const std::map<std::string, clang::tooling::Replacements> &replacements) {
+  bool ok = true;
+  for (const auto &p : replacements) {
+    auto buffer = llvm::MemoryBuffer::getFile(p.first);
+    if (!buffer) {
+      llvm::errs() << p.first << ": " << buffer.getError().message() << "\n";
+      ok = false;
+      continue;
+    }
+
+    auto code = clang::tooling::applyAllReplacements((*buffer)->getBuffer(),
+                                                     p.second);
+    if (!code) {
+      llvm::errs() << p.first << ": " << llvm::toString(code.takeError())
+                   << "\n";
+      ok = false;
+      continue;
+    }
+
+    std::error_code ec;
+    llvm::raw_fd_ostream os(p.first, ec);
+    if (ec) {
+      llvm::errs() << p.first << ": " << ec.message() << "\n";
+      ok = false;
+      continue;
+    }
+    os << *code;
+  }
+  return ok;
+}
+
+} // namespace
+
+int main(int argc, const char *argv[]) {
+  llvm::cl::OptionCategory PruneIncludesCategory("prune-includes options");
+
+  llvm::cl::opt<unsigned> Jobs(
+      "j",
+      llvm::cl::desc("Number of translation units processed at the same "
+                     "time, zero for one per hardware thread"),
+      llvm::cl::init(0), llvm::cl::cat(PruneIncludesCategory));
+
+  llvm::cl::opt<std::string> ExportFixes(
+      "export-fixes",
+      llvm::cl::desc("Write the deletions to the given YAML file instead of "
+                     "applying them"),
+      llvm::cl::value_desc("file"), llvm::cl::cat(PruneIncludesCategory));
+
+  llvm::cl::extrahelp CommonHelp(
+      clang::tooling::CommonOptionsParser::HelpMessage);
+  llvm::cl::extrahelp MoreHelp(
+      "\nAn include is deleted when no translation unit needs it, so every\n"
+      "translation unit that includes a header must be processed for the\n"
+      "includes of that header to be deleted. Without source files, every\n"
+      "file of the compilation database is processed.\n");
+
+  auto parseResult = clang::tooling::CommonOptionsParser::create(
+      argc, argv, PruneIncludesCategory, llvm::cl::ZeroOrMore);
+  if (!parseResult) {
+    llvm::errs() << parseResult.takeError();
+    return 1;
+  }
+
+  const clang::tooling::CompilationDatabase &compilations =
+      parseResult->getCompilations();
+  std::vector<std::string> sourcePaths = parseResult->getSourcePathList();
+  if (sourcePaths.empty()) {
+    sourcePaths = compilations.getAllFiles();
+  }
+
+  clangmetatool::IncludePruner pruner;
+  std::map<std::string, clang::tooling::Replacements> replacements;
+  PruneIncludesTool::ArgTypes toolArgs(&pruner);
+  clangmetatool::MetaToolFactory<clangmetatool::MetaTool<PruneIncludesTool>>
+      raf(replacements, toolArgs);
+
+  // A translation unit that failed could be the one needing an include,
+  // so nothing is deleted then.
+  int r = raf.runParallel(compilations, sourcePaths, Jobs);
+  if (r != 0) {
+    llvm::errs() << "Some translation units failed, no include deleted\n";
+    return r;
+  }
+
+  raf.mergeReplacements(pruner.getReplacements());
+  if (!ExportFixes.empty()) {
+    std::error_code ec;
+    llvm::raw_fd_ostream os(ExportFixes, ec);
+    if (ec) {
+      llvm::errs() << ExportFixes << ": " << ec.message() << "\n";
+      return 1;
+    }
+    raf.exportFixes(os);
+    return 0;
+  }
+
+  return applyReplacements(replacements) ? 0 : 1;
+}
+
+// ----------------------------------------------------------------------------
+// Copyright 2026 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
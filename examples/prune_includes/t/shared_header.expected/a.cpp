@@ -0,0 +1,3 @@
+#include "text.h"
+
+int a() { return length("a"); }
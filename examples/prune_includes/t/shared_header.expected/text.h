@@ -0,0 +1,6 @@
+#pragma once
+
+#include "config.h"
+#include "types.h"
+
+size_type length(const char *s);
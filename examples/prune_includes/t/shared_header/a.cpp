@@ -0,0 +1,4 @@
+#include "text.h"
+#include "unused.h"
+
+int a() { return length("a"); }
@@ -0,0 +1,4 @@
+#include "config.h"
+#include "text.h"
+
+int b() { return VERSION; }
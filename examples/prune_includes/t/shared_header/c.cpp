@@ -0,0 +1,3 @@
+#include "text.h"
+
+int c() { return length("c") + VERSION; }
@@ -0,0 +1,7 @@
+#pragma once
+
+#include "config.h"
+#include "types.h"
+#include "unused.h"
+
+size_type length(const char *s);
@@ -0,0 +1,12 @@
+#!/bin/sh
+# Arguments to this script are:
+#  1. the path to the tool as built by CMake
+#  2. CMAKE_CURRENT_SOURCE_DIR
+#  3. CMAKE_CURRENT_BINARY_DIR
+#  4. the name of the test case
+set -x
+set -e
+rm -rf $3/$4
+cp -r $2/$4 $3/$4
+$1 -j 2 $3/$4/*.cpp -- -xc++
+diff -ru $2/$4.expected $3/$4
@@ -60,19 +60,12 @@ public:
     clang::SourceManager &sm = ctx.getSourceManager();
 
     // what is the file id for ye_olde_feature_toggle.h
-    bool found_header = false;
-    clangmetatool::types::FileUID header_fuid = 0;
-    for (auto item : igdata->fuid2name) {
-      if (item.second == "ye_olde_feature_toggle.h") {
-        found_header = true;
-        header_fuid = item.first;
-        break;
-      }
-    }
+    auto header = igdata->name2fuid.find("ye_olde_feature_toggle.h");
 
     // bail early if the header was not used
-    if (!found_header)
+    if (header == igdata->name2fuid.end())
       return;
+    clangmetatool::types::FileUID header_fuid = header->second;
 
     // accumulate all the calls, the argument, and its optional determinstic
     // value
@@ -33,9 +33,16 @@ private:
 public:
   /**
    * Explicit constructor, to allow for implementation details.
+   *
+   * The details are the `IncludeGraphData::Details` flags of the
+   * reference multimaps to fill. Tools that only need the include
+   * graph, the include statements and the reference counts can pass
+   * `IncludeGraphData::NoDetails`, which saves keeping every reference
+   * in memory.
    */
   IncludeGraph(clang::CompilerInstance *ci,
-               clang::ast_matchers::MatchFinder *f);
+               clang::ast_matchers::MatchFinder *f,
+               unsigned details = IncludeGraphData::AllDetails);
 
   /**
    * Explicit destructor.
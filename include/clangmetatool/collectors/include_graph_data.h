@@ -10,6 +10,8 @@
 #include <clang/Frontend/CompilerInstance.h>
 #include <map>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 #include <clangmetatool/types/file_attribute_map.h>
 #include <clangmetatool/types/file_attribute_multimap.h>
@@ -27,6 +29,36 @@ namespace collectors {
  */
 struct IncludeGraphData {
 
+  /**
+   * The multimaps of references between files, to be combined as flags
+   * to choose which ones the collector fills. Every reference is counted
+   * in usage_reference_count and added to use_graph either way.
+   *
+   * ForwardDeclarationDetails tells which uses need the definition of
+   * what they use, in definition_uses and, with TypeReferenceDetails,
+   * forward_declarable_type_references. That walks up the AST from every
+   * type reference and matches every member access and pointer use, so
+   * it is not part of AllDetails and only tools looking for forward
+   * declarations, like `ForwardDeclarationFinder`, should ask for it.
+   */
+  enum Details : unsigned {
+    NoDetails = 0,
+    MacroReferenceDetails = 1 << 0,
+    RedeclarationDetails = 1 << 1,
+    DeclReferenceDetails = 1 << 2,
+    TypeReferenceDetails = 1 << 3,
+    AllDetails = MacroReferenceDetails | RedeclarationDetails |
+                 DeclReferenceDetails | TypeReferenceDetails,
+    ForwardDeclarationDetails = 1 << 4,
+  };
+
+  /**
+   * Which of macro_references, redeclarations, decl_references,
+   * type_references, forward_declarable_type_references and
+   * definition_uses are filled, the others stay empty.
+   */
+  unsigned details = AllDetails;
+
   /**
    * Translate file uid to name (as used in the include statement)
    */
@@ -37,6 +69,18 @@ struct IncludeGraphData {
    */
   clangmetatool::types::FileAttributeMap<const clang::FileEntry *> fuid2entry;
 
+  /**
+   * Translate name (as used in the include statement) to the file
+   * uids included with it, usually a single one.
+   */
+  std::unordered_multimap<std::string, clangmetatool::types::FileUID>
+      name2fuid;
+
+  /**
+   * Translate the real path of a file to its file uid.
+   */
+  std::unordered_map<std::string, clangmetatool::types::FileUID> path2fuid;
+
   /**
    * Does the given file uid belong to a system header?
    */
@@ -60,6 +104,14 @@ struct IncludeGraphData {
    */
   clangmetatool::types::FileGraph include_graph;
 
+  /**
+   * file uid B is included by each of the file uids, the reverse of
+   * include_graph
+   */
+  std::unordered_map<clangmetatool::types::FileUID,
+                     std::vector<clangmetatool::types::FileUID>>
+      included_by;
+
   /**
    * Where are the include statements
    */
@@ -96,6 +148,28 @@ struct IncludeGraphData {
   clangmetatool::types::FileGraphEdgeMultimap<const clang::TypeLoc *>
       type_references;
 
+  /**
+   * The type references of file uid A to a class declared in B that a
+   * forward declaration of the class would do for: behind a pointer or
+   * a reference, or as a parameter or return type of a function that
+   * is only declared. A subset of type_references, filled along with
+   * it when ForwardDeclarationDetails is also set.
+   */
+  clangmetatool::types::FileGraphEdgeMultimap<const clang::TypeLoc *>
+      forward_declarable_type_references;
+
+  /**
+   * file uid A uses file uid B in a way a forward declaration can't do
+   * for: any reference other than a forward declarable type reference
+   * or a redeclaration of a class without its definition, an access
+   * to a member of a class declared in B, or a use through a pointer
+   * that needs the class to be complete, like deleting it, converting
+   * it to a base class, pointer arithmetic or copying `*p`. The edges
+   * of use_graph that are not in it could be replaced by forward
+   * declarations. Only filled with ForwardDeclarationDetails.
+   */
+  clangmetatool::types::FileGraph definition_uses;
+
   /**
    * Track the number of references made by a file uid A,
    * to a name in another file uid B
@@ -0,0 +1,112 @@
+#ifndef INCLUDED_CLANGMETATOOL_FORWARD_DECLARATION_FINDER_H
+#define INCLUDED_CLANGMETATOOL_FORWARD_DECLARATION_FINDER_H
+
+#include <cstddef>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <llvm/Support/raw_ostream.h>
+
+#include <clangmetatool/collectors/include_graph_data.h>
+#include <clangmetatool/header_cost_report.h>
+#include <clangmetatool/types/file_graph_edge.h>
+#include <clangmetatool/types/file_uid.h>
+
+namespace clangmetatool {
+
+/**
+ * Finds the includes that could be replaced by forward declarations of
+ * the classes they bring, according to an include graph, usually the
+ * merged graph of a `ProjectIncludeGraph`.
+ *
+ * An include of file D by file F is a candidate when F uses something
+ * that it only reaches through D, and all those uses are forward
+ * declarable, that is, none of them is in the `definition_uses` of the
+ * data: F only names classes of those files behind pointers and
+ * references, or in function declarations. Includes from or of system
+ * headers, and includes within a cycle, are left alone.
+ *
+ * Each candidate carries what the build would stop preprocessing
+ * without the include, as computed by `HeaderCostReport`, so that the
+ * includes that shrink the most translation units come first.
+ */
+class ForwardDeclarationFinder {
+public:
+  struct Candidate {
+    types::FileGraphEdge edge;
+    std::string includer;
+    std::string included;
+
+    /**
+     * Files the includer uses and only reaches through the include,
+     * whose classes it would declare instead, sorted.
+     */
+    std::vector<types::FileUID> declared;
+
+    /**
+     * Files that include the includer, directly or not, and use a file
+     * they may only reach through the include, sorted. They would have
+     * to include what they use themselves.
+     */
+    std::vector<types::FileUID> dependents;
+
+    /**
+     * What removing the include saves, summed over the translation
+     * units, and the number of translation units it saves anything in.
+     */
+    HeaderCostReport::Size saved;
+    size_t translationUnits = 0;
+  };
+
+private:
+  std::map<types::FileUID, std::string> paths;
+  std::vector<Candidate> candidates;
+
+public:
+  /**
+   * Find the candidates of the graph, measuring every file of the graph
+   * for their savings, as `HeaderCostReport` does. The graph must have
+   * been collected with `IncludeGraphData::ForwardDeclarationDetails`,
+   * there are no candidates otherwise.
+   */
+  explicit ForwardDeclarationFinder(const collectors::IncludeGraphData *data);
+
+  /**
+   * Find the candidates of the graph, with the savings of a report on
+   * the same graph.
+   */
+  ForwardDeclarationFinder(const collectors::IncludeGraphData *data,
+                           const HeaderCostReport &costs);
+
+  /**
+   * Every candidate, from the one that saves the most bytes to the one
+   * that saves the least.
+   */
+  const std::vector<Candidate> &getCandidates() const { return candidates; }
+
+  /**
+   * Print the candidates that save the most, at most limit of them.
+   */
+  void printReport(llvm::raw_ostream &os, size_t limit = 20) const;
+};
+
+} // namespace clangmetatool
+
+#endif
+
+// ----------------------------------------------------------------------------
+// Copyright 2026 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,151 @@
+#ifndef INCLUDED_CLANGMETATOOL_HEADER_COST_REPORT_H
+#define INCLUDED_CLANGMETATOOL_HEADER_COST_REPORT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <llvm/Support/raw_ostream.h>
+
+#include <clangmetatool/collectors/include_graph_data.h>
+#include <clangmetatool/types/file_graph_edge.h>
+#include <clangmetatool/types/file_uid.h>
+
+namespace clangmetatool {
+
+/**
+ * Where the preprocessed bytes and tokens of a build come from,
+ * according to an include graph, usually the merged graph of a
+ * `ProjectIncludeGraph`.
+ *
+ * Every file nobody includes is taken as the main file of a translation
+ * unit, which preprocesses the file and everything it includes
+ * transitively, once each. A header costs the build the size of its
+ * transitive closure times the number of translation units that include
+ * it. An include costs the build what the translation units would stop
+ * preprocessing if it was removed: the files they only reach through
+ * it.
+ */
+class HeaderCostReport {
+public:
+  /**
+   * Size of some source code.
+   */
+  struct Size {
+    uint64_t bytes = 0;
+    uint64_t tokens = 0;
+  };
+
+  struct HeaderCost {
+    types::FileUID uid = 0;
+    std::string path;
+
+    /**
+     * The header itself.
+     */
+    Size own;
+
+    /**
+     * The header and everything it includes transitively.
+     */
+    Size closure;
+
+    /**
+     * Number of translation units that include the header, directly or
+     * not.
+     */
+    size_t translationUnits = 0;
+
+    /**
+     * The closure, times the number of translation units.
+     */
+    Size build;
+  };
+
+  struct IncludeCost {
+    types::FileGraphEdge edge;
+
+    /**
+     * What removing the include would save, summed over the translation
+     * units.
+     */
+    Size removed;
+
+    /**
+     * Number of translation units removing the include saves anything
+     * in.
+     */
+    size_t translationUnits = 0;
+  };
+
+private:
+  std::map<types::FileUID, std::string> paths;
+  size_t numTranslationUnits = 0;
+  std::vector<HeaderCost> headers;
+  std::vector<IncludeCost> includes;
+
+public:
+  /**
+   * Measure every file of the graph and compute its costs. Files are
+   * found by their real path, or by their name when it is not known.
+   */
+  explicit HeaderCostReport(const collectors::IncludeGraphData *data);
+
+  /**
+   * Compute the costs of the graph with sizes measured beforehand.
+   * Files without a size count as empty.
+   */
+  HeaderCostReport(const collectors::IncludeGraphData *data,
+                   const std::map<types::FileUID, Size> &sizes);
+
+  /**
+   * Size of a file in bytes, and in tokens as lexed without
+   * preprocessing. Zero if the file can't be read.
+   */
+  static Size measure(const std::string &path);
+
+  /**
+   * Number of files taken as main files of translation units.
+   */
+  size_t getNumTranslationUnits() const { return numTranslationUnits; }
+
+  /**
+   * Every included file, from the largest to the smallest build cost in
+   * bytes.
+   */
+  const std::vector<HeaderCost> &getHeaders() const { return headers; }
+
+  /**
+   * Every include, from the one whose removal saves the most bytes to
+   * the one that saves the least.
+   */
+  const std::vector<IncludeCost> &getIncludes() const { return includes; }
+
+  /**
+   * Print the most expensive headers and includes, at most limit of
+   * each.
+   */
+  void printReport(llvm::raw_ostream &os, size_t limit = 20) const;
+};
+
+} // namespace clangmetatool
+
+#endif
+
+// ----------------------------------------------------------------------------
+// Copyright 2026 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,133 @@
+#ifndef INCLUDED_CLANGMETATOOL_INCLUDE_GRAPH_CSR_H
+#define INCLUDED_CLANGMETATOOL_INCLUDE_GRAPH_CSR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <llvm/ADT/ArrayRef.h>
+
+#include <clangmetatool/collectors/include_graph_data.h>
+#include <clangmetatool/types/file_uid.h>
+
+namespace clangmetatool {
+
+/**
+ * A frozen view of the graphs of a `clangmetatool::IncludeGraphData`, in
+ * compressed sparse row form.
+ *
+ * Every file uid that appears in the data is given a dense index, in the
+ * order of the file uids, and the successors of each node are stored
+ * contiguously, in the same order as in the original graph. The view is
+ * a copy: it doesn't see changes made to the data after it was built,
+ * such as the ones of `IncludeGraphDependencies::decrementUsageRefCount`.
+ *
+ * It can also view arrays it doesn't own, such as the ones of a mapped
+ * `clangmetatool::IncludeGraphSnapshot`.
+ */
+class IncludeGraphCSR {
+public:
+  /**
+   * Dense index of a file.
+   */
+  typedef uint32_t Index;
+
+  /**
+   * The edges of one graph over the dense indices.
+   */
+  struct Graph {
+    /**
+     * The successors of node i are targets[offsets[i]] up to
+     * targets[offsets[i + 1]].
+     */
+    llvm::ArrayRef<Index> offsets;
+    llvm::ArrayRef<Index> targets;
+
+    llvm::ArrayRef<Index> successors(Index node) const {
+      return llvm::ArrayRef<Index>(targets.data() + offsets[node],
+                                   targets.data() + offsets[node + 1]);
+    }
+
+    size_t numEdges() const { return targets.size(); }
+  };
+
+private:
+  /**
+   * The arrays of the view when it was built from data.
+   */
+  std::vector<types::FileUID> ownedUIDs;
+  std::vector<std::vector<Index>> ownedArrays;
+
+  llvm::ArrayRef<types::FileUID> uids;
+  Graph includeGraph;
+  Graph useGraph;
+  Graph usageGraph;
+
+public:
+  /**
+   * Build the view of the given data.
+   */
+  explicit IncludeGraphCSR(const collectors::IncludeGraphData *data);
+
+  /**
+   * View arrays owned by the caller, which must outlive the view. The
+   * uids must be sorted, and the graphs have one row per uid.
+   */
+  IncludeGraphCSR(llvm::ArrayRef<types::FileUID> uids, Graph includeGraph,
+                  Graph useGraph, Graph usageGraph);
+
+  IncludeGraphCSR(const IncludeGraphCSR &) = delete;
+  IncludeGraphCSR &operator=(const IncludeGraphCSR &) = delete;
+
+  /**
+   * Number of files, the dense indices go from 0 to this number.
+   */
+  size_t numNodes() const { return uids.size(); }
+
+  /**
+   * File uid of a dense index.
+   */
+  types::FileUID getUID(Index index) const { return uids[index]; }
+
+  /**
+   * Set index to the dense index of the given file uid, and return
+   * whether the file is part of the view at all.
+   */
+  bool findIndex(types::FileUID uid, Index &index) const;
+
+  /**
+   * The `include_graph` of the data: A includes B.
+   */
+  const Graph &getIncludeGraph() const { return includeGraph; }
+
+  /**
+   * The `use_graph` of the data: A uses B.
+   */
+  const Graph &getUseGraph() const { return useGraph; }
+
+  /**
+   * The edges of the `usage_reference_count` of the data whose count is
+   * above zero: A references a name from B.
+   */
+  const Graph &getUsageGraph() const { return usageGraph; }
+};
+
+} // namespace clangmetatool
+
+#endif
+
+// ----------------------------------------------------------------------------
+// Copyright 2026 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
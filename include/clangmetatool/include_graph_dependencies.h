@@ -2,6 +2,9 @@
 #define INCLUDED_CLANGMETATOOL_INCLUDE_GRAPH_DEPENDENCIES_H
 
 #include <clangmetatool/collectors/include_graph_data.h>
+#include <clangmetatool/include_graph_csr.h>
+#include <clangmetatool/include_graph_reachability.h>
+#include <clangmetatool/parallel_include_graph_traversal.h>
 
 namespace clangmetatool {
 
@@ -82,6 +85,96 @@ struct IncludeGraphDependencies {
   liveWeakDependencies(const clangmetatool::collectors::IncludeGraphData *data,
                        const clangmetatool::types::FileUID &fileUID);
 
+  /**
+   * Same as \c "collectAllIncludes", traversing a frozen view of the
+   * data, which is faster on large graphs.
+   */
+  static std::set<clangmetatool::types::FileUID>
+  collectAllIncludes(const clangmetatool::IncludeGraphCSR *graph,
+                     const clangmetatool::types::FileUID &fileUID);
+
+  /**
+   * Same as \c "collectAllIncludes", reading the includes from a
+   * reachability index instead of traversing the graph, which is best
+   * when querying many files of the same graph.
+   */
+  static std::set<clangmetatool::types::FileUID>
+  collectAllIncludes(const clangmetatool::IncludeGraphReachability *index,
+                     const clangmetatool::types::FileUID &fileUID);
+
+  /**
+   * Same as \c "liveDependencies", traversing a frozen view of the data,
+   * which is faster on large graphs.
+   */
+  static std::set<clangmetatool::types::FileUID>
+  liveDependencies(const clangmetatool::IncludeGraphCSR *graph,
+                   const clangmetatool::types::FileUID &fileUID);
+
+  /**
+   * Same as \c "liveDependencies", using a reachability index instead of
+   * traversing the graph.
+   *
+   * The traversal finds, for every header the file references a name
+   * from, the first direct include (by file uid) it can be reached
+   * through, and those are the live dependencies. The index answers
+   * each of these questions with a lookup.
+   */
+  static std::set<clangmetatool::types::FileUID>
+  liveDependencies(const clangmetatool::IncludeGraphReachability *index,
+                   const clangmetatool::types::FileUID &fileUID);
+
+  /**
+   * The live dependencies of every file of the graph, by file uid, the
+   * same as calling \c "liveDependencies" for each of them, but sharing
+   * the traversal work in the reachability index.
+   */
+  typedef std::map<clangmetatool::types::FileUID,
+                   std::set<clangmetatool::types::FileUID>>
+      LiveDependenciesMap;
+  static LiveDependenciesMap
+  allLiveDependencies(const clangmetatool::IncludeGraphReachability *index);
+
+  /**
+   * Same as \c "liveWeakDependencies", traversing a frozen view of the
+   * data, which is faster on large graphs.
+   */
+  static DirectDependenciesMap
+  liveWeakDependencies(const clangmetatool::IncludeGraphCSR *graph,
+                       const clangmetatool::types::FileUID &fileUID);
+
+  /**
+   * Same as \c "collectAllIncludes", spreading the traversal of the view
+   * over the workers of an executor, which is faster on the very large
+   * graphs of whole projects.
+   */
+  static std::set<clangmetatool::types::FileUID> collectAllIncludes(
+      const clangmetatool::ParallelIncludeGraphTraversal *traversal,
+      const clangmetatool::types::FileUID &fileUID);
+
+  /**
+   * Same as \c "liveDependencies", with a parallel traversal. A direct
+   * include is live when it is the first one, by file uid, that reaches
+   * a file the header references a name of.
+   */
+  static std::set<clangmetatool::types::FileUID> liveDependencies(
+      const clangmetatool::ParallelIncludeGraphTraversal *traversal,
+      const clangmetatool::types::FileUID &fileUID);
+
+  /**
+   * Same as \c "liveWeakDependencies", with a parallel traversal from
+   * each direct include in turn.
+   */
+  static DirectDependenciesMap liveWeakDependencies(
+      const clangmetatool::ParallelIncludeGraphTraversal *traversal,
+      const clangmetatool::types::FileUID &fileUID);
+
+  /**
+   * Path of every file of the data: its path from \c "path2fuid" when
+   * known, its name otherwise.
+   */
+  static std::map<clangmetatool::types::FileUID, std::string>
+  filePaths(const clangmetatool::collectors::IncludeGraphData *data);
+
 }; // struct IncludeGraphDependencies
 } // namespace clangmetatool
 
@@ -0,0 +1,132 @@
+#ifndef INCLUDED_CLANGMETATOOL_INCLUDE_GRAPH_REACHABILITY_H
+#define INCLUDED_CLANGMETATOOL_INCLUDE_GRAPH_REACHABILITY_H
+
+#include <cstddef>
+#include <set>
+#include <vector>
+
+#include <llvm/ADT/ArrayRef.h>
+#include <llvm/ADT/SparseBitVector.h>
+
+#include <clangmetatool/include_graph_csr.h>
+#include <clangmetatool/types/file_uid.h>
+
+namespace clangmetatool {
+
+/**
+ * The transitive closure of the include graph of an `IncludeGraphCSR`,
+ * to answer many reachability queries without traversing the graph.
+ *
+ * Files that include each other, directly or not, form a strongly
+ * connected component and reach the same files, so the graph is first
+ * condensed into its components, which form a DAG. The files reachable
+ * from each component are then stored as a sparse bitset of components,
+ * built from the bitsets of its successors.
+ *
+ * The view must outlive the index.
+ */
+class IncludeGraphReachability {
+private:
+  const IncludeGraphCSR *graph;
+
+  /**
+   * Component of each node of the view. Components are numbered so
+   * that a component only reaches components with a lower number.
+   */
+  std::vector<IncludeGraphCSR::Index> componentOf;
+
+  /**
+   * The nodes of component i are members[memberOffsets[i]] up to
+   * members[memberOffsets[i + 1]].
+   */
+  std::vector<IncludeGraphCSR::Index> memberOffsets;
+  std::vector<IncludeGraphCSR::Index> members;
+
+  /**
+   * Components reachable from each component, including itself.
+   */
+  std::vector<llvm::SparseBitVector<>> closures;
+
+public:
+  /**
+   * Build the index of the include graph of the given view.
+   */
+  explicit IncludeGraphReachability(const IncludeGraphCSR *graph);
+
+  /**
+   * Number of strongly connected components of the include graph.
+   */
+  size_t numComponents() const { return closures.size(); }
+
+  /**
+   * Component of a node of the view.
+   */
+  IncludeGraphCSR::Index getComponent(IncludeGraphCSR::Index node) const {
+    return componentOf[node];
+  }
+
+  /**
+   * The nodes of the view in a component.
+   */
+  llvm::ArrayRef<IncludeGraphCSR::Index>
+  getMembers(IncludeGraphCSR::Index component) const {
+    return llvm::ArrayRef<IncludeGraphCSR::Index>(
+        members.data() + memberOffsets[component],
+        members.data() + memberOffsets[component + 1]);
+  }
+
+  /**
+   * The components reachable from a component, including itself.
+   */
+  const llvm::SparseBitVector<> &
+  getClosure(IncludeGraphCSR::Index component) const {
+    return closures[component];
+  }
+
+  /**
+   * The view the index was built from.
+   */
+  const IncludeGraphCSR *getGraph() const { return graph; }
+
+  /**
+   * Whether node 'to' of the view is node 'from' or one of its direct or
+   * transitive includes.
+   */
+  bool isNodeReachable(IncludeGraphCSR::Index from,
+                       IncludeGraphCSR::Index to) const {
+    return closures[componentOf[from]].test(componentOf[to]);
+  }
+
+  /**
+   * Whether 'to' is 'from' or one of its direct or transitive includes,
+   * that is, whether it would be in the result of
+   * `IncludeGraphDependencies::collectAllIncludes` for 'from'.
+   */
+  bool isReachable(types::FileUID from, types::FileUID to) const;
+
+  /**
+   * The file and all its direct and transitive includes, the same as
+   * `IncludeGraphDependencies::collectAllIncludes`.
+   */
+  std::set<types::FileUID> getReachable(types::FileUID file) const;
+};
+
+} // namespace clangmetatool
+
+#endif
+
+// ----------------------------------------------------------------------------
+// Copyright 2026 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
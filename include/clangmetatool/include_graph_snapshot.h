@@ -0,0 +1,165 @@
+#ifndef INCLUDED_CLANGMETATOOL_INCLUDE_GRAPH_SNAPSHOT_H
+#define INCLUDED_CLANGMETATOOL_INCLUDE_GRAPH_SNAPSHOT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include <clang/Basic/SourceManager.h>
+#include <llvm/ADT/ArrayRef.h>
+#include <llvm/ADT/StringRef.h>
+#include <llvm/Support/MemoryBuffer.h>
+#include <llvm/Support/raw_ostream.h>
+
+#include <clangmetatool/collectors/include_graph_data.h>
+#include <clangmetatool/include_graph_csr.h>
+
+namespace clangmetatool {
+
+/**
+ * A compact binary copy of the include graph of a
+ * `clangmetatool::IncludeGraphData`, which outlives the AST it was
+ * collected from.
+ *
+ * It keeps, for every file, its uid, the name it was included with and
+ * its real path, the include, use and usage graphs, the reference count
+ * of every usage by kind, and the offsets of the include statements.
+ * The file is a sequence of 32 bit arrays in the byte order of the
+ * machine that wrote it, laid out so that a loaded snapshot reads them
+ * in place: files are memory-mapped when large enough, and
+ * `getGraph()` is an `IncludeGraphCSR` over the mapped arrays, so every
+ * query of `IncludeGraphDependencies` taking one runs on a snapshot
+ * without copying or rebuilding anything.
+ */
+class IncludeGraphSnapshot {
+public:
+  typedef IncludeGraphCSR::Index Index;
+
+  /**
+   * How many times a file references names of another file, by kind.
+   * The kinds may add up to less than the total, which is the
+   * `usage_reference_count` of the edge.
+   */
+  struct UsageCounts {
+    uint32_t total;
+    uint32_t macros;
+    uint32_t declarations;
+    uint32_t types;
+    uint32_t redeclarations;
+  };
+
+  /**
+   * Offsets in the including file of the start of the include statement
+   * and of the end of the included name.
+   */
+  struct IncludeStatement {
+    uint32_t begin;
+    uint32_t end;
+  };
+
+  /**
+   * Write a snapshot of the data. The source manager of the translation
+   * unit is needed to translate the locations of the include statements
+   * into offsets, it can only be null if the data has no include
+   * statements, like the one of a `ProjectIncludeGraph`.
+   */
+  static void write(const collectors::IncludeGraphData *data,
+                    const clang::SourceManager *sm, llvm::raw_ostream &os);
+
+  /**
+   * Map a snapshot written to a file. Return null if the file can't be
+   * read or is not a valid snapshot written on a machine with the same
+   * byte order.
+   */
+  static std::unique_ptr<IncludeGraphSnapshot> load(const std::string &path);
+
+  /**
+   * Read a snapshot from a buffer, which it keeps. Return null if the
+   * buffer is not a valid snapshot.
+   */
+  static std::unique_ptr<IncludeGraphSnapshot>
+  load(std::unique_ptr<llvm::MemoryBuffer> buffer);
+
+private:
+  struct Header;
+
+  /**
+   * Offsets of the name and path in the string table, and flags.
+   */
+  struct FileRecord {
+    uint32_t name;
+    uint32_t path;
+    uint32_t flags;
+  };
+
+  std::unique_ptr<llvm::MemoryBuffer> buffer;
+  llvm::ArrayRef<FileRecord> files;
+  llvm::ArrayRef<UsageCounts> usageCounts;
+  llvm::ArrayRef<uint32_t> statementOffsets;
+  llvm::ArrayRef<IncludeStatement> statements;
+  llvm::StringRef strings;
+  std::unique_ptr<IncludeGraphCSR> graph;
+
+  IncludeGraphSnapshot() = default;
+
+public:
+  /**
+   * The graphs, indexed in the order of the file uids, as in an
+   * `IncludeGraphCSR` built from the original data.
+   */
+  const IncludeGraphCSR &getGraph() const { return *graph; }
+
+  /**
+   * Number of files, the dense indices go from 0 to this number.
+   */
+  size_t numNodes() const { return graph->numNodes(); }
+
+  /**
+   * The name the file was included with, empty for the main file.
+   */
+  llvm::StringRef getName(Index node) const;
+
+  /**
+   * The real path of the file, empty if it was not known.
+   */
+  llvm::StringRef getPath(Index node) const;
+
+  /**
+   * Whether the file is a system header.
+   */
+  bool isSystem(Index node) const;
+
+  /**
+   * The counts of the usages of a file, in the same order as its
+   * successors in `getGraph().getUsageGraph()`.
+   */
+  llvm::ArrayRef<UsageCounts> getUsageCounts(Index node) const;
+
+  /**
+   * The include statements of `from` that include `to`, empty if there
+   * are none.
+   */
+  llvm::ArrayRef<IncludeStatement> getIncludeStatements(Index from,
+                                                        Index to) const;
+};
+
+} // namespace clangmetatool
+
+#endif
+
+// ----------------------------------------------------------------------------
+// Copyright 2026 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,110 @@
+#ifndef INCLUDED_CLANGMETATOOL_INCLUDE_PRUNER_H
+#define INCLUDED_CLANGMETATOOL_INCLUDE_PRUNER_H
+
+#include <cstddef>
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+
+#include <clang/Basic/SourceManager.h>
+#include <clang/Tooling/Core/Replacement.h>
+
+#include <clangmetatool/collectors/include_graph_data.h>
+#include <clangmetatool/types/file_graph_edge.h>
+
+namespace clangmetatool {
+
+/**
+ * Finds the include statements that no translation unit needs, and
+ * deletes them.
+ *
+ * Every translation unit is looked at on its own by `removableIncludes`.
+ * A header is parsed again by each translation unit that includes it,
+ * and an include statement in a header can only be deleted if it was
+ * removable in every one of them, so the verdicts on each statement are
+ * merged across translation units, identified by the real path of the
+ * file and the offset of the statement. Translation units can be added
+ * concurrently, but all the translation units that include a header
+ * must be added before the result can be trusted for that header.
+ */
+class IncludePruner {
+private:
+  /**
+   * An include statement, from the start of its line to the start of
+   * the next one.
+   */
+  struct Statement {
+    unsigned length;
+    bool needed;
+  };
+
+  mutable std::mutex mutex;
+  size_t numTranslationUnits = 0;
+
+  /**
+   * Statements by real path of the file they are in and offset.
+   */
+  std::map<std::string, std::map<unsigned, Statement>> statements;
+
+public:
+  /**
+   * The include edges of the translation unit that can be removed
+   * without breaking it. An include of file A by file B is needed when:
+   *
+   * - A is a live dependency of B, see
+   *   `IncludeGraphDependencies::liveDependencies`, except that a file
+   *   that B uses and includes itself is its own live dependency;
+   * - or a file that includes B, directly or not, uses A or one of its
+   *   transitive includes, since removing the include would break it;
+   * - or any other file of the translation unit, one that A doesn't
+   *   include directly or not, uses A or one of its transitive includes
+   *   without including it, relying on B's include coming first.
+   *
+   * Includes by system headers are never removable.
+   */
+  static std::set<types::FileGraphEdge>
+  removableIncludes(const collectors::IncludeGraphData *data);
+
+  /**
+   * Add the verdicts of a translation unit on its include statements,
+   * usually from the postProcessing of a tool with an `IncludeGraph`
+   * collector, given the source manager of the translation unit.
+   *
+   * Statements marked with "IWYU pragma: keep", and statements whose
+   * line can't be deleted on its own, are always needed.
+   */
+  void add(const collectors::IncludeGraphData *data,
+           const clang::SourceManager &sm);
+
+  /**
+   * Number of translation units added so far.
+   */
+  size_t getNumTranslationUnits() const;
+
+  /**
+   * Replacements deleting the lines of the include statements that were
+   * removable in every translation unit they were seen in, by file.
+   */
+  std::map<std::string, clang::tooling::Replacements> getReplacements() const;
+};
+
+} // namespace clangmetatool
+
+#endif
+
+// ----------------------------------------------------------------------------
+// Copyright 2026 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -5,6 +5,7 @@
 
 #include <functional>
 #include <list>
+#include <string>
 
 namespace clangmetatool {
 
@@ -21,22 +22,32 @@ private:
   class MatchCallback : public clang::ast_matchers::MatchFinder::MatchCallback {
   private:
     FunctionType d_function;
+    std::string d_id;
 
   public:
-    MatchCallback(const FunctionType &function) : d_function(function) {}
+    MatchCallback(const FunctionType &function, const std::string &id)
+        : d_function(function), d_id(id) {}
+
+    virtual llvm::StringRef getID() const override { return d_id; }
 
     virtual void run(const ResultType &result) override { d_function(result); }
   };
 
   clang::ast_matchers::MatchFinder *d_matchFinder_p;
+  std::string d_id;
   std::list<MatchCallback> d_callbacks;
 
 public:
   /**
-   * Create a forwarder that wraps the given match finder.
+   * Create a forwarder that wraps the given match finder. Its callbacks
+   * are identified by the given ID, as returned by getID, so that a
+   * MatcherProfile charges their time to the right collector: pass the
+   * name of the collector owning the forwarder, or
+   * "<Collector>::<Callback>".
    */
-  MatchForwarder(clang::ast_matchers::MatchFinder *matchFinder)
-      : d_matchFinder_p(matchFinder) {}
+  MatchForwarder(clang::ast_matchers::MatchFinder *matchFinder,
+                 const std::string &id = "MatchForwarder::MatchCallback")
+      : d_matchFinder_p(matchFinder), d_id(id) {}
 
   /**
    * Add the given matcher to the match finder. When a match is found, the
@@ -44,7 +55,7 @@ public:
    */
   template <typename MatchType>
   void addMatcher(const MatchType &match, const FunctionType &function) {
-    d_callbacks.emplace_back(function);
+    d_callbacks.emplace_back(function, d_id);
     d_matchFinder_p->addMatcher(match, &d_callbacks.back());
   }
 };
@@ -0,0 +1,92 @@
+#ifndef INCLUDED_CLANGMETATOOL_MATCHER_PROFILE_H
+#define INCLUDED_CLANGMETATOOL_MATCHER_PROFILE_H
+
+#include <cstddef>
+#include <map>
+#include <mutex>
+#include <string>
+
+#include <llvm/ADT/StringMap.h>
+#include <llvm/Support/Timer.h>
+#include <llvm/Support/raw_ostream.h>
+
+namespace clangmetatool {
+
+/**
+ * Receives the profiling records of the MatchFinder of every
+ * translation unit processed by the MetaTools it is given to. MetaTool
+ * only goes through this interface, so that tools not profiling
+ * anything don't need this library.
+ */
+class MatcherProfileSink {
+public:
+  virtual ~MatcherProfileSink() = default;
+
+  /**
+   * Add the profiling records of the MatchFinder of one translation
+   * unit, as filled by MatchFinderOptions::Profiling.
+   */
+  virtual void add(const llvm::StringMap<llvm::TimeRecord> &records) = 0;
+};
+
+/**
+ * Time spent by the MatchFinder in each match callback, matching its
+ * matchers and running it, summed over every translation unit it is
+ * given.
+ *
+ * Callbacks are identified by their getID(), which the collectors of
+ * this library return as "<Collector>::<Callback>", so the time can also
+ * be attributed to each collector. Callbacks that don't override getID()
+ * are all counted under "<unknown>".
+ */
+class MatcherProfile : public MatcherProfileSink {
+private:
+  mutable std::mutex mutex;
+  std::map<std::string, llvm::TimeRecord> callbacks;
+  size_t numTranslationUnits = 0;
+
+public:
+  void add(const llvm::StringMap<llvm::TimeRecord> &records) override;
+
+  /**
+   * Number of translation units added so far.
+   */
+  size_t getNumTranslationUnits() const;
+
+  /**
+   * Time spent in each callback, by callback id.
+   */
+  std::map<std::string, llvm::TimeRecord> getCallbacks() const;
+
+  /**
+   * Time spent in the callbacks of each collector, by collector name:
+   * the callback id up to the first "::".
+   */
+  std::map<std::string, llvm::TimeRecord> getCollectors() const;
+
+  /**
+   * Print the collectors from the most to the least expensive, each
+   * followed by its own callbacks ranked the same way.
+   */
+  void printReport(llvm::raw_ostream &os) const;
+};
+
+} // namespace clangmetatool
+
+#endif
+
+// ----------------------------------------------------------------------------
+// Copyright 2026 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
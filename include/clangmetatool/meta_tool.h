@@ -2,17 +2,28 @@
 #define INCLUDED_CLANGMETATOOL_META_TOOL_H
 
 #include <assert.h>
+#include <chrono>
+#include <functional>
 #include <map>
 #include <memory>
 #include <stddef.h>
 #include <string>
+#include <vector>
 
 #include <clang/AST/ASTConsumer.h>
 #include <clang/ASTMatchers/ASTMatchFinder.h>
 #include <clang/Frontend/CompilerInstance.h>
 #include <clang/Frontend/FrontendAction.h>
+#include <clang/Frontend/MultiplexConsumer.h>
+#include <clang/Lex/PPCallbacks.h>
+#include <clang/Lex/Preprocessor.h>
 #include <clang/Tooling/Core/Replacement.h>
+#include <llvm/ADT/StringMap.h>
 #include <llvm/ADT/StringRef.h>
+#include <llvm/Support/Timer.h>
+
+#include <clangmetatool/matcher_profile.h>
+#include <clangmetatool/phase_timings.h>
 
 namespace clangmetatool {
 namespace {
@@ -27,6 +38,19 @@ struct has_typedef_ArgTypes : std::false_type {};
 template <typename T>
 struct has_typedef_ArgTypes<T, void_t<typename T::ArgTypes>> : std::true_type {
 };
+
+// Consumer that only reports when the translation unit is complete, put
+// in front of the MatchFinder consumer to tell parsing and matching apart
+class TranslationUnitDoneConsumer : public clang::ASTConsumer {
+private:
+  std::function<void()> onDone;
+
+public:
+  explicit TranslationUnitDoneConsumer(std::function<void()> onDone)
+      : onDone(onDone) {}
+
+  void HandleTranslationUnit(clang::ASTContext &) override { onDone(); }
+};
 } // namespace
 /**
  * MetaTool is a template that reduces the amount of boilerplate
@@ -59,18 +83,40 @@ public:
 
 private:
   std::map<std::string, clang::tooling::Replacements> &replacementsMap;
-  clang::ast_matchers::MatchFinder f;
+  std::unique_ptr<clang::ast_matchers::MatchFinder> f;
   WrappedTool *tool;
 
   ArgTypes &args;
 
+  typedef std::chrono::steady_clock Clock;
+
+  PhaseTimingsSink *timingsLog = nullptr;
+  PhaseTimings timings;
+  Clock::time_point startTime;
+  Clock::time_point matchStartTime;
+
+  static double secondsBetween(Clock::time_point from, Clock::time_point to) {
+    return std::chrono::duration<double>(to - from).count();
+  }
+
+  MatcherProfileSink *matcherProfile = nullptr;
+  llvm::StringMap<llvm::TimeRecord> profileRecords;
+
+  std::function<void(bool)> onPPCallbacksKnown;
+
+  void addProfile() {
+    if (matcherProfile) {
+      matcherProfile->add(profileRecords);
+    }
+  }
+
   template <class A>
   WrappedTool *create_tool(clang::CompilerInstance &ci, A args) {
-    return new WrappedTool(&ci, &f, args);
+    return new WrappedTool(&ci, f.get(), args);
   }
   WrappedTool *create_tool(clang::CompilerInstance &ci,
                            typename NoArgs::ArgTypes &args) {
-    return new WrappedTool(&ci, &f);
+    return new WrappedTool(&ci, f.get());
   }
 
 public:
@@ -86,25 +132,99 @@ public:
       delete tool;
   }
 
+  /**
+   * Record how long each phase of processing the translation unit
+   * takes into the given log. Pass null, the default, to not measure
+   * anything.
+   */
+  void setTimingsLog(PhaseTimingsSink *log) { timingsLog = log; }
+
+  /**
+   * Profile the matchers of the translation unit and add the result to
+   * the given profile. Pass null, the default, to not profile anything.
+   */
+  void setMatcherProfile(MatcherProfileSink *profile) {
+    matcherProfile = profile;
+  }
+
+  /**
+   * Call the given function, once the tool is created, with whether it
+   * registered preprocessor callbacks. Pass an empty function, the
+   * default, to not check.
+   */
+  void setPPCallbacksObserver(std::function<void(bool)> observer) {
+    onPPCallbacksKnown = observer;
+  }
+
   virtual bool BeginSourceFileAction(clang::CompilerInstance &ci) override {
+    if (timingsLog) {
+      startTime = Clock::now();
+      timings = PhaseTimings();
+      timings.mainFile = getCurrentFile().str();
+    }
+
     // we don't expect to ever have the metatool be invoked more
     // than once, it would eventually result in us holding
     // references to unused compiler instance objects, and
     // eventually segfaulting, so assert here.
     assert(tool == NULL);
+    clang::ast_matchers::MatchFinder::MatchFinderOptions options;
+    if (matcherProfile) {
+      options.CheckProfiling.emplace(profileRecords);
+    }
+    f = std::make_unique<clang::ast_matchers::MatchFinder>(options);
+    clang::PPCallbacks *callbacks = ci.getPreprocessor().getPPCallbacks();
     tool = create_tool(ci, args);
+    if (onPPCallbacksKnown) {
+      onPPCallbacksKnown(ci.getPreprocessor().getPPCallbacks() != callbacks);
+    }
     return true;
   }
 
   virtual void ExecuteAction() override {
+    if (!timingsLog) {
+      ASTFrontendAction::ExecuteAction();
+      addProfile();
+      tool->postProcessing(replacementsMap);
+      return;
+    }
+
+    Clock::time_point frontendStart = Clock::now();
+    timings.setupSeconds = secondsBetween(startTime, frontendStart);
+    matchStartTime = Clock::time_point();
     ASTFrontendAction::ExecuteAction();
+
+    Clock::time_point postProcessingStart = Clock::now();
+    if (matchStartTime == Clock::time_point()) {
+      // parsing stopped before the translation unit was complete
+      matchStartTime = postProcessingStart;
+    }
+    timings.frontendSeconds = secondsBetween(frontendStart, matchStartTime);
+    timings.matchSeconds = secondsBetween(matchStartTime, postProcessingStart);
+    addProfile();
+
     tool->postProcessing(replacementsMap);
+
+    Clock::time_point end = Clock::now();
+    timings.postProcessingSeconds = secondsBetween(postProcessingStart, end);
+    timings.totalSeconds = secondsBetween(startTime, end);
+    timings.processPeakMemoryKB =
+        PhaseTimings::measureProcessPeakMemoryKB();
+    timingsLog->record(timings);
   }
 
   virtual std::unique_ptr<clang::ASTConsumer>
   CreateASTConsumer(clang::CompilerInstance &CI,
                     llvm::StringRef file) override {
-    return f.newASTConsumer();
+    if (!timingsLog) {
+      return f->newASTConsumer();
+    }
+
+    std::vector<std::unique_ptr<clang::ASTConsumer>> consumers;
+    consumers.push_back(std::make_unique<TranslationUnitDoneConsumer>(
+        [this]() { matchStartTime = Clock::now(); }));
+    consumers.push_back(f->newASTConsumer());
+    return std::make_unique<clang::MultiplexConsumer>(std::move(consumers));
   }
 };
 } // namespace clangmetatool
@@ -1,15 +1,41 @@
 #ifndef INCLUDED_CLANGMETATOOL_META_TOOL_FACTORY_H
 #define INCLUDED_CLANGMETATOOL_META_TOOL_FACTORY_H
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <functional>
 #include <map>
 #include <memory>
+#include <mutex>
+#include <numeric>
+#include <set>
 #include <string>
 #include <system_error>
+#include <vector>
 
 #include <clang/Frontend/FrontendAction.h>
+#include <clang/Frontend/PCHContainerOperations.h>
+#include <clang/Tooling/ArgumentsAdjusters.h>
+#include <clang/Tooling/CompilationDatabase.h>
 #include <clang/Tooling/Core/Replacement.h>
 #include <clang/Tooling/ReplacementsYaml.h>
 #include <clang/Tooling/Tooling.h>
+#include <llvm/ADT/IntrusiveRefCntPtr.h>
+#include <llvm/Support/Error.h>
+#include <llvm/Support/ErrorHandling.h>
+#include <llvm/Support/VirtualFileSystem.h>
+#include <llvm/Support/raw_ostream.h>
+
+#include <clangmetatool/matcher_profile.h>
+#include <clangmetatool/meta_tool.h>
+#include <clangmetatool/parallel_executor.h>
+#include <clangmetatool/phase_timings.h>
+#include <clangmetatool/preprocessor_meta_tool.h>
+#include <clangmetatool/result_cache.h>
+#include <clangmetatool/sharded_executor.h>
+#include <clangmetatool/shared_prefix_pch.h>
+#include <clangmetatool/translation_unit_history.h>
 
 namespace clangmetatool {
 /**
@@ -29,6 +55,178 @@ private:
    */
   std::map<std::string, clang::tooling::Replacements> &replacements;
 
+  /**
+   * Replacements merged into each file of the replacements map, kept
+   * between merges so that edits repeated by many translation units are
+   * found without copying the replacements of the file every time.
+   */
+  std::map<std::string, std::set<clang::tooling::Replacement>> merged;
+
+  /**
+   * Optional history of the cost of each translation unit, used to
+   * schedule parallel and sharded runs.
+   */
+  TranslationUnitHistory *history = nullptr;
+
+  /**
+   * Optional cache of the results of each translation unit, used by
+   * runTranslationUnit.
+   */
+  ResultCache *cache = nullptr;
+
+  /**
+   * Optional precompiled prefixes, used by runTranslationUnit.
+   */
+  const SharedPrefixPCH *sharedPrefix = nullptr;
+
+  /**
+   * Whether the tools of this factory register preprocessor callbacks,
+   * which would miss the directives of the precompiled prefixes. No
+   * prefix is used until a translation unit has shown that they don't.
+   */
+  enum PPCallbacksUse { UnknownPPCallbacks, NoPPCallbacks, SomePPCallbacks };
+  std::atomic<int> ppCallbacksUse{UnknownPPCallbacks};
+
+  /**
+   * Told by the tools of this factory whether they register
+   * preprocessor callbacks, empty to not ask them.
+   */
+  std::function<void(bool)> ppCallbacksObserver;
+
+  /**
+   * Optional log of the phase timings of every translation unit.
+   */
+  PhaseTimingsLog *timingsLog = nullptr;
+
+  /**
+   * Optional profile of the matchers of every translation unit.
+   */
+  MatcherProfile *matcherProfile = nullptr;
+
+  /**
+   * Only MetaTool and PreprocessorMetaTool know how to measure their
+   * phases, and only MetaTool runs matchers to profile.
+   */
+  template <class WrappedTool>
+  void instrument(MetaTool<WrappedTool> &action) const {
+    action.setTimingsLog(timingsLog);
+    action.setMatcherProfile(matcherProfile);
+    action.setPPCallbacksObserver(ppCallbacksObserver);
+  }
+  template <class WrappedTool>
+  void instrument(PreprocessorMetaTool<WrappedTool> &action) const {
+    if (matcherProfile) {
+      llvm::report_fatal_error(
+          "PreprocessorMetaTool runs no matchers, it can't be profiled",
+          false);
+    }
+    action.setTimingsLog(timingsLog);
+  }
+  void instrument(clang::FrontendAction &) const {}
+
+  /**
+   * Only MetaTool can tell whether its tool registers preprocessor
+   * callbacks, other actions never use precompiled prefixes.
+   */
+  template <class A> struct IsMetaTool : std::false_type {};
+  template <class WrappedTool>
+  struct IsMetaTool<MetaTool<WrappedTool>> : std::true_type {};
+
+  /**
+   * Order in which to process the given source files: the most
+   * expensive first if there is a history, as given otherwise.
+   */
+  std::vector<size_t> schedule(const std::vector<std::string> &sourcePaths) {
+    if (history) {
+      return history->schedule(sourcePaths);
+    }
+    std::vector<size_t> order(sourcePaths.size());
+    std::iota(order.begin(), order.end(), 0);
+    return order;
+  }
+
+  /**
+   * What processing a translation unit cost, if it was processed at all.
+   */
+  struct MeasuredCost {
+    TranslationUnitHistory::Record record;
+    bool measured = false;
+  };
+
+  /**
+   * Run a single translation unit with runTranslationUnit, measuring
+   * what it cost for the history. Translation units served from the
+   * cache are not measured, what they cost says nothing about a real
+   * run.
+   */
+  int runTimedTranslationUnit(
+      const clang::tooling::CompilationDatabase &compilations,
+      const std::string &sourcePath,
+      const clang::tooling::ArgumentsAdjuster &adjuster,
+      std::map<std::string, clang::tooling::Replacements> &tuReplacements,
+      MeasuredCost &cost) {
+    auto start = std::chrono::steady_clock::now();
+    bool cacheHit = false;
+    int r = runTranslationUnit(compilations, sourcePath, adjuster,
+                               tuReplacements, &cacheHit);
+    std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
+    cost.record.wallSeconds = elapsed.count();
+    cost.record.processPeakMemoryKB =
+        PhaseTimings::measureProcessPeakMemoryKB();
+    cost.measured = !cacheHit;
+    return r;
+  }
+
+  /**
+   * Record the measured costs of the given source paths in the history,
+   * if there is one.
+   */
+  void recordCosts(const std::vector<std::string> &sourcePaths,
+                   const std::vector<MeasuredCost> &costs) {
+    if (!history) {
+      return;
+    }
+    for (size_t i = 0; i < sourcePaths.size(); ++i) {
+      if (costs[i].measured) {
+        history->record(sourcePaths[i], costs[i].record);
+      }
+    }
+  }
+
+  /**
+   * Write the given replacements to the stream as a single YAML
+   * document.
+   */
+  static void
+  writeFixes(const std::string &mainSourceFile,
+             const std::map<std::string, clang::tooling::Replacements> &fixes,
+             llvm::raw_ostream &os) {
+    clang::tooling::TranslationUnitReplacements TUR;
+    TUR.MainSourceFile = mainSourceFile;
+    for (const auto &p : fixes) {
+      TUR.Replacements.insert(TUR.Replacements.end(), p.second.begin(),
+                              p.second.end());
+    }
+    llvm::yaml::Output yaml_out(os);
+    yaml_out << TUR;
+  }
+
+  /**
+   * Combine the results of running many translation units the way
+   * ClangTool::run does: 1 if any failed, 2 if any was skipped and 0
+   * otherwise.
+   */
+  static int combineResults(const std::vector<int> &results) {
+    if (std::find(results.begin(), results.end(), 1) != results.end()) {
+      return 1;
+    }
+    if (std::find(results.begin(), results.end(), 2) != results.end()) {
+      return 2;
+    }
+    return 0;
+  }
+
 public:
   /**
    * Metatool factory takes a reference to the replacements map that
@@ -50,10 +248,16 @@ public:
    */
 #if LLVM_VERSION_MAJOR >= 10
   virtual std::unique_ptr<clang::FrontendAction> create() {
-    return std::make_unique<T>(replacements, args);
+    auto action = std::make_unique<T>(replacements, args);
+    instrument(*action);
+    return action;
   }
 #else
-  virtual clang::FrontendAction *create() { return new T(replacements, args); }
+  virtual clang::FrontendAction *create() {
+    T *action = new T(replacements, args);
+    instrument(*action);
+    return action;
+  }
 #endif
 
   /**
@@ -65,16 +269,7 @@ public:
     if (r) {
       return r;
     }
-    clang::tooling::TranslationUnitReplacements TUR;
-    TUR.MainSourceFile = "";
-    for (auto p : replacements) {
-      for (const auto &r : p.second) {
-        clang::tooling::Replacement replacement = r;
-        TUR.Replacements.insert(TUR.Replacements.end(), replacement);
-      }
-    }
-    llvm::yaml::Output yaml_out(os);
-    yaml_out << TUR;
+    exportFixes(os);
     return r;
   }
 
@@ -87,6 +282,361 @@ public:
     }
     return runAndExportFixes(tool, ofs);
   }
+
+  /**
+   * Use the given history to run the most expensive translation units
+   * first in runParallel, runAndStreamFixes and runShardedAndExportFixes.
+   * The thread based runs also record the cost of every translation unit
+   * they process into it, leaving the ones served from the cache alone.
+   * Saving the history file is up to the caller.
+   * Pass null to stop using a history.
+   */
+  void setHistory(TranslationUnitHistory *h) { history = h; }
+
+  /**
+   * Use the given cache in runTranslationUnit, and therefore in every
+   * run that processes translation units in isolation: a translation
+   * unit whose cache entry is up to date is not parsed at all, its
+   * stored replacements are used instead. Pass null to stop using a
+   * cache.
+   */
+  void setCache(ResultCache *c) { cache = c; }
+
+  /**
+   * Use the given precompiled prefixes in runTranslationUnit, and
+   * therefore in every run that processes translation units in
+   * isolation. SharedPrefixPCH::build must have been called for the
+   * source files of the run. Only has an effect when T is a MetaTool.
+   *
+   * Preprocessor callbacks can't see what is in a precompiled prefix,
+   * so translation units are processed without their prefix until one
+   * of them has shown that the tool registers none, and for the whole
+   * run if it does. Pass null to stop using precompiled prefixes.
+   */
+  void setSharedPrefixPCH(const SharedPrefixPCH *p) { sharedPrefix = p; }
+
+  /**
+   * Record the PhaseTimings of every translation unit processed by this
+   * factory, in any kind of run except runShardedAndExportFixes, into
+   * the given log. Only has an effect when T is a MetaTool or a
+   * PreprocessorMetaTool. Pass null to stop measuring.
+   */
+  void setTimingsLog(PhaseTimingsLog *log) { timingsLog = log; }
+
+  /**
+   * The log set with setTimingsLog, if any.
+   */
+  PhaseTimingsLog *getTimingsLog() const { return timingsLog; }
+
+  /**
+   * Profile the matchers of every translation unit processed by this
+   * factory, in any kind of run except runShardedAndExportFixes, and add
+   * the results to the given profile, see MatcherProfile::printReport.
+   * Only has an effect when T is a MetaTool, and is a fatal error when
+   * T is a PreprocessorMetaTool, which runs no matchers. Pass null to
+   * stop profiling.
+   */
+  void setMatcherProfile(MatcherProfile *profile) { matcherProfile = profile; }
+
+  /**
+   * Run the tool on a single translation unit, using its own ClangTool,
+   * compiler instance and MatchFinder, and collect the replacements into
+   * the given map instead of the one this factory was created with.
+   *
+   * Each call gets its own view of the file system, so this is safe to
+   * call concurrently for different translation units.
+   *
+   * If a cache is set, the translation unit is only processed when its
+   * cache entry is missing or out of date, and the entry is refreshed
+   * when it is processed successfully. If precompiled prefixes are set,
+   * the translation unit uses the one built for it, if any. If cacheHit
+   * is given, it is set to whether the replacements came from the cache.
+   */
+  int runTranslationUnit(
+      const clang::tooling::CompilationDatabase &compilations,
+      const std::string &sourcePath,
+      const clang::tooling::ArgumentsAdjuster &adjuster,
+      std::map<std::string, clang::tooling::Replacements> &tuReplacements,
+      bool *cacheHit = nullptr) {
+    // ClangTool changes the working directory of its file system to the
+    // one in the compile command, give it one that isn't linked to the
+    // working directory of the process.
+    llvm::IntrusiveRefCntPtr<llvm::vfs::FileSystem> fs(
+        llvm::vfs::createPhysicalFileSystem().release());
+
+    bool hit =
+        cache && cache->lookup(compilations, sourcePath, tuReplacements);
+    if (cacheHit) {
+      *cacheHit = hit;
+    }
+    if (hit) {
+      return 0;
+    }
+
+    clang::tooling::ArgumentsAdjuster tuAdjuster = adjuster;
+    const SharedPrefixPCH::Prefix *prefix = nullptr;
+    if (sharedPrefix && IsMetaTool<T>::value &&
+        ppCallbacksUse == NoPPCallbacks) {
+      prefix = sharedPrefix->apply(sourcePath, fs, tuAdjuster);
+    }
+
+    std::set<std::string> inputs, missing;
+    if (cache) {
+      fs = ResultCache::recordInputs(fs, inputs, missing);
+    }
+
+    clang::tooling::ClangTool tool(
+        compilations, {sourcePath},
+        std::make_shared<clang::PCHContainerOperations>(), fs);
+    tool.setRestoreWorkingDir(false);
+    if (tuAdjuster) {
+      tool.appendArgumentsAdjuster(tuAdjuster);
+    }
+    MetaToolFactory<T> factory(tuReplacements, args);
+    factory.setTimingsLog(timingsLog);
+    factory.setMatcherProfile(matcherProfile);
+    if (sharedPrefix && ppCallbacksUse == UnknownPPCallbacks) {
+      factory.ppCallbacksObserver = [this](bool registered) {
+        int unknown = UnknownPPCallbacks;
+        if (ppCallbacksUse.compare_exchange_strong(
+                unknown, registered ? SomePPCallbacks : NoPPCallbacks) &&
+            registered) {
+          llvm::errs() << "The tool registers preprocessor callbacks, not "
+                          "using precompiled prefixes\n";
+        }
+      };
+    }
+    int r = tool.run(&factory);
+    if (cache && r == 0) {
+      if (prefix) {
+        // The PCH itself is rebuilt by every run, what the results depend
+        // on are the files it was built from
+        inputs.erase(prefix->pchPath);
+        inputs.insert(prefix->inputs.begin(), prefix->inputs.end());
+        missing.insert(prefix->missingInputs.begin(),
+                       prefix->missingInputs.end());
+      }
+      cache->store(compilations, sourcePath, inputs, missing, tuReplacements);
+    }
+    return r;
+  }
+
+  /**
+   * Run the tool on every given source file using a pool of numThreads
+   * worker threads (zero means one per hardware thread). Every
+   * translation unit is processed in isolation by runTranslationUnit,
+   * and the replacements are merged into the replacements map of this
+   * factory in the order of sourcePaths once all of them are done, so
+   * the result does not depend on scheduling. See setHistory for
+   * scheduling the translation units by cost.
+   *
+   * Like ClangTool::run, returns 1 if any translation unit failed, 2 if
+   * any file was skipped and 0 otherwise.
+   */
+  int runParallel(const clang::tooling::CompilationDatabase &compilations,
+                  const std::vector<std::string> &sourcePaths,
+                  unsigned numThreads = 0,
+                  const clang::tooling::ArgumentsAdjuster &adjuster = nullptr) {
+    std::vector<std::map<std::string, clang::tooling::Replacements>>
+        tuReplacements(sourcePaths.size());
+    std::vector<int> results(sourcePaths.size(), 0);
+    std::vector<MeasuredCost> costs(sourcePaths.size());
+
+    ParallelExecutor executor(numThreads);
+    executor.run(schedule(sourcePaths), [&](size_t i) {
+      results[i] = runTimedTranslationUnit(compilations, sourcePaths[i],
+                                           adjuster, tuReplacements[i],
+                                           costs[i]);
+    });
+
+    for (const auto &tu : tuReplacements) {
+      mergeReplacements(tu);
+    }
+
+    recordCosts(sourcePaths, costs);
+
+    return combineResults(results);
+  }
+
+  /**
+   * Run the tool on every given source file in numWorkers forked worker
+   * processes (zero means one per hardware thread), each one processing
+   * a shard of the source files with runTranslationUnit. The workers
+   * stream the replacements and status of every translation unit back
+   * to this process, where they are merged in the order of sourcePaths
+   * and exported as a single YAML document, like runAndExportFixes.
+   *
+   * A translation unit that crashes its worker is reported as failed,
+   * the rest of the shard is processed by a new worker. Returns 1 if any
+   * translation unit failed, 2 if any file was skipped and 0 otherwise;
+   * the fixes of the successful translation units are exported in all
+   * cases.
+   */
+  int runShardedAndExportFixes(
+      const clang::tooling::CompilationDatabase &compilations,
+      const std::vector<std::string> &sourcePaths, unsigned numWorkers,
+      llvm::raw_ostream &os,
+      const clang::tooling::ArgumentsAdjuster &adjuster = nullptr) {
+    std::vector<std::map<std::string, clang::tooling::Replacements>>
+        tuReplacements(sourcePaths.size());
+    std::vector<int> results(sourcePaths.size(), 0);
+
+    auto job = [&](size_t i, std::string &output) {
+      // Measurements made in a worker process would never reach the
+      // parent
+      timingsLog = nullptr;
+      matcherProfile = nullptr;
+      std::map<std::string, clang::tooling::Replacements> tuMap;
+      int r = runTranslationUnit(compilations, sourcePaths[i], adjuster, tuMap);
+      llvm::raw_string_ostream ss(output);
+      writeFixes(sourcePaths[i], tuMap, ss);
+      ss.flush();
+      return r;
+    };
+
+    auto onResult = [&](size_t i, int status, const std::string &output) {
+      if (status == ShardedExecutor::crashedStatus) {
+        llvm::errs() << "the worker processing " << sourcePaths[i]
+                     << " crashed\n";
+        results[i] = 1;
+        return;
+      }
+      if (status == ShardedExecutor::notStartedStatus) {
+        llvm::errs() << "no worker could be started for " << sourcePaths[i]
+                     << "\n";
+        results[i] = 1;
+        return;
+      }
+      results[i] = status;
+      if (output.empty()) {
+        return;
+      }
+      clang::tooling::TranslationUnitReplacements TUR;
+      llvm::yaml::Input yaml_in(output);
+      yaml_in >> TUR;
+      if (yaml_in.error()) {
+        llvm::errs() << "could not read the replacements for "
+                     << sourcePaths[i] << "\n";
+        results[i] = 1;
+        return;
+      }
+      for (const auto &r : TUR.Replacements) {
+        llvm::consumeError(tuReplacements[i][r.getFilePath().str()].add(r));
+      }
+    };
+
+    // Jobs are dealt out to the shards in order, so the most expensive
+    // translation units get spread over all the workers.
+    std::vector<size_t> order = schedule(sourcePaths);
+    ShardedExecutor executor(numWorkers);
+    executor.run(
+        order.size(),
+        [&](size_t k, std::string &output) { return job(order[k], output); },
+        [&](size_t k, int status, const std::string &output) {
+          onResult(order[k], status, output);
+        });
+
+    for (auto &tu : tuReplacements) {
+      mergeReplacements(tu);
+      tu.clear();
+    }
+    exportFixes(os);
+
+    return combineResults(results);
+  }
+
+  /**
+   * Run the tool on every given source file using a pool of numThreads
+   * worker threads, like runParallel, but instead of collecting the
+   * replacements in the replacements map of this factory, write the
+   * replacements of every translation unit to the stream as soon as it
+   * is done. The output is a stream of YAML documents, one per
+   * translation unit, with MainSourceFile set to its source path.
+   *
+   * Memory use is bounded by the largest translation unit rather than by
+   * the whole run, and the output is usable even if the run dies before
+   * completion. Translation units are not merged, so the same edit to a
+   * shared header can appear in more than one document.
+   */
+  int runAndStreamFixes(
+      const clang::tooling::CompilationDatabase &compilations,
+      const std::vector<std::string> &sourcePaths, llvm::raw_ostream &os,
+      unsigned numThreads = 1,
+      const clang::tooling::ArgumentsAdjuster &adjuster = nullptr) {
+    std::vector<int> results(sourcePaths.size(), 0);
+    std::vector<MeasuredCost> costs(sourcePaths.size());
+    std::mutex outputMutex;
+
+    ParallelExecutor executor(numThreads);
+    executor.run(schedule(sourcePaths), [&](size_t i) {
+      std::map<std::string, clang::tooling::Replacements> tuReplacements;
+      results[i] = runTimedTranslationUnit(compilations, sourcePaths[i],
+                                           adjuster, tuReplacements, costs[i]);
+
+      std::lock_guard<std::mutex> lock(outputMutex);
+      writeFixes(sourcePaths[i], tuReplacements, os);
+      os.flush();
+    });
+
+    recordCosts(sourcePaths, costs);
+
+    return combineResults(results);
+  }
+
+  /**
+   * Same as the above, writing the stream of YAML documents to the file
+   * with the given name. Returns the error code if the file can't be
+   * opened.
+   */
+  int runAndStreamFixes(
+      const clang::tooling::CompilationDatabase &compilations,
+      const std::vector<std::string> &sourcePaths,
+      const std::string &fileName, unsigned numThreads = 1,
+      const clang::tooling::ArgumentsAdjuster &adjuster = nullptr) {
+    std::error_code ec;
+    llvm::raw_fd_ostream ofs(fileName, ec);
+    if (ec) {
+      return ec.value();
+    }
+    return runAndStreamFixes(compilations, sourcePaths, ofs, numThreads,
+                             adjuster);
+  }
+
+  /**
+   * Export every replacement in the replacements map of this factory to
+   * the given stream, as a single YAML document.
+   */
+  void exportFixes(llvm::raw_ostream &os) { writeFixes("", replacements, os); }
+
+  /**
+   * Add the given replacements to the replacements map of this factory.
+   * Replacements that were already added by another translation unit
+   * (typically edits to a shared header) are skipped, conflicting ones
+   * are reported and dropped.
+   */
+  void mergeReplacements(
+      const std::map<std::string, clang::tooling::Replacements> &other) {
+    for (const auto &p : other) {
+      clang::tooling::Replacements &target = replacements[p.first];
+      std::set<clang::tooling::Replacement> &seen = merged[p.first];
+      if (seen.empty() || target.empty()) {
+        // Start from what was put in the map without merging, or after
+        // the map was cleared
+        seen = std::set<clang::tooling::Replacement>(target.begin(),
+                                                     target.end());
+      }
+      for (const auto &r : p.second) {
+        if (!seen.insert(r).second) {
+          continue;
+        }
+        llvm::Error err = target.add(r);
+        if (err) {
+          llvm::errs() << llvm::toString(std::move(err)) << "\n";
+          seen.erase(r);
+        }
+      }
+    }
+  }
 };
 } // namespace clangmetatool
 
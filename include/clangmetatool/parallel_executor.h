@@ -0,0 +1,94 @@
+#ifndef INCLUDED_CLANGMETATOOL_PARALLEL_EXECUTOR_H
+#define INCLUDED_CLANGMETATOOL_PARALLEL_EXECUTOR_H
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace clangmetatool {
+
+/**
+ * Runs a set of independent jobs, identified by their index, on a pool
+ * of worker threads. This is used by MetaToolFactory to process many
+ * translation units at the same time.
+ *
+ * The worker threads are started by the first run that needs them and
+ * wait for the next run in between, so that callers running many short
+ * batches of jobs, like the levels of a graph traversal, don't pay for
+ * starting threads every time. The calling thread works along with
+ * them. A run started while another one has the workers, from a job of
+ * that run for instance, starts threads of its own instead.
+ */
+class ParallelExecutor {
+private:
+  /**
+   * Number of worker threads used by each run.
+   */
+  unsigned numThreads;
+
+  struct Pool;
+  std::unique_ptr<Pool> pool;
+
+public:
+  /**
+   * Job to be executed, receives the index of the job.
+   */
+  typedef std::function<void(size_t)> Job;
+
+  /**
+   * Create an executor with the given number of worker threads. Zero
+   * means one worker per hardware thread.
+   */
+  explicit ParallelExecutor(unsigned numThreads = 0);
+
+  /**
+   * Stop the worker threads.
+   */
+  ~ParallelExecutor();
+
+  ParallelExecutor(const ParallelExecutor &) = delete;
+  ParallelExecutor &operator=(const ParallelExecutor &) = delete;
+
+  /**
+   * Number of worker threads this executor will use.
+   */
+  unsigned getNumThreads() const;
+
+  /**
+   * Invoke the job once for every index in [0, numJobs), in roughly
+   * index order, and return once every job has completed. The job must
+   * be safe to call concurrently from multiple threads.
+   */
+  void run(size_t numJobs, const Job &job) const;
+
+  /**
+   * Invoke the job once for every index in the given order, and return
+   * once every job has completed. The jobs are dealt out to the workers
+   * round-robin, every worker runs its own jobs front to back, and a
+   * worker that runs out of jobs steals from the back of the queue of
+   * another one. Listing the most expensive jobs first keeps a long job
+   * from being started last.
+   */
+  void run(const std::vector<size_t> &order, const Job &job) const;
+};
+
+} // namespace clangmetatool
+
+#endif
+
+// ----------------------------------------------------------------------------
+// Copyright 2026 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,116 @@
+#ifndef INCLUDED_CLANGMETATOOL_PARALLEL_INCLUDE_GRAPH_TRAVERSAL_H
+#define INCLUDED_CLANGMETATOOL_PARALLEL_INCLUDE_GRAPH_TRAVERSAL_H
+
+#include <cstddef>
+#include <vector>
+
+#include <llvm/ADT/ArrayRef.h>
+#include <llvm/ADT/BitVector.h>
+
+#include <clangmetatool/include_graph_csr.h>
+#include <clangmetatool/parallel_executor.h>
+
+namespace clangmetatool {
+
+/**
+ * Breadth-first traversals of the include graph of a
+ * `clangmetatool::IncludeGraphCSR` that spread each level over the
+ * workers of a `clangmetatool::ParallelExecutor`, for the merged graphs
+ * of large projects where a single traversal visits hundreds of
+ * thousands of files.
+ *
+ * Traversals are direction-optimizing: while the frontier is small,
+ * each level follows the includes of the frontier (top-down); once the
+ * frontier has more includes to follow than the files left to visit
+ * have includers, each level looks for an includer in the frontier of
+ * every file left instead (bottom-up), which skips the many includes
+ * that lead to files visited already. The includers of every file are
+ * indexed once, when the traversal is built. Levels too small to be
+ * worth a thread run on the calling one.
+ *
+ * The view and the executor must outlive the traversal.
+ */
+class ParallelIncludeGraphTraversal {
+public:
+  typedef IncludeGraphCSR::Index Index;
+
+private:
+  const IncludeGraphCSR *graph;
+  const ParallelExecutor *executor;
+
+  /**
+   * The includers of every node, in compressed sparse row form.
+   */
+  std::vector<Index> includerOffsets;
+  std::vector<Index> includerTargets;
+  IncludeGraphCSR::Graph includers;
+
+  struct State;
+
+  /**
+   * Visit every node reachable from the sources that the state hasn't
+   * visited yet, mark it visited, and append it to visited if not null.
+   */
+  void visit(llvm::ArrayRef<Index> sources, State &state,
+             std::vector<Index> *visited) const;
+
+public:
+  ParallelIncludeGraphTraversal(const IncludeGraphCSR *graph,
+                                const ParallelExecutor *executor);
+
+  ParallelIncludeGraphTraversal(const ParallelIncludeGraphTraversal &) =
+      delete;
+  ParallelIncludeGraphTraversal &
+  operator=(const ParallelIncludeGraphTraversal &) = delete;
+
+  /**
+   * The view the traversal was built from.
+   */
+  const IncludeGraphCSR *getGraph() const { return graph; }
+
+  /**
+   * The nodes reachable from the sources, the sources included, as bits
+   * indexed by node.
+   */
+  llvm::BitVector reach(llvm::ArrayRef<Index> sources) const;
+
+  /**
+   * For every node, the position in the sources of the first one it is
+   * reachable from, or the number of sources if none reaches it. Each
+   * source is traversed in turn, skipping what the ones before it
+   * reached.
+   */
+  std::vector<Index> firstReachingSource(llvm::ArrayRef<Index> sources) const;
+
+  /**
+   * For each of the targets, the sources it is reachable from, as bits
+   * in the order of the sources. The sources are traversed 64 at a
+   * time, each node carrying a word of the sources of the batch that
+   * reach it, and a node is only followed again when its word gains
+   * bits, instead of once per source that reaches it. These traversals
+   * are always top-down.
+   */
+  std::vector<llvm::BitVector>
+  reachingSources(llvm::ArrayRef<Index> sources,
+                  llvm::ArrayRef<Index> targets) const;
+};
+
+} // namespace clangmetatool
+
+#endif
+
+// ----------------------------------------------------------------------------
+// Copyright 2026 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,192 @@
+#ifndef INCLUDED_CLANGMETATOOL_PCH_RECOMMENDER_H
+#define INCLUDED_CLANGMETATOOL_PCH_RECOMMENDER_H
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <llvm/Support/Chrono.h>
+#include <llvm/Support/raw_ostream.h>
+
+#include <clangmetatool/collectors/include_graph_data.h>
+#include <clangmetatool/types/file_uid.h>
+
+namespace clangmetatool {
+
+/**
+ * Suggests the contents of a precompiled header for the translation
+ * units of an include graph, usually the merged graph of a
+ * `ProjectIncludeGraph` over the translation units of one target.
+ *
+ * Every file nobody includes is taken as the main file of a translation
+ * unit. A header is a candidate when enough translation units include
+ * it, directly or not, when a file of the project includes it by name,
+ * so that internal headers of libraries are left to the headers that
+ * include them, and when neither it nor anything it includes changed
+ * recently, since any change to the precompiled header rebuilds every
+ * translation unit. System headers never count as changed.
+ *
+ * Candidates are ranked by the bytes they would save the build, the
+ * size of their transitive closure times the number of translation
+ * units including them, and picked in that order unless an already
+ * picked header includes them.
+ */
+class PCHRecommender {
+public:
+  struct Options {
+    /**
+     * Fraction of the translation units that must include a header for
+     * it to be a candidate.
+     */
+    double minTranslationUnitFraction = 0.5;
+
+    /**
+     * How long a header and everything it includes must have stayed
+     * unmodified for it to be a candidate.
+     */
+    std::chrono::seconds minStableAge = std::chrono::hours(24 * 30);
+
+    /**
+     * Largest size in bytes of the precompiled header, with everything
+     * it includes, or zero for no limit.
+     */
+    uint64_t maxBytes = 0;
+  };
+
+  /**
+   * What the recommender needs to know about a file.
+   */
+  struct FileStatus {
+    uint64_t bytes = 0;
+    llvm::sys::TimePoint<> modified;
+  };
+
+  struct Candidate {
+    types::FileUID uid = 0;
+    std::string path;
+    bool isSystem = false;
+
+    /**
+     * Bytes of the header and everything it includes transitively.
+     */
+    uint64_t closureBytes = 0;
+
+    /**
+     * Number of translation units that include the header, directly or
+     * not.
+     */
+    size_t translationUnits = 0;
+
+    /**
+     * Time since the most recent change to the header or anything it
+     * includes, zero for system headers.
+     */
+    std::chrono::seconds age = std::chrono::seconds(0);
+
+    /**
+     * Whether the header is part of the suggested precompiled header.
+     */
+    bool selected = false;
+  };
+
+private:
+  size_t numTranslationUnits = 0;
+  std::vector<Candidate> candidates;
+  std::vector<Candidate> selection;
+  uint64_t bytes = 0;
+  std::map<types::FileUID, uint64_t> savedBytes;
+
+public:
+  /**
+   * Look up the size and modification time of every file of the graph
+   * and pick the headers. Files are found by their real path, or by
+   * their name when it is not known.
+   */
+  PCHRecommender(const collectors::IncludeGraphData *data,
+                 const Options &options);
+
+  /**
+   * Same as above, with the default options.
+   */
+  explicit PCHRecommender(const collectors::IncludeGraphData *data);
+
+  /**
+   * Pick the headers of the graph given the status of its files,
+   * looked up beforehand, at the given time. Files without a status
+   * count as empty and never modified.
+   */
+  PCHRecommender(const collectors::IncludeGraphData *data,
+                 const std::map<types::FileUID, FileStatus> &files,
+                 const Options &options, llvm::sys::TimePoint<> now);
+
+  /**
+   * Number of files taken as main files of translation units.
+   */
+  size_t getNumTranslationUnits() const { return numTranslationUnits; }
+
+  /**
+   * Every candidate, from the one that would save the most bytes to
+   * the one that would save the least.
+   */
+  const std::vector<Candidate> &getCandidates() const { return candidates; }
+
+  /**
+   * The headers of the suggested precompiled header, in the order they
+   * are included: system headers first, then by path.
+   */
+  const std::vector<Candidate> &getSelection() const { return selection; }
+
+  /**
+   * Bytes of the suggested precompiled header and everything it
+   * includes.
+   */
+  uint64_t getBytes() const { return bytes; }
+
+  /**
+   * Bytes each translation unit would not parse anymore with the
+   * suggested precompiled header, by file uid of its main file.
+   */
+  const std::map<types::FileUID, uint64_t> &getSavedBytes() const {
+    return savedBytes;
+  }
+
+  /**
+   * Average of getSavedBytes over the translation units.
+   */
+  double getAverageSavedBytes() const;
+
+  /**
+   * Write the suggested precompiled header, including every selected
+   * header by path.
+   */
+  void writeHeader(llvm::raw_ostream &os) const;
+
+  /**
+   * Print the best candidates, at most limit of them, and what the
+   * suggested precompiled header would save.
+   */
+  void printReport(llvm::raw_ostream &os, size_t limit = 20) const;
+};
+
+} // namespace clangmetatool
+
+#endif
+
+// ----------------------------------------------------------------------------
+// Copyright 2026 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
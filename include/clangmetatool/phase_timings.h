@@ -0,0 +1,144 @@
+#ifndef INCLUDED_CLANGMETATOOL_PHASE_TIMINGS_H
+#define INCLUDED_CLANGMETATOOL_PHASE_TIMINGS_H
+
+#include <cstddef>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <llvm/Support/raw_ostream.h>
+
+#include <sys/resource.h>
+
+namespace clangmetatool {
+
+/**
+ * Where the time went while MetaTool, or PreprocessorMetaTool, processed
+ * a translation unit.
+ */
+struct PhaseTimings {
+  /**
+   * Main source file of the translation unit.
+   */
+  std::string mainFile;
+
+  /**
+   * Creating the wrapped tool, which registers its matchers and
+   * callbacks, and the AST consumer, in seconds.
+   */
+  double setupSeconds = 0;
+
+  /**
+   * Preprocessing, parsing and semantic analysis, in seconds. Clang
+   * does those in a single interleaved pass, so they are measured
+   * together. Only preprocessing under PreprocessorMetaTool.
+   */
+  double frontendSeconds = 0;
+
+  /**
+   * Running the MatchFinder over the AST, in seconds.
+   */
+  double matchSeconds = 0;
+
+  /**
+   * Running the postProcessing method of the wrapped tool, in seconds.
+   */
+  double postProcessingSeconds = 0;
+
+  /**
+   * Everything from the start of the setup to the end of the
+   * postProcessing, in seconds.
+   */
+  double totalSeconds = 0;
+
+  /**
+   * Peak resident memory of the whole process once the translation unit
+   * was done, in kilobytes. This is a high-water mark: it never goes
+   * down and includes every translation unit the process handled before
+   * or alongside this one, so it is not the cost of this one alone.
+   */
+  size_t processPeakMemoryKB = 0;
+
+  /**
+   * Write the timings as a single line JSON object.
+   */
+  void writeJSON(llvm::raw_ostream &os) const;
+
+  /**
+   * Peak resident memory of this process so far, in kilobytes.
+   */
+  static size_t measureProcessPeakMemoryKB() {
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) {
+      return 0;
+    }
+    // ru_maxrss is in kilobytes on Linux
+    return usage.ru_maxrss;
+  }
+};
+
+/**
+ * Receives the PhaseTimings of every translation unit processed by the
+ * MetaTools it is given to. MetaTool only goes through this interface,
+ * so that tools not measuring anything don't need this library.
+ */
+class PhaseTimingsSink {
+public:
+  virtual ~PhaseTimingsSink() = default;
+
+  /**
+   * Add the timings of a translation unit.
+   */
+  virtual void record(const PhaseTimings &t) = 0;
+};
+
+/**
+ * Collects the PhaseTimings of every translation unit processed by the
+ * MetaTools it is given to, optionally writing each of them as a JSON
+ * line as soon as it is recorded. It can be shared by concurrent runs.
+ */
+class PhaseTimingsLog : public PhaseTimingsSink {
+private:
+  mutable std::mutex mutex;
+  std::vector<PhaseTimings> timings;
+  llvm::raw_ostream *jsonLines = nullptr;
+
+public:
+  /**
+   * Keep the timings in memory only.
+   */
+  PhaseTimingsLog() = default;
+
+  /**
+   * Also write every timing to the given stream, one JSON object per
+   * line.
+   */
+  explicit PhaseTimingsLog(llvm::raw_ostream &jsonLines);
+
+  void record(const PhaseTimings &t) override;
+
+  /**
+   * Timings recorded so far, in the order they were recorded.
+   */
+  std::vector<PhaseTimings> getTimings() const;
+};
+
+} // namespace clangmetatool
+
+#endif
+
+// ----------------------------------------------------------------------------
+// Copyright 2026 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,165 @@
+#ifndef INCLUDED_CLANGMETATOOL_PREPROCESSOR_META_TOOL_H
+#define INCLUDED_CLANGMETATOOL_PREPROCESSOR_META_TOOL_H
+
+#include <assert.h>
+#include <chrono>
+#include <map>
+#include <memory>
+#include <string>
+#include <type_traits>
+
+#include <clang/ASTMatchers/ASTMatchFinder.h>
+#include <clang/Basic/TokenKinds.h>
+#include <clang/Frontend/CompilerInstance.h>
+#include <clang/Frontend/FrontendAction.h>
+#include <clang/Lex/Preprocessor.h>
+#include <clang/Lex/Token.h>
+#include <clang/Tooling/Core/Replacement.h>
+
+#include <clangmetatool/meta_tool.h>
+#include <clangmetatool/phase_timings.h>
+
+namespace clangmetatool {
+
+/**
+ * PreprocessorMetaTool runs the same kind of WrappedTool as MetaTool,
+ * but only preprocesses the translation unit: there is no parsing,
+ * semantic analysis or AST, and the matchers the tool adds to the
+ * MatchFinder are never run. Only what is collected by PPCallbacks is
+ * available to the postProcessing method.
+ *
+ * That is much faster for tools that only look at the include structure
+ * and the macros, such as the include_graph, include_statements and
+ * macro_references of the `IncludeGraph` collector; the references
+ * found by its matchers are left empty.
+ *
+ * Macros are expanded everywhere, not only in directives as clang's
+ * dependency scanner does, so that the macro references of the code
+ * are seen.
+ *
+ * Phase timings are recorded like MetaTool does, with the preprocessing
+ * as the frontend phase and no match phase. There is nothing for a
+ * matcher profile to measure.
+ */
+template <class WrappedTool>
+class PreprocessorMetaTool : public clang::PreprocessorFrontendAction {
+private:
+  static constexpr bool providesArgTypes =
+      has_typedef_ArgTypes<WrappedTool>::value;
+  struct NoArgs {
+    typedef void *ArgTypes;
+  };
+
+public:
+  typedef typename std::conditional_t<providesArgTypes, WrappedTool,
+                                      NoArgs>::ArgTypes ArgTypes;
+
+private:
+  std::map<std::string, clang::tooling::Replacements> &replacementsMap;
+  std::unique_ptr<clang::ast_matchers::MatchFinder> f;
+  std::unique_ptr<WrappedTool> tool;
+
+  ArgTypes &args;
+
+  typedef std::chrono::steady_clock Clock;
+
+  PhaseTimingsSink *timingsLog = nullptr;
+  PhaseTimings timings;
+  Clock::time_point startTime;
+
+  static double secondsBetween(Clock::time_point from, Clock::time_point to) {
+    return std::chrono::duration<double>(to - from).count();
+  }
+
+  template <class A>
+  WrappedTool *create_tool(clang::CompilerInstance &ci, A args) {
+    return new WrappedTool(&ci, f.get(), args);
+  }
+  WrappedTool *create_tool(clang::CompilerInstance &ci,
+                           typename NoArgs::ArgTypes &args) {
+    return new WrappedTool(&ci, f.get());
+  }
+
+public:
+  PreprocessorMetaTool(
+      std::map<std::string, clang::tooling::Replacements> &replacementsMap,
+      ArgTypes &args)
+      : replacementsMap(replacementsMap), args(args) {}
+
+  PreprocessorMetaTool(
+      std::map<std::string, clang::tooling::Replacements> &replacementsMap)
+      : replacementsMap(replacementsMap) {}
+
+  /**
+   * Record how long each phase of processing the translation unit
+   * takes into the given log, see MetaTool::setTimingsLog. Pass null,
+   * the default, to not measure anything.
+   */
+  void setTimingsLog(PhaseTimingsSink *log) { timingsLog = log; }
+
+  virtual bool BeginSourceFileAction(clang::CompilerInstance &ci) override {
+    if (timingsLog) {
+      startTime = Clock::now();
+      timings = PhaseTimings();
+      timings.mainFile = getCurrentFile().str();
+    }
+
+    // see MetaTool::BeginSourceFileAction
+    assert(!tool);
+    f = std::make_unique<clang::ast_matchers::MatchFinder>();
+    tool.reset(create_tool(ci, args));
+    return true;
+  }
+
+  virtual void ExecuteAction() override {
+    Clock::time_point preprocessingStart;
+    if (timingsLog) {
+      preprocessingStart = Clock::now();
+      timings.setupSeconds = secondsBetween(startTime, preprocessingStart);
+    }
+
+    clang::Preprocessor &pp = getCompilerInstance().getPreprocessor();
+    pp.EnterMainSourceFile();
+    clang::Token token;
+    do {
+      pp.Lex(token);
+    } while (token.isNot(clang::tok::eof));
+
+    if (!timingsLog) {
+      tool->postProcessing(replacementsMap);
+      return;
+    }
+
+    Clock::time_point postProcessingStart = Clock::now();
+    timings.frontendSeconds =
+        secondsBetween(preprocessingStart, postProcessingStart);
+
+    tool->postProcessing(replacementsMap);
+
+    Clock::time_point end = Clock::now();
+    timings.postProcessingSeconds = secondsBetween(postProcessingStart, end);
+    timings.totalSeconds = secondsBetween(startTime, end);
+    timings.processPeakMemoryKB =
+        PhaseTimings::measureProcessPeakMemoryKB();
+    timingsLog->record(timings);
+  }
+};
+} // namespace clangmetatool
+
+#endif
+
+// ----------------------------------------------------------------------------
+// Copyright 2026 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
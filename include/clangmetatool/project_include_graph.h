@@ -0,0 +1,146 @@
+#ifndef INCLUDED_CLANGMETATOOL_PROJECT_INCLUDE_GRAPH_H
+#define INCLUDED_CLANGMETATOOL_PROJECT_INCLUDE_GRAPH_H
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <clang/Basic/SourceManager.h>
+
+#include <clangmetatool/collectors/include_graph_data.h>
+
+namespace clangmetatool {
+
+/**
+ * The include graphs of many translation units merged into one graph
+ * of the whole project.
+ *
+ * The file uids of an `IncludeGraphData` are only meaningful within its
+ * translation unit, so every file is identified by a key that is the
+ * same in all of them: its real path, or the hash of its content and
+ * its name, which also merges identical copies of a file. The
+ * include_graph, use_graph, definition_uses and usage_reference_count
+ * of each translation unit are translated to those keys and merged.
+ * Translation units can be added concurrently.
+ */
+class ProjectIncludeGraph {
+public:
+  /**
+   * What makes two files of different translation units the same file.
+   */
+  enum class FileIdentity {
+    /**
+     * The absolute path, with symbolic links resolved.
+     */
+    RealPath,
+
+    /**
+     * The hash of the content and the file name, so that copies of a
+     * file in different directories are merged, but not different files
+     * that happen to have the same content, such as empty headers. Files
+     * that can't be read are identified by their real path.
+     */
+    ContentHash,
+  };
+
+private:
+  typedef uint32_t FileID;
+  typedef std::pair<FileID, FileID> Edge;
+
+  FileIdentity identity;
+
+  /**
+   * Key and canonical path of the files seen so far, by the path a
+   * translation unit gave for them, since headers are seen by many
+   * translation units.
+   */
+  std::map<std::string, std::pair<std::string, std::string>> keys;
+  std::mutex keysMutex;
+
+  std::pair<std::string, std::string> keyOf(const std::string &path);
+
+  mutable std::mutex mutex;
+  size_t numTranslationUnits = 0;
+
+  /**
+   * Whether every translation unit added so far filled its
+   * definition_uses.
+   */
+  bool definitionUsesComplete = true;
+
+  /**
+   * Id of each file key, in the order they were first seen, and the
+   * path and system header flag of each id.
+   */
+  std::map<std::string, FileID> ids;
+  std::vector<std::string> paths;
+  std::vector<bool> isSystem;
+
+  std::set<Edge> includeGraph;
+  std::set<Edge> useGraph;
+  std::set<Edge> definitionUses;
+  std::map<Edge, size_t> usageReferenceCount;
+
+public:
+  explicit ProjectIncludeGraph(FileIdentity identity = FileIdentity::RealPath);
+
+  /**
+   * Merge the include graph of a translation unit, usually from the
+   * postProcessing of a tool with an `IncludeGraph` collector, given the
+   * source manager of the translation unit.
+   *
+   * A header is parsed again by every translation unit that includes
+   * it, so the reference counts of an edge seen in many translation
+   * units are not added up: the largest one is kept.
+   */
+  void add(const collectors::IncludeGraphData *data,
+           const clang::SourceManager &sm);
+
+  /**
+   * Number of translation units added so far.
+   */
+  size_t getNumTranslationUnits() const;
+
+  /**
+   * Number of distinct files seen so far.
+   */
+  size_t getNumFiles() const;
+
+  /**
+   * The merged graph, as an `IncludeGraphData` whose file uids are
+   * numbered in the order of the file keys, so they don't depend on the
+   * order the translation units were added in, and whose fuid2name holds
+   * the path of each file. Only the graphs, the reference counts, the
+   * name and path indices and is_system are filled, which is what
+   * `IncludeGraphDependencies`, `IncludeGraphCSR` and
+   * `IncludeGraphReachability` need. Its details are
+   * `IncludeGraphData::ForwardDeclarationDetails` when every translation
+   * unit was collected with it, `IncludeGraphData::NoDetails` otherwise.
+   */
+  collectors::IncludeGraphData getData() const;
+};
+
+} // namespace clangmetatool
+
+#endif
+
+// ----------------------------------------------------------------------------
+// Copyright 2026 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,110 @@
+#ifndef INCLUDED_CLANGMETATOOL_RESULT_CACHE_H
+#define INCLUDED_CLANGMETATOOL_RESULT_CACHE_H
+
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+
+#include <clang/Tooling/CompilationDatabase.h>
+#include <clang/Tooling/Core/Replacement.h>
+#include <llvm/ADT/IntrusiveRefCntPtr.h>
+#include <llvm/Support/VirtualFileSystem.h>
+
+namespace clangmetatool {
+
+/**
+ * On-disk cache of the replacements produced for each translation unit,
+ * used by MetaToolFactory to skip parsing translation units whose
+ * inputs did not change since the last run.
+ *
+ * Entries are keyed on the source path, its compile commands and a
+ * tool-provided key, which should change whenever the behavior of the
+ * tool does. Every entry records the content hash of each file that was
+ * read while processing the translation unit (the main file and its
+ * whole include closure), and the paths that were looked up and not
+ * found (include directories searched before the one holding a header,
+ * failed `__has_include`). It is only used if none of the files changed
+ * and none of the missing paths exists.
+ */
+class ResultCache {
+private:
+  /**
+   * Directory holding one file per entry.
+   */
+  std::string directory;
+
+  /**
+   * Identifies the tool and its configuration.
+   */
+  std::string toolKey;
+
+  /**
+   * Content hashes already computed during this run, by path. Headers
+   * are shared by many translation units, so each is read only once.
+   */
+  std::map<std::string, std::string> contentHashes;
+  std::mutex contentHashesMutex;
+
+  std::string entryPath(const clang::tooling::CompilationDatabase &compilations,
+                        const std::string &sourcePath) const;
+
+  std::string contentHash(const std::string &path);
+
+public:
+  /**
+   * Use the given directory, created if needed, to hold the cache of the
+   * tool identified by toolKey.
+   */
+  ResultCache(const std::string &directory, const std::string &toolKey);
+
+  /**
+   * Look for an up-to-date entry for the given translation unit. On a
+   * hit, add the stored replacements to the map and return true.
+   */
+  bool
+  lookup(const clang::tooling::CompilationDatabase &compilations,
+         const std::string &sourcePath,
+         std::map<std::string, clang::tooling::Replacements> &replacements);
+
+  /**
+   * Store the replacements produced for the given translation unit,
+   * along with the hashes of the files it read and the paths it didn't
+   * find.
+   */
+  void store(const clang::tooling::CompilationDatabase &compilations,
+             const std::string &sourcePath,
+             const std::set<std::string> &inputs,
+             const std::set<std::string> &missing,
+             const std::map<std::string, clang::tooling::Replacements>
+                 &replacements);
+
+  /**
+   * Wrap the given file system so that the absolute path of every file
+   * opened through it is added to inputs, and the absolute path of
+   * every file it failed to find to missing.
+   */
+  static llvm::IntrusiveRefCntPtr<llvm::vfs::FileSystem>
+  recordInputs(llvm::IntrusiveRefCntPtr<llvm::vfs::FileSystem> fs,
+               std::set<std::string> &inputs, std::set<std::string> &missing);
+};
+
+} // namespace clangmetatool
+
+#endif
+
+// ----------------------------------------------------------------------------
+// Copyright 2026 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,94 @@
+#ifndef INCLUDED_CLANGMETATOOL_SHARDED_EXECUTOR_H
+#define INCLUDED_CLANGMETATOOL_SHARDED_EXECUTOR_H
+
+#include <cstddef>
+#include <functional>
+#include <string>
+
+namespace clangmetatool {
+
+/**
+ * Runs a set of independent jobs, identified by their index, in forked
+ * worker processes. The jobs are split into one shard per worker, and
+ * every worker streams the status and serialized output of each job
+ * back to the parent process over a pipe.
+ *
+ * A worker that dies while running a job only costs that job: it is
+ * reported with the `crashedStatus` status, and a new worker is started
+ * for the rest of the shard. A worker that can't be started, because
+ * the system is out of processes or file descriptors, costs the rest of
+ * its shard: those jobs are reported with the `notStartedStatus` status
+ * while the other workers carry on.
+ */
+class ShardedExecutor {
+private:
+  /**
+   * Number of worker processes used by each run.
+   */
+  unsigned numWorkers;
+
+public:
+  /**
+   * Status reported for a job whose worker process died while running
+   * it.
+   */
+  static constexpr int crashedStatus = -1;
+
+  /**
+   * Status reported for the jobs of a shard whose worker process could
+   * not be started.
+   */
+  static constexpr int notStartedStatus = -2;
+
+  /**
+   * Job to be executed in a worker process, receives the index of the
+   * job and a string to write its serialized output into, returns the
+   * status of the job.
+   */
+  typedef std::function<int(size_t, std::string &)> Job;
+
+  /**
+   * Called in the parent process with the index, status and output of
+   * every job as soon as it is received.
+   */
+  typedef std::function<void(size_t, int, const std::string &)> ResultHandler;
+
+  /**
+   * Create an executor with the given number of worker processes. Zero
+   * means one worker per hardware thread.
+   */
+  explicit ShardedExecutor(unsigned numWorkers = 0);
+
+  /**
+   * Number of worker processes this executor will use.
+   */
+  unsigned getNumWorkers() const;
+
+  /**
+   * Run the job for every index in [0, numJobs), job `i` being part of
+   * the shard of worker `i % numWorkers`. The result handler is called
+   * exactly once for every job, from the calling thread. Returns once
+   * every job has been reported.
+   */
+  void run(size_t numJobs, const Job &job, const ResultHandler &onResult) const;
+};
+
+} // namespace clangmetatool
+
+#endif
+
+// ----------------------------------------------------------------------------
+// Copyright 2026 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,135 @@
+#ifndef INCLUDED_CLANGMETATOOL_SHARED_PREFIX_PCH_H
+#define INCLUDED_CLANGMETATOOL_SHARED_PREFIX_PCH_H
+
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+#include <clang/Tooling/ArgumentsAdjusters.h>
+#include <clang/Tooling/CompilationDatabase.h>
+#include <llvm/ADT/IntrusiveRefCntPtr.h>
+#include <llvm/Support/VirtualFileSystem.h>
+
+namespace clangmetatool {
+
+/**
+ * Precompiled headers for the include prefixes shared by many
+ * translation units, so that the headers at the top of those
+ * translation units are parsed once instead of once per translation
+ * unit.
+ *
+ * The prefix of a translation unit is taken from its preamble, the
+ * preprocessor directives and comments before its first declaration,
+ * cut only where no conditional directive or comment is open. For
+ * every translation unit, the longest prefix it shares with enough
+ * other translation units that have the same compile command is built
+ * into a PCH. When the translation unit is processed, its prefix is
+ * blanked out (keeping every offset and line number unchanged) and the
+ * PCH is included instead.
+ *
+ * Since the prefix is never preprocessed as part of the translation
+ * unit, preprocessor callbacks wouldn't see its include directives and
+ * macro expansions. MetaToolFactory only uses the prefixes once it has
+ * seen that the tool registers no preprocessor callbacks, for example
+ * because it doesn't use the IncludeGraph collector.
+ */
+class SharedPrefixPCH {
+public:
+  /**
+   * A prefix shared by a group of translation units.
+   */
+  struct Prefix {
+    /**
+     * Text of the prefix, as found at the start of each source file.
+     */
+    std::string text;
+
+    /**
+     * Absolute path of the precompiled prefix.
+     */
+    std::string pchPath;
+
+    /**
+     * Absolute paths of the files read to build the PCH, and of the
+     * ones looked up and not found.
+     */
+    std::set<std::string> inputs;
+    std::set<std::string> missingInputs;
+  };
+
+private:
+  /**
+   * Directory holding the prefix headers and their PCH.
+   */
+  std::string directory;
+
+  /**
+   * Smallest number of translation units that must share a prefix for
+   * it to be precompiled.
+   */
+  unsigned minGroupSize;
+
+  /**
+   * Prefix used by each translation unit, by absolute source path.
+   */
+  std::map<std::string, std::shared_ptr<const Prefix>> prefixes;
+
+public:
+  /**
+   * Keep the precompiled prefixes in the given directory, created if
+   * needed, and only precompile prefixes shared by at least
+   * minGroupSize translation units.
+   */
+  explicit SharedPrefixPCH(const std::string &directory,
+                           unsigned minGroupSize = 2);
+
+  /**
+   * Find the prefixes shared by the given source files and build a PCH
+   * for each of them, using up to numThreads threads (zero means one
+   * per hardware thread). Source files with more than one compile
+   * command are left alone, as are prefixes whose PCH fails to build.
+   * Returns the number of PCHs built.
+   */
+  size_t build(const clang::tooling::CompilationDatabase &compilations,
+               const std::vector<std::string> &sourcePaths,
+               unsigned numThreads = 1);
+
+  /**
+   * Return the prefix used by the given source file, or null if it
+   * doesn't use one.
+   */
+  const Prefix *lookup(const std::string &sourcePath) const;
+
+  /**
+   * Make the given translation unit use its PCH, if it has one and its
+   * source file still starts with the prefix: the file system is
+   * wrapped to blank out the prefix, and the adjuster is extended to
+   * include the PCH. Returns the prefix used, or null, leaving the file
+   * system and adjuster untouched, if there is none.
+   */
+  const Prefix *apply(const std::string &sourcePath,
+                      llvm::IntrusiveRefCntPtr<llvm::vfs::FileSystem> &fs,
+                      clang::tooling::ArgumentsAdjuster &adjuster) const;
+};
+
+} // namespace clangmetatool
+
+#endif
+
+// ----------------------------------------------------------------------------
+// Copyright 2026 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,171 @@
+#ifndef INCLUDED_CLANGMETATOOL_TOOL_SERVER_H
+#define INCLUDED_CLANGMETATOOL_TOOL_SERVER_H
+
+#include <functional>
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+#include <clang/Basic/FileManager.h>
+#include <llvm/ADT/IntrusiveRefCntPtr.h>
+#include <llvm/Support/Chrono.h>
+#include <llvm/Support/MemoryBuffer.h>
+#include <llvm/Support/VirtualFileSystem.h>
+#include <llvm/Support/raw_ostream.h>
+
+namespace clangmetatool {
+
+/**
+ * Long-lived server answering analysis requests over a local Unix
+ * socket, so that a tool pays its startup cost once instead of on every
+ * invocation.
+ *
+ * Between requests the server keeps one FileManager per working
+ * directory, and the contents of every file read through them. Before
+ * each request, the files that the requested source files opened in
+ * earlier requests are checked against the disk (all of them for a
+ * source file never requested before), as well as the directories in
+ * which paths were found missing, and all the caches are dropped if
+ * anything changed.
+ *
+ * A request is a command line ("run" or "shutdown") followed by one
+ * line per source path. The response is the status of the request on
+ * its own line, followed by the output of the request handler.
+ */
+class ToolServer {
+public:
+  /**
+   * Status and contents of a cached file, as they were when it was
+   * read.
+   */
+  struct CachedFile {
+    llvm::vfs::Status status;
+    std::unique_ptr<llvm::MemoryBuffer> contents;
+  };
+
+  /**
+   * Handles a "run" request for the given source paths, writing its
+   * output to the stream and returning its status.
+   */
+  typedef std::function<int(const std::vector<std::string> &,
+                            llvm::raw_ostream &)>
+      Handler;
+
+private:
+  /**
+   * Path of the Unix socket the server listens on.
+   */
+  std::string socketPath;
+
+  /**
+   * Time a client has to send its whole request, in milliseconds.
+   */
+  int receiveTimeoutMs;
+
+  /**
+   * File managers kept warm between requests, by working directory.
+   */
+  std::map<std::string, llvm::IntrusiveRefCntPtr<clang::FileManager>>
+      fileManagers;
+
+  /**
+   * Contents of every file read through the file managers, by absolute
+   * path.
+   */
+  std::map<std::string, CachedFile> files;
+
+  /**
+   * Absolute paths of the cached files opened by each requested source
+   * file, and of the ones opened by the current request.
+   */
+  std::map<std::string, std::set<std::string>> filesBySource;
+  std::set<std::string> opened;
+
+  /**
+   * Modification time of every directory in which a path was looked up
+   * but didn't exist, since the file managers remember those too.
+   * Creating the path would change it.
+   */
+  std::map<std::string, llvm::sys::TimePoint<>> missingDirectories;
+
+  /**
+   * Drop every cache if a file the given source files opened changed
+   * on disk, or a path that was missing may now exist.
+   */
+  void refresh(const std::vector<std::string> &sourcePaths);
+
+public:
+  /**
+   * Create a server for the given socket path, nothing happens until
+   * `serve` is called. A client that takes longer than receiveTimeoutMs
+   * to send its request is dropped.
+   */
+  explicit ToolServer(const std::string &socketPath,
+                      int receiveTimeoutMs = 10000);
+
+  /**
+   * Listen on the socket, which only the owner of the process may
+   * connect to, and handle requests one at a time, until a "shutdown"
+   * request is received. Returns 0 on a clean shutdown, or 1 if the
+   * socket couldn't be set up.
+   */
+  int serve(const Handler &handler);
+
+  /**
+   * Return the file manager to use for translation units compiled in
+   * the given directory. It is only valid until the end of the current
+   * request, and should not be used by more than one ClangTool at a
+   * time.
+   */
+  llvm::IntrusiveRefCntPtr<clang::FileManager>
+  getFileManager(const std::string &workingDir);
+
+  /**
+   * Return a file system that reads through the caches of the server,
+   * for ClangTool versions that don't take a file manager, before LLVM
+   * 10. Only the contents of the files are kept between requests then.
+   */
+  llvm::IntrusiveRefCntPtr<llvm::vfs::FileSystem> getFileSystem();
+
+  /**
+   * Number of files whose contents are currently cached.
+   */
+  size_t getNumCachedFiles() const;
+
+  /**
+   * Send a "run" request for the given source paths to the server
+   * listening on the given socket, write its output to the stream and
+   * return its status. Returns 1 if the server can't be reached.
+   */
+  static int request(const std::string &socketPath,
+                     const std::vector<std::string> &sourcePaths,
+                     llvm::raw_ostream &os);
+
+  /**
+   * Ask the server listening on the given socket to stop. Returns 1 if
+   * the server can't be reached.
+   */
+  static int shutdown(const std::string &socketPath);
+};
+
+} // namespace clangmetatool
+
+#endif
+
+// ----------------------------------------------------------------------------
+// Copyright 2026 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,104 @@
+#ifndef INCLUDED_CLANGMETATOOL_TRANSLATION_UNIT_HISTORY_H
+#define INCLUDED_CLANGMETATOOL_TRANSLATION_UNIT_HISTORY_H
+
+#include <cstddef>
+#include <map>
+#include <string>
+#include <system_error>
+#include <vector>
+
+namespace clangmetatool {
+
+/**
+ * Historical cost of processing each translation unit, kept in a local
+ * history file between runs. MetaToolFactory uses it to schedule the
+ * most expensive translation units first, so a long run doesn't end
+ * with a tail of single heavyweight translation units.
+ *
+ * The file has one line per translation unit with the wall time in
+ * seconds, the peak memory of the process in kilobytes and the source
+ * path, separated by spaces.
+ */
+class TranslationUnitHistory {
+public:
+  /**
+   * What was measured the last time a translation unit was processed.
+   */
+  struct Record {
+    /**
+     * Wall time spent processing the translation unit, in seconds.
+     */
+    double wallSeconds = 0;
+
+    /**
+     * Peak resident memory of the whole process when the translation
+     * unit was done, in kilobytes. It only grows during a run and
+     * includes every translation unit processed before or alongside
+     * this one, so it is an upper bound rather than the cost of this
+     * one.
+     */
+    size_t processPeakMemoryKB = 0;
+  };
+
+private:
+  /**
+   * Path of the history file.
+   */
+  std::string fileName;
+
+  /**
+   * Last record for each source path.
+   */
+  std::map<std::string, Record> records;
+
+public:
+  /**
+   * Use the history file at the given path, loading it if it exists.
+   * Lines that can't be parsed are ignored.
+   */
+  explicit TranslationUnitHistory(const std::string &fileName);
+
+  /**
+   * Return the last record for the given source path, or null if it
+   * was never processed.
+   */
+  const Record *lookup(const std::string &sourcePath) const;
+
+  /**
+   * Replace the record for the given source path.
+   */
+  void record(const std::string &sourcePath, const Record &r);
+
+  /**
+   * Return the indexes of the given source paths from the most to the
+   * least expensive. Source paths without history come first, since
+   * nothing is known about their cost, keeping their relative order.
+   */
+  std::vector<size_t>
+  schedule(const std::vector<std::string> &sourcePaths) const;
+
+  /**
+   * Write the history back to the file it was loaded from.
+   */
+  std::error_code save() const;
+};
+
+} // namespace clangmetatool
+
+#endif
+
+// ----------------------------------------------------------------------------
+// Copyright 2026 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
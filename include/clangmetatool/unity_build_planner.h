@@ -0,0 +1,199 @@
+#ifndef INCLUDED_CLANGMETATOOL_UNITY_BUILD_PLANNER_H
+#define INCLUDED_CLANGMETATOOL_UNITY_BUILD_PLANNER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+#include <vector>
+
+#include <clang/Basic/SourceManager.h>
+#include <llvm/Support/raw_ostream.h>
+
+#include <clangmetatool/collectors/definitions_data.h>
+#include <clangmetatool/collectors/include_graph_data.h>
+
+namespace clangmetatool {
+
+/**
+ * Groups translation units into unity builds, where a single source
+ * file includes every source file of a group, so that the headers they
+ * share are parsed once per group instead of once per translation unit.
+ *
+ * Each translation unit added to the planner is described by the
+ * transitive closure of its includes and the names it defines at
+ * namespace scope, with internal or external linkage. Comparing every
+ * pair of closures doesn't scale to thousands of translation units, so
+ * each closure is summarized by a MinHash signature, whose proportion
+ * of equal values between two signatures estimates the Jaccard
+ * similarity of the closures. The signatures are cut into bands, and
+ * translation units with an equal band land in the same bucket: only
+ * those are compared, which finds the similar ones with high
+ * probability.
+ *
+ * Translation units can be added concurrently.
+ */
+class UnityBuildPlanner {
+public:
+  struct Options {
+    /**
+     * Number of bands of the signatures, and number of values in each.
+     * More bands find less similar translation units, longer bands
+     * compare fewer dissimilar ones.
+     */
+    unsigned numBands = 16;
+    unsigned rowsPerBand = 4;
+
+    /**
+     * Smallest estimated similarity of the closure of a translation
+     * unit with the one that started its group.
+     */
+    double minSimilarity = 0.5;
+
+    /**
+     * Largest number of translation units compared with the one that
+     * starts a group, to bound the time spent on large buckets of near
+     * copies.
+     */
+    size_t maxCandidates = 256;
+
+    /**
+     * Largest number of translation units in a group.
+     */
+    size_t maxTranslationUnits = 8;
+
+    /**
+     * Largest size in bytes of a group, counting every file its
+     * translation units include once, or zero for no limit. A
+     * translation unit larger than that is a group of its own.
+     */
+    uint64_t maxBytes = 0;
+  };
+
+  struct Group {
+    /**
+     * Paths of the main files of the translation units, sorted.
+     */
+    std::vector<std::string> translationUnits;
+
+    /**
+     * Size in bytes of the files of the group.
+     */
+    uint64_t bytes = 0;
+  };
+
+private:
+  typedef uint32_t HeaderID;
+
+  struct TranslationUnit {
+    std::string path;
+    uint64_t bytes = 0;
+
+    /**
+     * Every file the main file includes, directly or not, sorted.
+     */
+    std::vector<HeaderID> headers;
+
+    /**
+     * Names defined with internal linkage by the main file, which would
+     * clash with the same names defined by another one.
+     */
+    std::set<std::string> symbols;
+
+    /**
+     * Names defined with external linkage by the main file, which would
+     * clash with the same names defined with internal linkage by
+     * another one.
+     */
+    std::set<std::string> externalSymbols;
+  };
+
+  mutable std::mutex mutex;
+
+  std::map<std::string, size_t> unitIndex;
+  std::vector<TranslationUnit> units;
+
+  /**
+   * Id of each header by real path, and the size and path hash of each
+   * id.
+   */
+  std::map<std::string, HeaderID> headerIds;
+  std::vector<uint64_t> headerBytes;
+  std::vector<uint64_t> headerHashes;
+
+  /**
+   * Sizes of the files seen so far, by real path.
+   */
+  std::map<std::string, uint64_t> sizes;
+  std::mutex sizesMutex;
+
+  uint64_t sizeOf(const std::string &path);
+
+public:
+  /**
+   * Add a translation unit, usually from the postProcessing of a tool
+   * with the `IncludeGraph` and `Definitions` collectors, given the
+   * source manager of the translation unit. Without definitions, the
+   * translation unit is assumed to define no name that could clash with
+   * another translation unit. A main file added again is merged with
+   * what was added for it before.
+   */
+  void add(const collectors::IncludeGraphData *includeGraph,
+           const collectors::DefinitionsData *definitions,
+           const clang::SourceManager &sm);
+
+  /**
+   * Number of distinct main files added so far.
+   */
+  size_t getNumTranslationUnits() const;
+
+  /**
+   * Group the translation units. Each group starts with the translation
+   * unit including the most files that is not in a group yet, and takes
+   * the most similar ones from its buckets, as long as they fit and
+   * define no internal name the group already defines, internally or
+   * externally, nor an external name the group defines internally. Every
+   * translation unit ends up in exactly one group, possibly alone.
+   */
+  std::vector<Group> plan(const Options &options) const;
+
+  /**
+   * Same as above, with the default options.
+   */
+  std::vector<Group> plan() const;
+
+  /**
+   * Write the groups one per line, as the paths of their main files
+   * separated by spaces.
+   */
+  static void writeGroups(const std::vector<Group> &groups,
+                          llvm::raw_ostream &os);
+
+  /**
+   * Write the source file of the unity build of a group, which includes
+   * every main file of the group.
+   */
+  static void writeUnitySource(const Group &group, llvm::raw_ostream &os);
+};
+
+} // namespace clangmetatool
+
+#endif
+
+// ----------------------------------------------------------------------------
+// Copyright 2026 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
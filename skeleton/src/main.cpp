@@ -1,17 +1,25 @@
 #include <iosfwd>
 #include <map>
+#include <memory>
 #include <tuple>
+#include <vector>
 
 #include <clang/ASTMatchers/ASTMatchFinder.h>
 #include <clang/Frontend/FrontendAction.h>
+#include <clang/Frontend/PCHContainerOperations.h>
 #include <clang/Tooling/CommonOptionsParser.h>
 #include <clang/Tooling/Core/Replacement.h>
 #include <clang/Tooling/Refactoring.h>
 #include <clang/Tooling/Tooling.h>
+#include <llvm/ADT/SmallString.h>
+#include <llvm/Config/llvm-config.h>
 #include <llvm/Support/CommandLine.h>
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/VirtualFileSystem.h>
 
 #include <clangmetatool/meta_tool.h>
 #include <clangmetatool/meta_tool_factory.h>
+#include <clangmetatool/tool_server.h>
 
 class MyTool {
 public:
@@ -32,19 +40,93 @@ public:
       std::map<std::string, clang::tooling::Replacements> &replacementsMap) {}
 };
 
+/**
+ * Answer requests on the given socket until asked to stop. Each request
+ * is processed with the compilation database loaded at startup and the
+ * file caches of the server, and answers with the YAML fixes of the
+ * requested source files.
+ */
+int serve(const std::string &socketPath,
+          const clang::tooling::CompilationDatabase &compilations) {
+  clangmetatool::ToolServer server(socketPath);
+  return server.serve([&](const std::vector<std::string> &sourcePaths,
+                          llvm::raw_ostream &os) {
+    std::map<std::string, clang::tooling::Replacements> replacements;
+    MyTool::ArgTypes toolArgs;
+    clangmetatool::MetaToolFactory<clangmetatool::MetaTool<MyTool>> raf(
+        replacements, toolArgs);
+
+    int r = 0;
+    for (const auto &path : sourcePaths) {
+      auto commands = compilations.getCompileCommands(path);
+      std::string directory =
+          commands.empty() ? "." : commands.front().Directory;
+#if LLVM_VERSION_MAJOR >= 10
+      clang::tooling::ClangTool tool(
+          compilations, {path},
+          std::make_shared<clang::PCHContainerOperations>(),
+          llvm::vfs::getRealFileSystem(), server.getFileManager(directory));
+#else
+      clang::tooling::ClangTool tool(
+          compilations, {path},
+          std::make_shared<clang::PCHContainerOperations>(),
+          server.getFileSystem());
+#endif
+      if (tool.run(&raf) != 0) {
+        r = 1;
+      }
+    }
+    raf.exportFixes(os);
+    return r;
+  });
+}
+
 int main(int argc, const char *argv[]) {
   llvm::cl::OptionCategory MyToolCategory("my-tool options");
 
+  llvm::cl::opt<std::string> ServeSocket(
+      "serve",
+      llvm::cl::desc("Keep running and answer requests sent with --connect "
+                     "on the given Unix socket"),
+      llvm::cl::value_desc("socket"), llvm::cl::cat(MyToolCategory));
+
+  llvm::cl::opt<std::string> ConnectSocket(
+      "connect",
+      llvm::cl::desc("Have the server listening on the given Unix socket "
+                     "process the source files, and print the fixes"),
+      llvm::cl::value_desc("socket"), llvm::cl::cat(MyToolCategory));
+
   llvm::cl::extrahelp CommonHelp(
       clang::tooling::CommonOptionsParser::HelpMessage);
 
   auto parseResult = clang::tooling::CommonOptionsParser::create(
-      argc, argv, MyToolCategory, llvm::cl::OneOrMore);
+      argc, argv, MyToolCategory, llvm::cl::ZeroOrMore);
   if (!parseResult) {
     llvm::errs() << parseResult.takeError();
     return 1;
   }
 
+  if (!ServeSocket.empty()) {
+    return serve(ServeSocket, parseResult->getCompilations());
+  }
+
+  if (parseResult->getSourcePathList().empty()) {
+    llvm::errs() << "No source files given\n";
+    return 1;
+  }
+
+  if (!ConnectSocket.empty()) {
+    // The server doesn't run in our working directory
+    std::vector<std::string> sourcePaths;
+    for (const auto &path : parseResult->getSourcePathList()) {
+      llvm::SmallString<256> absolute(path);
+      llvm::sys::fs::make_absolute(absolute);
+      sourcePaths.push_back(absolute.str().str());
+    }
+    return clangmetatool::ToolServer::request(ConnectSocket, sourcePaths,
+                                              llvm::outs());
+  }
+
   clang::tooling::RefactoringTool tool(parseResult->getCompilations(),
                                        parseResult->getSourcePathList());
 
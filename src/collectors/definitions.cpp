@@ -18,6 +18,10 @@ private:
 public:
   DefinitionsDataAppender(clang::CompilerInstance *ci, DefinitionsData *data)
       : ci(ci), data(data) {}
+  virtual llvm::StringRef getID() const override {
+    return "Definitions::DefinitionsDataAppender";
+  }
+
   virtual void run(const MatchFinder::MatchResult &r) override {
     const clang::NamedDecl *e = r.Nodes.getNodeAs<clang::NamedDecl>("def");
     if (e == nullptr)
@@ -18,6 +18,10 @@ public:
   AnnotateCall1(clang::CompilerInstance *ci, FindCallsData *data)
       : ci(ci), data(data) {}
 
+  virtual llvm::StringRef getID() const override {
+    return "FindCalls::AnnotateCall1";
+  }
+
   virtual void
   run(const clang::ast_matchers::MatchFinder::MatchResult &r) override {
 
@@ -21,6 +21,10 @@ public:
   AnnotateCall1(clang::CompilerInstance *ci, FindCXXMemberCallsData *data)
       : ci(ci), data(data) {}
 
+  virtual llvm::StringRef getID() const override {
+    return "FindCXXMemberCalls::AnnotateCall1";
+  }
+
   virtual void
   run(const clang::ast_matchers::MatchFinder::MatchResult &r) override {
 
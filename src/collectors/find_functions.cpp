@@ -18,6 +18,10 @@ public:
   AnnotateFunction(clang::CompilerInstance *ci, FindFunctionsData *data)
       : ci(ci), data(data) {}
 
+  virtual llvm::StringRef getID() const override {
+    return "FindFunctions::AnnotateFunction";
+  }
+
   virtual void run(const MatchFinder::MatchResult &r) override {
     const clang::FunctionDecl *f =
         r.Nodes.getNodeAs<clang::FunctionDecl>("func");
@@ -23,6 +23,10 @@ public:
   FindDeclMatchCallback(clang::CompilerInstance *ci, IncludeGraphData *d)
       : ci(ci), data(d) {}
 
+  virtual llvm::StringRef getID() const override {
+    return "IncludeGraph::FindDeclMatchCallback";
+  }
+
   virtual void
   run(const clang::ast_matchers::MatchFinder::MatchResult &r) override;
 };
@@ -24,6 +24,10 @@ public:
   FindDeclRefMatchCallback(clang::CompilerInstance *ci, IncludeGraphData *d)
       : ci(ci), data(d) {}
 
+  virtual llvm::StringRef getID() const override {
+    return "IncludeGraph::FindDeclRefMatchCallback";
+  }
+
   virtual void
   run(const clang::ast_matchers::MatchFinder::MatchResult &r) override;
 };
@@ -0,0 +1,41 @@
+#include "find_member_ref_match_callback.h"
+
+#include <clang/AST/Expr.h>
+#include <clang/ASTMatchers/ASTMatchFinder.h>
+#include <clang/Frontend/CompilerInstance.h>
+
+#include <clangmetatool/collectors/include_graph_data.h>
+
+#include "include_graph_util.h"
+
+namespace clangmetatool {
+namespace collectors {
+namespace include_graph {
+
+void FindMemberRefMatchCallback::run(
+    const clang::ast_matchers::MatchFinder::MatchResult &r) {
+  if (const clang::MemberExpr *e =
+          r.Nodes.getNodeAs<clang::MemberExpr>("member")) {
+
+    add_member_reference(ci, data, e);
+  }
+}
+} // namespace include_graph
+} // namespace collectors
+} // namespace clangmetatool
+
+// ----------------------------------------------------------------------------
+// Copyright 2026 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -40,8 +40,10 @@
 #include <clangmetatool/collectors/include_graph_data.h>
 #include <clangmetatool/types/file_uid.h>
 
+#include "find_complete_type_use_match_callback.h"
 #include "find_decl_match_callback.h"
 #include "find_decl_ref_match_callback.h"
+#include "find_member_ref_match_callback.h"
 #include "find_type_match_callback.h"
 #include "include_finder.h"
 
@@ -60,19 +62,53 @@ private:
       clang::ast_matchers::typeLoc(optionally(loc((const internal::Matcher<clang::QualType> &)hasDeclaration(decl().bind("decl"))))).bind("type");
   clang::ast_matchers::DeclarationMatcher sm3 =
       clang::ast_matchers::decl().bind("decl");
+  clang::ast_matchers::StatementMatcher sm4 =
+      clang::ast_matchers::memberExpr().bind("member");
+  // Uses of a class through a pointer that still need its definition
+  clang::ast_matchers::StatementMatcher sm5 =
+      expr(anyOf(cxxDeleteExpr(),
+                 castExpr(anyOf(hasCastKind(clang::CK_DerivedToBase),
+                                hasCastKind(clang::CK_UncheckedDerivedToBase),
+                                hasCastKind(clang::CK_BaseToDerived))),
+                 arraySubscriptExpr(),
+                 binaryOperator(anyOf(hasOperatorName("+"),
+                                      hasOperatorName("-"),
+                                      hasOperatorName("+="),
+                                      hasOperatorName("-=")),
+                                hasEitherOperand(hasType(pointerType()))),
+                 unaryOperator(anyOf(hasOperatorName("++"),
+                                     hasOperatorName("--")),
+                               hasUnaryOperand(hasType(pointerType()))),
+                 implicitCastExpr(hasCastKind(clang::CK_LValueToRValue),
+                                  hasSourceExpression(ignoringParens(
+                                      unaryOperator(hasOperatorName("*"))))),
+                 cxxConstructExpr(
+                     argumentCountIs(1),
+                     hasArgument(0, ignoringParenImpCasts(unaryOperator(
+                                        hasOperatorName("*")))))))
+          .bind("use");
 
   clangmetatool::collectors::include_graph::FindDeclRefMatchCallback cb1;
   clangmetatool::collectors::include_graph::FindTypeMatchCallback cb2;
   clangmetatool::collectors::include_graph::FindDeclMatchCallback cb3;
+  clangmetatool::collectors::include_graph::FindMemberRefMatchCallback cb4;
+  clangmetatool::collectors::include_graph::FindCompleteTypeUseMatchCallback
+      cb5;
 
 public:
   IncludeGraphImpl(clang::CompilerInstance *ci,
-                   clang::ast_matchers::MatchFinder *f)
-      : ci(ci), cb1(ci, &data), cb2(ci, &data), cb3(ci, &data) {
+                   clang::ast_matchers::MatchFinder *f, unsigned details)
+      : ci(ci), cb1(ci, &data), cb2(ci, &data), cb3(ci, &data),
+        cb4(ci, &data), cb5(ci, &data) {
+    data.details = details;
 
     f->addMatcher(sm1, &cb1);
     f->addMatcher(sm2, &cb2);
     f->addMatcher(sm3, &cb3);
+    if (details & IncludeGraphData::ForwardDeclarationDetails) {
+      f->addMatcher(sm4, &cb4);
+      f->addMatcher(sm5, &cb5);
+    }
 
     // preprocessor callbacks
     ci->getPreprocessor().addPPCallbacks(
@@ -87,8 +123,9 @@ public:
 };
 
 IncludeGraph::IncludeGraph(clang::CompilerInstance *ci,
-                           clang::ast_matchers::MatchFinder *f) {
-  impl = new IncludeGraphImpl(ci, f);
+                           clang::ast_matchers::MatchFinder *f,
+                           unsigned details) {
+  impl = new IncludeGraphImpl(ci, f, details);
 }
 
 IncludeGraph::~IncludeGraph() { delete impl; }
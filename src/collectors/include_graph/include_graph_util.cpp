@@ -2,11 +2,19 @@
 #include <algorithm>
 #include <array>
 #include <clang/AST/ASTConsumer.h>
+#include <clang/AST/ASTContext.h>
 #include <clang/AST/Decl.h>
 #include <clang/AST/DeclBase.h>
+#include <clang/AST/DeclCXX.h>
+#include <clang/AST/DeclFriend.h>
+#include <clang/AST/DeclTemplate.h>
 #include <clang/AST/Expr.h>
+#include <clang/AST/ExprCXX.h>
 #include <clang/AST/Type.h>
 #include <clang/AST/TypeLoc.h>
+#if LLVM_VERSION_MAJOR >= 11
+#include <clang/AST/ParentMapContext.h>
+#endif
 #include <clang/ASTMatchers/ASTMatchFinder.h>
 #include <clang/ASTMatchers/ASTMatchers.h>
 #include <clang/ASTMatchers/ASTMatchersInternal.h>
@@ -52,6 +60,16 @@ namespace include_graph {
 using namespace clangmetatool::types;
 using namespace clangmetatool::collectors;
 
+static void add_file_entry(IncludeGraphData *data, FileUID fuid,
+                           const clang::FileEntry *entry) {
+  if (!data->fuid2entry.emplace(fuid, entry).second)
+    return;
+
+  llvm::StringRef path = entry->tryGetRealPathName();
+  if (!path.empty())
+    data->path2fuid.emplace(path.str(), fuid);
+}
+
 static std::pair<FileUID, bool> get_fileuid(clang::CompilerInstance *ci,
                                             IncludeGraphData *data,
                                             clang::FileID fid) {
@@ -69,8 +87,7 @@ static std::pair<FileUID, bool> get_fileuid(clang::CompilerInstance *ci,
   clang::SourceLocation l = sm.translateLineCol(fid, 1, 1);
 
   data->last_include.emplace(FileAttribute<clang::SourceLocation>(fuid, l));
-  data->fuid2entry.emplace(
-      FileAttribute<const clang::FileEntry *>(fuid, entry));
+  add_file_entry(data, fuid, entry);
 
   return std::pair<FileUID, bool>(fuid, true);
 }
@@ -112,9 +129,16 @@ void add_include_statement(clang::CompilerInstance *ci, IncludeGraphData *data,
 #endif
     FileUID fuid = file->getUID();
 
-    data->fuid2entry.emplace(fuid, file);
+    add_file_entry(data, fuid, file);
     data->fuid2name.emplace(fuid, include);
 
+    auto names = data->name2fuid.equal_range(include);
+    if (std::none_of(names.first, names.second,
+                     [fuid](const std::pair<const std::string, FileUID> &p) {
+                       return p.second == fuid;
+                     }))
+      data->name2fuid.emplace(include, fuid);
+
     std::pair<FileUID, bool> tuid = get_fileuid(ci, data, hashLoc);
     if (!tuid.second)
       return;
@@ -129,7 +153,8 @@ void add_include_statement(clang::CompilerInstance *ci, IncludeGraphData *data,
     if (!last_incl_empl.second)
       last_incl_empl.first->second = hashLoc;
 
-    data->include_graph.insert(FileGraphEdge(tuid.first, fuid));
+    if (data->include_graph.insert(FileGraphEdge(tuid.first, fuid)).second)
+      data->included_by[fuid].push_back(tuid.first);
 
     data->include_statements.insert(
         FileGraphEdgeMultimap<clang::SourceRange>::value_type(
@@ -160,22 +185,94 @@ resolve_file_graph_edge(clang::CompilerInstance *ci, IncludeGraphData *data,
 }
 
 template <typename ELEMENT, typename MULTIMAP>
-static void add_usage(clang::CompilerInstance *ci, IncludeGraphData *data,
-                      clang::SourceLocation caller,
-                      clang::SourceLocation callee, ELEMENT &e, MULTIMAP &m) {
+static std::pair<bool, std::pair<FileUID, FileUID>>
+add_usage(clang::CompilerInstance *ci, IncludeGraphData *data,
+          clang::SourceLocation caller, clang::SourceLocation callee,
+          ELEMENT &e, MULTIMAP &m, unsigned detail,
+          bool needs_definition = true) {
 
-  std::tuple<bool, std::pair<FileUID, FileUID>> resolved =
+  std::pair<bool, std::pair<FileUID, FileUID>> resolved =
       resolve_file_graph_edge(ci, data, caller, callee);
 
-  if (!std::get<0>(resolved))
-    return;
+  if (!resolved.first)
+    return resolved;
 
-  auto edge = std::get<1>(resolved);
-  m.insert({edge, e});
+  auto edge = resolved.second;
+  if (data->details & detail)
+    m.insert({edge, e});
   data->use_graph.insert(edge);
+  if (needs_definition &&
+      (data->details & IncludeGraphData::ForwardDeclarationDetails))
+    data->definition_uses.insert(edge);
 
   // Update the usage counts for the edge
   data->usage_reference_count[edge]++;
+  return resolved;
+}
+
+// Whether a forward declaration of the class can stand for its
+// definition: only classes at namespace scope can be declared again
+// outside their definition, and templates are left alone.
+static bool is_forward_declarable(const clang::Decl *decl) {
+  const clang::RecordDecl *record = llvm::dyn_cast<clang::RecordDecl>(decl);
+  if (!record || !record->getDeclContext()->isFileContext())
+    return false;
+
+  const clang::CXXRecordDecl *cxx =
+      llvm::dyn_cast<clang::CXXRecordDecl>(record);
+  return !cxx || (!llvm::isa<clang::ClassTemplateSpecializationDecl>(cxx) &&
+                  !cxx->getDescribedClassTemplate());
+}
+
+// Whether the type named by the type location may be incomplete there.
+// Sugar around the name is looked through, then it has to be the
+// pointee of a pointer or a reference, or a parameter or return type
+// of a function that is declared without a body.
+static bool allows_incomplete_type(clang::ASTContext &context,
+                                   const clang::TypeLoc &n) {
+  clang::TypeLoc current = n;
+  while (true) {
+    auto parents = context.getParents(current);
+    if (parents.size() != 1)
+      return false;
+
+    if (const clang::TypeLoc *parent = parents[0].get<clang::TypeLoc>()) {
+      switch (parent->getTypeLocClass()) {
+      case clang::TypeLoc::Elaborated:
+      case clang::TypeLoc::Paren:
+      case clang::TypeLoc::Qualified:
+        current = *parent;
+        continue;
+      case clang::TypeLoc::LValueReference:
+      case clang::TypeLoc::MemberPointer:
+      case clang::TypeLoc::Pointer:
+      case clang::TypeLoc::RValueReference:
+        return true;
+      case clang::TypeLoc::FunctionProto: {
+        if (parent->castAs<clang::FunctionProtoTypeLoc>().getReturnLoc() !=
+            current)
+          return false;
+        auto grandparents = context.getParents(*parent);
+        const clang::FunctionDecl *function =
+            grandparents.size() == 1
+                ? grandparents[0].get<clang::FunctionDecl>()
+                : nullptr;
+        return function && !function->doesThisDeclarationHaveABody();
+      }
+      default:
+        return false;
+      }
+    }
+
+    if (const clang::ParmVarDecl *parameter =
+            parents[0].get<clang::ParmVarDecl>()) {
+      const clang::FunctionDecl *function =
+          llvm::dyn_cast<clang::FunctionDecl>(parameter->getDeclContext());
+      return function && !function->doesThisDeclarationHaveABody();
+    }
+
+    return parents[0].get<clang::FriendDecl>() != nullptr;
+  }
 }
 
 // Gets a sensible clang::SourceLocation even in the presence of a macro.
@@ -202,7 +299,8 @@ void add_macro_reference(clang::CompilerInstance *ci, IncludeGraphData *data,
       ci->getSourceManager(), std::get<0>(m).getLocation());
   clang::SourceLocation defLoc = info->getDefinitionLoc();
 
-  add_usage(ci, data, usageLoc, defLoc, m, data->macro_references);
+  add_usage(ci, data, usageLoc, defLoc, m, data->macro_references,
+            IncludeGraphData::MacroReferenceDetails);
 }
 
 void add_redeclaration(clang::CompilerInstance *ci, IncludeGraphData *data,
@@ -212,8 +310,15 @@ void add_redeclaration(clang::CompilerInstance *ci, IncludeGraphData *data,
   if (!decl)
     return;
 
+  // A class declared again without its definition is a forward
+  // declaration, which doesn't need the definition either
+  const clang::TagDecl *tag = llvm::dyn_cast<clang::TagDecl>(n);
+  bool needs_definition = !tag || tag->isThisDeclarationADefinition() ||
+                          !is_forward_declarable(n);
+
   add_usage(ci, data, n->getLocation(), decl->getLocation(), n,
-            data->redeclarations);
+            data->redeclarations, IncludeGraphData::RedeclarationDetails,
+            needs_definition);
 }
 
 void add_decl_reference(clang::CompilerInstance *ci, IncludeGraphData *data,
@@ -228,7 +333,8 @@ void add_decl_reference(clang::CompilerInstance *ci, IncludeGraphData *data,
   clang::SourceLocation locUseCanonical =
       get_canonical_location(ci->getSourceManager(), locUse);
 
-  add_usage(ci, data, locUseCanonical, locDef, e, data->decl_references);
+  add_usage(ci, data, locUseCanonical, locDef, e, data->decl_references,
+            IncludeGraphData::DeclReferenceDetails);
 }
 
 template <typename T>
@@ -281,7 +387,74 @@ void add_type_reference(clang::CompilerInstance *ci, IncludeGraphData *data,
 
   clang::SourceLocation locUse =
       get_canonical_location(ci->getSourceManager(), n->getBeginLoc());
-  add_usage(ci, data, locUse, decl->getLocation(), n, data->type_references);
+  // Walking up the parents needs the parent map of the whole AST, only
+  // build it for the tools that ask
+  bool forward_declarable =
+      (data->details & IncludeGraphData::ForwardDeclarationDetails) &&
+      is_forward_declarable(decl) &&
+      allows_incomplete_type(ci->getASTContext(), *n);
+
+  std::pair<bool, std::pair<FileUID, FileUID>> resolved =
+      add_usage(ci, data, locUse, decl->getLocation(), n,
+                data->type_references, IncludeGraphData::TypeReferenceDetails,
+                !forward_declarable);
+
+  if (resolved.first && forward_declarable &&
+      (data->details & IncludeGraphData::TypeReferenceDetails))
+    data->forward_declarable_type_references.insert({resolved.second, n});
+}
+
+void add_member_reference(clang::CompilerInstance *ci, IncludeGraphData *data,
+                          const clang::MemberExpr *e) {
+
+  const clang::ValueDecl *d = e->getMemberDecl();
+  if (!d)
+    return;
+
+  // Member accesses are not counted as references, but they need the
+  // definition of the class
+  std::pair<bool, std::pair<FileUID, FileUID>> resolved =
+      resolve_file_graph_edge(
+          ci, data,
+          get_canonical_location(ci->getSourceManager(), e->getMemberLoc()),
+          d->getLocation());
+  if (resolved.first)
+    data->definition_uses.insert(resolved.second);
+}
+
+void add_complete_type_use(clang::CompilerInstance *ci, IncludeGraphData *data,
+                           const clang::Expr *e) {
+
+  // The class whose size or layout the expression needs: the one being
+  // deleted, converted from, stepped over or copied
+  clang::QualType type = e->getType();
+  if (const clang::CXXDeleteExpr *d = llvm::dyn_cast<clang::CXXDeleteExpr>(e))
+    type = d->getDestroyedType();
+  else if (const clang::CastExpr *c = llvm::dyn_cast<clang::CastExpr>(e)) {
+    if (c->getCastKind() != clang::CK_BaseToDerived)
+      type = c->getSubExpr()->getType();
+  } else if (const clang::BinaryOperator *b =
+                 llvm::dyn_cast<clang::BinaryOperator>(e))
+    type = b->getLHS()->getType()->isPointerType() ? b->getLHS()->getType()
+                                                   : b->getRHS()->getType();
+  else if (const clang::UnaryOperator *u =
+               llvm::dyn_cast<clang::UnaryOperator>(e))
+    type = u->getSubExpr()->getType();
+
+  if (const clang::PointerType *pointer = type->getAs<clang::PointerType>())
+    type = pointer->getPointeeType();
+  const clang::RecordType *record = type->getAs<clang::RecordType>();
+  if (!record)
+    return;
+
+  // Like member accesses, these are not counted as references
+  std::pair<bool, std::pair<FileUID, FileUID>> resolved =
+      resolve_file_graph_edge(
+          ci, data,
+          get_canonical_location(ci->getSourceManager(), e->getExprLoc()),
+          record->getDecl()->getLocation());
+  if (resolved.first)
+    data->definition_uses.insert(resolved.second);
 }
 } // namespace include_graph
 } // namespace collectors
@@ -42,6 +42,12 @@ void add_decl_reference(clang::CompilerInstance *ci, IncludeGraphData *data,
 
 void add_type_reference(clang::CompilerInstance *ci, IncludeGraphData *data,
                         const clang::TypeLoc *n, const clang::Decl* decl);
+
+void add_member_reference(clang::CompilerInstance *ci, IncludeGraphData *data,
+                          const clang::MemberExpr *e);
+
+void add_complete_type_use(clang::CompilerInstance *ci, IncludeGraphData *data,
+                           const clang::Expr *e);
 } // namespace include_graph
 } // namespace collectors
 } // namespace clangmetatool
@@ -15,6 +15,10 @@ public:
                                MemberMethodDeclsData *data)
       : ci(ci), data(data) {}
 
+  virtual llvm::StringRef getID() const override {
+    return "MemberMethodDecls::AnnotateMemberMethodDeclExpr";
+  }
+
   virtual void
   run(const clang::ast_matchers::MatchFinder::MatchResult &r) override {
     const clang::CXXMethodDecl *d =
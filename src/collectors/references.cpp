@@ -19,6 +19,10 @@ private:
 public:
   ReferencesDataAppender(clang::CompilerInstance *ci, ReferencesData *data)
       : ci(ci), data(data) {}
+  virtual llvm::StringRef getID() const override {
+    return "References::ReferencesDataAppender";
+  }
+
   virtual void run(const MatchFinder::MatchResult &r) override {
     const clang::NamedDecl *ref =
         r.Nodes.getNodeAs<clang::NamedDecl>("reference");
@@ -17,6 +17,10 @@ public:
   AnnotateVarDeclRefExpr(clang::CompilerInstance *ci, VariableRefsData *data)
       : ci(ci), data(data) {}
 
+  virtual llvm::StringRef getID() const override {
+    return "VariableRefs::AnnotateVarDeclRefExpr";
+  }
+
   virtual void
   run(const clang::ast_matchers::MatchFinder::MatchResult &r) override {
 
@@ -44,6 +48,10 @@ public:
                                VariableRefsData *data)
       : ci(ci), data(data) {}
 
+  virtual llvm::StringRef getID() const override {
+    return "VariableRefs::AnnotateRValueVarDeclRefExpr";
+  }
+
   virtual void
   run(const clang::ast_matchers::MatchFinder::MatchResult &r) override {
 
@@ -75,6 +83,10 @@ public:
                                    VariableRefsData *data)
       : ci(ci), data(data) {}
 
+  virtual llvm::StringRef getID() const override {
+    return "VariableRefs::AnnotateAssignmentVarDeclRefExpr";
+  }
+
   virtual void
   run(const clang::ast_matchers::MatchFinder::MatchResult &r) override {
 
@@ -0,0 +1,228 @@
+#include <clangmetatool/forward_declaration_finder.h>
+
+#include <llvm/Support/Format.h>
+
+#include <clangmetatool/include_graph_csr.h>
+#include <clangmetatool/include_graph_dependencies.h>
+#include <clangmetatool/include_graph_reachability.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cinttypes>
+
+namespace clangmetatool {
+
+namespace {
+
+typedef IncludeGraphCSR::Index Index;
+
+} // namespace
+
+ForwardDeclarationFinder::ForwardDeclarationFinder(
+    const collectors::IncludeGraphData *data)
+    : ForwardDeclarationFinder(data, HeaderCostReport(data)) {}
+
+ForwardDeclarationFinder::ForwardDeclarationFinder(
+    const collectors::IncludeGraphData *data, const HeaderCostReport &costs)
+    : paths(IncludeGraphDependencies::filePaths(data)) {
+  // Without definition uses, every use would look forward declarable
+  assert((data->details &
+          collectors::IncludeGraphData::ForwardDeclarationDetails) &&
+         "ForwardDeclarationFinder needs ForwardDeclarationDetails");
+  if (!(data->details &
+        collectors::IncludeGraphData::ForwardDeclarationDetails)) {
+    return;
+  }
+
+  IncludeGraphCSR csr(data);
+  IncludeGraphReachability reachability(&csr);
+  const IncludeGraphCSR::Graph &includes = csr.getIncludeGraph();
+  const IncludeGraphCSR::Graph &usages = csr.getUsageGraph();
+  size_t numNodes = csr.numNodes();
+
+  std::vector<bool> isSystem(numNodes, false);
+  std::vector<std::vector<Index>> includedBy(numNodes);
+  for (Index node = 0; node < numNodes; ++node) {
+    auto system = data->is_system.find(csr.getUID(node));
+    isSystem[node] = system != data->is_system.end() && system->second;
+    for (Index successor : includes.successors(node)) {
+      includedBy[successor].push_back(node);
+    }
+  }
+
+  // Member accesses need a definition without being references, so
+  // the files used by each file are its usages and its definition uses
+  std::vector<std::vector<Index>> used(numNodes);
+  for (Index node = 0; node < numNodes; ++node) {
+    auto successors = usages.successors(node);
+    used[node].assign(successors.begin(), successors.end());
+  }
+  for (const auto &edge : data->definition_uses) {
+    Index from, to;
+    if (csr.findIndex(edge.first, from) && csr.findIndex(edge.second, to) &&
+        std::find(used[from].begin(), used[from].end(), to) ==
+            used[from].end()) {
+      used[from].push_back(to);
+    }
+  }
+
+  auto needsDefinition = [&](Index from, Index to) {
+    return data->definition_uses.count(
+        types::FileGraphEdge(csr.getUID(from), csr.getUID(to)));
+  };
+
+  std::map<types::FileGraphEdge, const HeaderCostReport::IncludeCost *>
+      savings;
+  for (const auto &include : costs.getIncludes()) {
+    savings[include.edge] = &include;
+  }
+
+  // The files including the includer, directly or not, are the same for
+  // all its candidates, so they are only found once per includer. Each
+  // node remembers the includer it was last found for, so nothing needs
+  // to be cleared in between.
+  std::vector<Index> foundFor(numNodes, numNodes);
+  std::vector<Index> ancestors;
+  auto findAncestors = [&](Index from) {
+    ancestors.assign(includedBy[from].begin(), includedBy[from].end());
+    for (Index above : ancestors) {
+      foundFor[above] = from;
+    }
+    for (size_t i = 0; i < ancestors.size(); ++i) {
+      for (Index next : includedBy[ancestors[i]]) {
+        if (foundFor[next] != from) {
+          foundFor[next] = from;
+          ancestors.push_back(next);
+        }
+      }
+    }
+  };
+
+  for (Index from = 0; from < numNodes; ++from) {
+    if (isSystem[from]) {
+      continue;
+    }
+    bool ancestorsFound = false;
+    auto direct = includes.successors(from);
+    for (Index to : direct) {
+      if (isSystem[to] || reachability.getComponent(to) ==
+                              reachability.getComponent(from)) {
+        continue;
+      }
+
+      // The files the includer would stop reaching without the include
+      auto lost = [&](Index file) {
+        if (file == from || !reachability.isNodeReachable(to, file)) {
+          return false;
+        }
+        for (Index other : direct) {
+          if (other != to && reachability.isNodeReachable(other, file)) {
+            return false;
+          }
+        }
+        return true;
+      };
+
+      Candidate candidate;
+      bool declarable = true;
+      for (Index file : used[from]) {
+        if (!lost(file)) {
+          continue;
+        }
+        if (isSystem[file] || needsDefinition(from, file)) {
+          declarable = false;
+          break;
+        }
+        candidate.declared.push_back(csr.getUID(file));
+      }
+      if (!declarable || candidate.declared.empty()) {
+        continue;
+      }
+
+      // A file above the includer loses a file it uses unless one of
+      // its own includes that doesn't lead to the includer reaches it.
+      if (!ancestorsFound) {
+        findAncestors(from);
+        ancestorsFound = true;
+      }
+      for (Index above : ancestors) {
+        for (Index file : used[above]) {
+          if (!lost(file)) {
+            continue;
+          }
+          bool reached = false;
+          for (Index other : includes.successors(above)) {
+            if (!reachability.isNodeReachable(other, from) &&
+                reachability.isNodeReachable(other, file)) {
+              reached = true;
+              break;
+            }
+          }
+          if (!reached) {
+            candidate.dependents.push_back(csr.getUID(above));
+            break;
+          }
+        }
+      }
+
+      candidate.edge =
+          types::FileGraphEdge(csr.getUID(from), csr.getUID(to));
+      candidate.includer = paths[candidate.edge.first];
+      candidate.included = paths[candidate.edge.second];
+      std::sort(candidate.declared.begin(), candidate.declared.end());
+      std::sort(candidate.dependents.begin(), candidate.dependents.end());
+      auto saved = savings.find(candidate.edge);
+      if (saved != savings.end()) {
+        candidate.saved = saved->second->removed;
+        candidate.translationUnits = saved->second->translationUnits;
+      }
+      candidates.push_back(candidate);
+    }
+  }
+
+  std::stable_sort(candidates.begin(), candidates.end(),
+                   [](const Candidate &a, const Candidate &b) {
+                     return a.saved.bytes > b.saved.bytes;
+                   });
+}
+
+void ForwardDeclarationFinder::printReport(llvm::raw_ostream &os,
+                                           size_t limit) const {
+  auto pathOf = [this](types::FileUID uid) -> std::string {
+    auto it = paths.find(uid);
+    return it == paths.end() ? std::string("<unknown>") : it->second;
+  };
+
+  os << "Includes that forward declarations could replace, in bytes "
+        "removed from the whole build without them:\n";
+  for (size_t i = 0; i < candidates.size() && i < limit; ++i) {
+    const Candidate &candidate = candidates[i];
+    os << llvm::format("%14" PRIu64 " in %6zu  ", candidate.saved.bytes,
+                       candidate.translationUnits)
+       << candidate.includer << " -> " << candidate.included << "\n";
+    for (types::FileUID uid : candidate.declared) {
+      os << "    declare the classes of " << pathOf(uid) << "\n";
+    }
+    for (types::FileUID uid : candidate.dependents) {
+      os << "    then include what it uses in " << pathOf(uid) << "\n";
+    }
+  }
+}
+
+} // namespace clangmetatool
+
+// ----------------------------------------------------------------------------
+// Copyright 2026 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
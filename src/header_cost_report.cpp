@@ -0,0 +1,331 @@
+#include <clangmetatool/header_cost_report.h>
+
+#include <clang/Basic/LangOptions.h>
+#include <clang/Basic/SourceLocation.h>
+#include <clang/Basic/TokenKinds.h>
+#include <clang/Lex/Lexer.h>
+#include <clang/Lex/Token.h>
+#include <llvm/Support/Format.h>
+#include <llvm/Support/MemoryBuffer.h>
+
+#include <clangmetatool/include_graph_csr.h>
+#include <clangmetatool/include_graph_dependencies.h>
+#include <clangmetatool/include_graph_reachability.h>
+
+#include <algorithm>
+#include <cinttypes>
+
+namespace clangmetatool {
+
+namespace {
+
+typedef IncludeGraphCSR::Index Index;
+
+void add(HeaderCostReport::Size &to, const HeaderCostReport::Size &size,
+         uint64_t times = 1) {
+  to.bytes += size.bytes * times;
+  to.tokens += size.tokens * times;
+}
+
+std::map<types::FileUID, HeaderCostReport::Size>
+measureAll(const std::map<types::FileUID, std::string> &paths) {
+  std::map<types::FileUID, HeaderCostReport::Size> sizes;
+  for (const auto &p : paths) {
+    sizes[p.first] = HeaderCostReport::measure(p.second);
+  }
+  return sizes;
+}
+
+/**
+ * Adds to removed[e], for every include edge e reachable from the
+ * root, the size of the files the root only reaches through e, and
+ * counts the edges with anything to remove in translationUnits.
+ *
+ * Those are the files the edge dominates. Every edge gets a node of its
+ * own between the two files it connects, the dominators of the
+ * resulting graph are found with the iterative algorithm of Cooper,
+ * Harvey and Kennedy, and the sizes are summed up the dominator tree.
+ */
+void addRemovedSizes(const IncludeGraphCSR::Graph &graph, Index root,
+                     const std::vector<HeaderCostReport::Size> &sizes,
+                     std::vector<HeaderCostReport::Size> &removed,
+                     std::vector<size_t> &translationUnits) {
+  // Local nodes: the reachable files, then one node per edge leaving
+  // them. edgeOf[n] is the global edge index of edge node n.
+  std::vector<Index> files(1, root);
+  std::map<Index, uint32_t> localOf = {{root, 0}};
+  for (size_t i = 0; i < files.size(); ++i) {
+    for (Index successor : graph.successors(files[i])) {
+      if (localOf.emplace(successor, files.size()).second) {
+        files.push_back(successor);
+      }
+    }
+  }
+  size_t numFiles = files.size();
+
+  std::vector<std::vector<uint32_t>> successors(numFiles);
+  std::vector<Index> edgeOf;
+  for (size_t i = 0; i < numFiles; ++i) {
+    Index from = files[i];
+    for (Index k = graph.offsets[from]; k < graph.offsets[from + 1]; ++k) {
+      uint32_t edgeNode = static_cast<uint32_t>(numFiles + edgeOf.size());
+      edgeOf.push_back(k);
+      successors[i].push_back(edgeNode);
+      successors.push_back({localOf[graph.targets[k]]});
+    }
+  }
+  size_t numNodes = successors.size();
+
+  // Reverse postorder of a depth first search from the root
+  std::vector<uint32_t> order;
+  std::vector<uint32_t> rpoIndex(numNodes, 0);
+  {
+    std::vector<bool> visited(numNodes, false);
+    std::vector<std::pair<uint32_t, size_t>> stack = {{0, 0}};
+    visited[0] = true;
+    while (!stack.empty()) {
+      auto &top = stack.back();
+      if (top.second < successors[top.first].size()) {
+        uint32_t next = successors[top.first][top.second++];
+        if (!visited[next]) {
+          visited[next] = true;
+          stack.push_back({next, 0});
+        }
+      } else {
+        order.push_back(top.first);
+        stack.pop_back();
+      }
+    }
+    std::reverse(order.begin(), order.end());
+    for (size_t i = 0; i < order.size(); ++i) {
+      rpoIndex[order[i]] = static_cast<uint32_t>(i);
+    }
+  }
+
+  std::vector<std::vector<uint32_t>> predecessors(numNodes);
+  for (uint32_t node = 0; node < numNodes; ++node) {
+    for (uint32_t successor : successors[node]) {
+      predecessors[successor].push_back(node);
+    }
+  }
+
+  const uint32_t undefined = static_cast<uint32_t>(-1);
+  std::vector<uint32_t> idom(numNodes, undefined);
+  idom[0] = 0;
+  auto intersect = [&](uint32_t a, uint32_t b) {
+    while (a != b) {
+      while (rpoIndex[a] > rpoIndex[b]) {
+        a = idom[a];
+      }
+      while (rpoIndex[b] > rpoIndex[a]) {
+        b = idom[b];
+      }
+    }
+    return a;
+  };
+  for (bool changed = true; changed;) {
+    changed = false;
+    for (size_t i = 1; i < order.size(); ++i) {
+      uint32_t node = order[i];
+      uint32_t newIdom = undefined;
+      for (uint32_t predecessor : predecessors[node]) {
+        if (idom[predecessor] == undefined) {
+          continue;
+        }
+        newIdom = newIdom == undefined ? predecessor
+                                       : intersect(predecessor, newIdom);
+      }
+      if (idom[node] != newIdom) {
+        idom[node] = newIdom;
+        changed = true;
+      }
+    }
+  }
+
+  // Children come after their immediate dominator in reverse postorder
+  std::vector<HeaderCostReport::Size> dominated(numNodes);
+  for (size_t i = 0; i < numFiles; ++i) {
+    dominated[i] = sizes[files[i]];
+  }
+  for (size_t i = order.size() - 1; i > 0; --i) {
+    uint32_t node = order[i];
+    add(dominated[idom[node]], dominated[node]);
+  }
+  for (size_t i = 0; i < edgeOf.size(); ++i) {
+    const HeaderCostReport::Size &size = dominated[numFiles + i];
+    if (size.bytes > 0 || size.tokens > 0) {
+      add(removed[edgeOf[i]], size);
+      ++translationUnits[edgeOf[i]];
+    }
+  }
+}
+
+} // namespace
+
+HeaderCostReport::HeaderCostReport(const collectors::IncludeGraphData *data)
+    : HeaderCostReport(
+          data, measureAll(IncludeGraphDependencies::filePaths(data))) {}
+
+HeaderCostReport::HeaderCostReport(
+    const collectors::IncludeGraphData *data,
+    const std::map<types::FileUID, Size> &fileSizes)
+    : paths(IncludeGraphDependencies::filePaths(data)) {
+  IncludeGraphCSR csr(data);
+  IncludeGraphReachability reachability(&csr);
+  const IncludeGraphCSR::Graph &graph = csr.getIncludeGraph();
+  size_t numNodes = csr.numNodes();
+
+  std::vector<Size> sizes(numNodes);
+  std::vector<Size> componentSizes(reachability.numComponents());
+  std::vector<bool> included(numNodes, false);
+  for (Index node = 0; node < numNodes; ++node) {
+    auto size = fileSizes.find(csr.getUID(node));
+    if (size != fileSizes.end()) {
+      sizes[node] = size->second;
+    }
+    add(componentSizes[reachability.getComponent(node)], sizes[node]);
+    for (Index successor : graph.successors(node)) {
+      included[successor] = true;
+    }
+  }
+
+  // The closure of a file is the one of its component
+  std::vector<Size> componentClosures(reachability.numComponents());
+  std::vector<bool> componentDone(reachability.numComponents(), false);
+  std::vector<Size> closures(numNodes);
+  for (Index node = 0; node < numNodes; ++node) {
+    Index component = reachability.getComponent(node);
+    if (!componentDone[component]) {
+      componentDone[component] = true;
+      for (types::FileUID uid : reachability.getReachable(csr.getUID(node))) {
+        Index reached;
+        if (csr.findIndex(uid, reached)) {
+          add(componentClosures[component], sizes[reached]);
+        }
+      }
+    }
+    closures[node] = componentClosures[component];
+  }
+
+  std::vector<size_t> translationUnits(numNodes);
+  std::vector<Size> removed(graph.numEdges());
+  std::vector<size_t> removedTranslationUnits(graph.numEdges());
+  for (Index root = 0; root < numNodes; ++root) {
+    if (included[root]) {
+      continue;
+    }
+    ++numTranslationUnits;
+    for (types::FileUID uid : reachability.getReachable(csr.getUID(root))) {
+      Index reached;
+      if (csr.findIndex(uid, reached)) {
+        ++translationUnits[reached];
+      }
+    }
+    addRemovedSizes(graph, root, sizes, removed, removedTranslationUnits);
+  }
+
+  for (Index node = 0; node < numNodes; ++node) {
+    if (!included[node]) {
+      continue;
+    }
+    HeaderCost header;
+    header.uid = csr.getUID(node);
+    header.path = paths[header.uid];
+    header.own = sizes[node];
+    header.closure = closures[node];
+    header.translationUnits = translationUnits[node];
+    add(header.build, header.closure, header.translationUnits);
+    headers.push_back(header);
+  }
+  std::stable_sort(headers.begin(), headers.end(),
+                   [](const HeaderCost &a, const HeaderCost &b) {
+                     return a.build.bytes > b.build.bytes;
+                   });
+
+  for (Index from = 0; from < numNodes; ++from) {
+    for (Index k = graph.offsets[from]; k < graph.offsets[from + 1]; ++k) {
+      IncludeCost include;
+      include.edge = types::FileGraphEdge(csr.getUID(from),
+                                          csr.getUID(graph.targets[k]));
+      include.removed = removed[k];
+      include.translationUnits = removedTranslationUnits[k];
+      includes.push_back(include);
+    }
+  }
+  std::stable_sort(includes.begin(), includes.end(),
+                   [](const IncludeCost &a, const IncludeCost &b) {
+                     return a.removed.bytes > b.removed.bytes;
+                   });
+}
+
+HeaderCostReport::Size HeaderCostReport::measure(const std::string &path) {
+  Size size;
+  auto buffer = llvm::MemoryBuffer::getFile(path);
+  if (!buffer) {
+    return size;
+  }
+  llvm::StringRef text = (*buffer)->getBuffer();
+  size.bytes = text.size();
+
+  clang::LangOptions langOptions;
+  langOptions.CPlusPlus = true;
+  clang::Lexer lexer(clang::SourceLocation(), langOptions, text.begin(),
+                     text.begin(), text.end());
+  clang::Token token;
+  for (;;) {
+    lexer.LexFromRawLexer(token);
+    if (token.is(clang::tok::eof)) {
+      break;
+    }
+    ++size.tokens;
+  }
+  return size;
+}
+
+void HeaderCostReport::printReport(llvm::raw_ostream &os,
+                                   size_t limit) const {
+  auto pathOf = [this](types::FileUID uid) -> std::string {
+    auto it = paths.find(uid);
+    return it == paths.end() ? std::string("<unknown>") : it->second;
+  };
+
+  os << "Header cost over " << numTranslationUnits
+     << " translation units, in bytes preprocessed by the whole build:\n";
+  for (size_t i = 0; i < headers.size() && i < limit; ++i) {
+    const HeaderCost &header = headers[i];
+    os << llvm::format("%14" PRIu64 " %12" PRIu64 " x %6zu  ",
+                       header.build.bytes, header.closure.bytes,
+                       header.translationUnits)
+       << header.path << "\n";
+  }
+
+  os << "Include cost, in bytes removed from the whole build without it:\n";
+  for (size_t i = 0; i < includes.size() && i < limit; ++i) {
+    const IncludeCost &include = includes[i];
+    if (include.removed.bytes == 0) {
+      break;
+    }
+    os << llvm::format("%14" PRIu64 " in %6zu  ", include.removed.bytes,
+                       include.translationUnits)
+       << pathOf(include.edge.first) << " -> " << pathOf(include.edge.second)
+       << "\n";
+  }
+}
+
+} // namespace clangmetatool
+
+// ----------------------------------------------------------------------------
+// Copyright 2026 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
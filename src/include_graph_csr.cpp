@@ -0,0 +1,120 @@
+#include <clangmetatool/include_graph_csr.h>
+
+#include <algorithm>
+
+namespace clangmetatool {
+
+namespace {
+
+/**
+ * Build the rows of a graph from its edges. forEachEdge calls its
+ * argument on every edge, sorted by source uid, then target uid, so the
+ * successors of each node keep their original order.
+ */
+template <class ForEachEdge>
+IncludeGraphCSR::Graph
+buildGraph(const IncludeGraphCSR &csr,
+           std::vector<std::vector<IncludeGraphCSR::Index>> &arrays,
+           ForEachEdge forEachEdge) {
+  std::vector<IncludeGraphCSR::Index> offsets(csr.numNodes() + 1, 0);
+  forEachEdge([&](const types::FileGraphEdge &edge) {
+    IncludeGraphCSR::Index from;
+    if (csr.findIndex(edge.first, from)) {
+      ++offsets[from + 1];
+    }
+  });
+  for (size_t i = 1; i < offsets.size(); ++i) {
+    offsets[i] += offsets[i - 1];
+  }
+
+  std::vector<IncludeGraphCSR::Index> targets(offsets.back());
+  std::vector<IncludeGraphCSR::Index> next(offsets.begin(), offsets.end() - 1);
+  forEachEdge([&](const types::FileGraphEdge &edge) {
+    IncludeGraphCSR::Index from, to;
+    if (csr.findIndex(edge.first, from) && csr.findIndex(edge.second, to)) {
+      targets[next[from]++] = to;
+    }
+  });
+
+  // Moving the vectors into the list keeps their buffers where they are
+  arrays.push_back(std::move(offsets));
+  arrays.push_back(std::move(targets));
+  IncludeGraphCSR::Graph graph;
+  graph.offsets = arrays[arrays.size() - 2];
+  graph.targets = arrays[arrays.size() - 1];
+  return graph;
+}
+
+} // namespace
+
+IncludeGraphCSR::IncludeGraphCSR(const collectors::IncludeGraphData *data) {
+  for (const auto &p : data->fuid2name) {
+    ownedUIDs.push_back(p.first);
+  }
+  for (const types::FileGraph *graph :
+       {&data->include_graph, &data->use_graph}) {
+    for (const auto &edge : *graph) {
+      ownedUIDs.push_back(edge.first);
+      ownedUIDs.push_back(edge.second);
+    }
+  }
+  for (const auto &p : data->usage_reference_count) {
+    ownedUIDs.push_back(p.first.first);
+    ownedUIDs.push_back(p.first.second);
+  }
+  std::sort(ownedUIDs.begin(), ownedUIDs.end());
+  ownedUIDs.erase(std::unique(ownedUIDs.begin(), ownedUIDs.end()),
+                  ownedUIDs.end());
+  uids = ownedUIDs;
+
+  includeGraph = buildGraph(*this, ownedArrays, [data](auto f) {
+    for (const auto &edge : data->include_graph) {
+      f(edge);
+    }
+  });
+  useGraph = buildGraph(*this, ownedArrays, [data](auto f) {
+    for (const auto &edge : data->use_graph) {
+      f(edge);
+    }
+  });
+  usageGraph = buildGraph(*this, ownedArrays, [data](auto f) {
+    for (const auto &p : data->usage_reference_count) {
+      if (p.second > 0) {
+        f(p.first);
+      }
+    }
+  });
+}
+
+IncludeGraphCSR::IncludeGraphCSR(llvm::ArrayRef<types::FileUID> uids,
+                                 Graph includeGraph, Graph useGraph,
+                                 Graph usageGraph)
+    : uids(uids), includeGraph(includeGraph), useGraph(useGraph),
+      usageGraph(usageGraph) {}
+
+bool IncludeGraphCSR::findIndex(types::FileUID uid, Index &index) const {
+  auto it = std::lower_bound(uids.begin(), uids.end(), uid);
+  if (it == uids.end() || *it != uid) {
+    return false;
+  }
+  index = static_cast<Index>(it - uids.begin());
+  return true;
+}
+
+} // namespace clangmetatool
+
+// ----------------------------------------------------------------------------
+// Copyright 2026 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -1,6 +1,14 @@
 #include <clangmetatool/include_graph_dependencies.h>
 
+#include <llvm/ADT/ArrayRef.h>
+#include <llvm/ADT/BitVector.h>
+
+#include <cstdint>
+#include <limits>
+#include <map>
 #include <queue>
+#include <string>
+#include <vector>
 
 namespace clangmetatool {
 
@@ -76,6 +84,113 @@ bool isRequired(const collectors::IncludeGraphData *data,
 
   return keepEdge;
 }
+
+// The same as isRequired, on the dense indices of a frozen view. 'used'
+// flags the files 'from' references a name of, 'knownUsages' the ones
+// already seen by the traversal, which are the edges {from, file} of
+// knownEdges.
+bool isRequired(const IncludeGraphCSR::Graph &includes,
+                IncludeGraphCSR::Index to, const std::vector<char> &used,
+                std::vector<char> &knownUsages, std::vector<char> &knownNodes,
+                std::vector<IncludeGraphCSR::Index> &queue) {
+  bool keepEdge = false;
+
+  queue.clear();
+  queue.push_back(to);
+
+  for (size_t head = 0; head < queue.size(); ++head) {
+    auto current = queue[head];
+
+    if (used[current] && !knownUsages[current]) {
+      knownUsages[current] = 1;
+      keepEdge = true;
+    }
+
+    for (auto next : includes.successors(current)) {
+      if (!knownNodes[next]) {
+        knownNodes[next] = 1;
+        queue.push_back(next);
+      }
+    }
+  }
+
+  return keepEdge;
+}
+
+// Flag the files 'from' references a name of.
+std::vector<char> usedBy(const IncludeGraphCSR *graph,
+                         IncludeGraphCSR::Index from) {
+  std::vector<char> used(graph->numNodes(), 0);
+  for (auto to : graph->getUsageGraph().successors(from)) {
+    used[to] = 1;
+  }
+  return used;
+}
+
+// Label every node reachable from the roots, the roots included, with
+// the set of roots it is reachable from, as bits in the order of the
+// roots. This is a single propagation from all the roots at once: a
+// node is only visited again when it receives new bits, instead of once
+// per root that reaches it. Nodes no root reaches have an empty label.
+template <class Successors>
+std::vector<llvm::BitVector> reachingRoots(size_t numNodes,
+                                           llvm::ArrayRef<uint32_t> roots,
+                                           Successors successors) {
+  std::vector<llvm::BitVector> labels(numNodes);
+  std::vector<char> queued(numNodes, 0);
+  std::queue<uint32_t> queue;
+
+  for (size_t i = 0; i < roots.size(); ++i) {
+    llvm::BitVector &label = labels[roots[i]];
+    label.resize(roots.size());
+    label.set(i);
+    if (!queued[roots[i]]) {
+      queued[roots[i]] = 1;
+      queue.push(roots[i]);
+    }
+  }
+
+  while (!queue.empty()) {
+    auto node = queue.front();
+    queue.pop();
+    queued[node] = 0;
+    for (auto successor : successors(node)) {
+      llvm::BitVector &label = labels[successor];
+      if (label.empty()) {
+        label.resize(roots.size());
+      }
+      if (labels[node].test(label)) {
+        label |= labels[node];
+        if (!queued[successor]) {
+          queued[successor] = 1;
+          queue.push(successor);
+        }
+      }
+    }
+  }
+
+  return labels;
+}
+
+// The first direct include of 'node' through which each file it
+// references a name of can be reached: the same includes isRequired
+// keeps when called on every direct include in order.
+std::set<types::FileUID>
+liveDependenciesOf(const IncludeGraphReachability *index,
+                   IncludeGraphCSR::Index node) {
+  const IncludeGraphCSR *graph = index->getGraph();
+  auto includes = graph->getIncludeGraph().successors(node);
+  std::set<types::FileUID> dependencies;
+  for (auto used : graph->getUsageGraph().successors(node)) {
+    for (auto dependency : includes) {
+      if (index->isNodeReachable(dependency, used)) {
+        dependencies.insert(graph->getUID(dependency));
+        break;
+      }
+    }
+  }
+  return dependencies;
+}
 } // namespace
 
 bool IncludeGraphDependencies::decrementUsageRefCount(
@@ -136,71 +251,243 @@ std::set<types::FileUID> IncludeGraphDependencies::liveDependencies(
   return dependencies;
 }
 
-/*
- * Traverse the include graph for `forNode` start from `rootNode` to all
- * accessible node using BFS and update given DirectDependenciesMap.
- *
- * For any node that `usage_reference_count[{rootNode, toNode}] > 0`, add a
- * record
- * `{toNode: [rootNode]}` to depsMap, means that `forNode` needs to access
- * resource defined in `toNode` through `rootNode`
- *
- * Include graph should looks like:
- * forNode -> rootNode ... -> toNode
- */
-void traverseFor(const types::FileUID &forNode, const types::FileUID &rootNode,
-                 const clangmetatool::collectors::IncludeGraphData *data,
-                 std::set<types::FileUID> &knownNodes,
-                 IncludeGraphDependencies::DirectDependenciesMap &depsMap) {
-  std::queue<types::FileUID> filesToProcess;
+IncludeGraphDependencies::DirectDependenciesMap
+IncludeGraphDependencies::liveWeakDependencies(
+    const clangmetatool::collectors::IncludeGraphData *data,
+    const clangmetatool::types::FileUID &fileUID) {
+  IncludeGraphDependencies::DirectDependenciesMap depsMap;
 
-  filesToProcess.push(rootNode);
+  // Give the files reachable from the direct includes a dense index, in
+  // the order they are found, so the direct includes come first
+  std::map<types::FileUID, uint32_t> index;
+  std::vector<types::FileUID> files;
+  std::vector<std::vector<uint32_t>> successors;
+  auto indexOf = [&](types::FileUID file) {
+    auto inserted = index.emplace(file, files.size());
+    if (inserted.second) {
+      files.push_back(file);
+      successors.emplace_back();
+    }
+    return inserted.first->second;
+  };
 
-  while (!filesToProcess.empty()) {
-    auto toNode = filesToProcess.front();
-    filesToProcess.pop();
+  types::FileGraph::const_iterator rangeBegin, rangeEnd;
+  std::tie(rangeBegin, rangeEnd) = edgeRangeStartsWith(data, fileUID);
 
-    types::FileGraphEdge currentEdge{forNode, toNode};
-    auto refCountIt = data->usage_reference_count.find(currentEdge);
-    // the include graph looks like
-    // forNode -> rootNode -> ... -> toNode
-    if (refCountIt != data->usage_reference_count.end() &&
-        refCountIt->second > 0) {
-      depsMap[toNode].emplace(rootNode);
+  std::vector<uint32_t> roots;
+  for (auto it = rangeBegin; it != rangeEnd; ++it) {
+    assert(it->first == fileUID);
+    roots.push_back(indexOf(it->second));
+  }
+  for (size_t node = 0; node < files.size(); ++node) {
+    std::tie(rangeBegin, rangeEnd) = edgeRangeStartsWith(data, files[node]);
+    for (auto it = rangeBegin; it != rangeEnd; ++it) {
+      // Indexing a new file grows successors
+      uint32_t successor = indexOf(it->second);
+      successors[node].push_back(successor);
     }
+  }
 
-    // Find the set of files included by the current file uid
-    // and set those up for traversal if we haven't seen them already
-    types::FileGraph::const_iterator rangeBegin, rangeEnd;
-    std::tie(rangeBegin, rangeEnd) = edgeRangeStartsWith(data, toNode);
+  std::vector<llvm::BitVector> labels = reachingRoots(
+      files.size(), roots,
+      [&](uint32_t node) -> const std::vector<uint32_t> & {
+        return successors[node];
+      });
 
-    for (auto edgeIt = rangeBegin; edgeIt != rangeEnd; ++edgeIt) {
-      types::FileUID nextNode;
-      std::tie(std::ignore, nextNode) = *edgeIt;
-      if (knownNodes.find(nextNode) == knownNodes.end()) {
-        filesToProcess.push(nextNode);
-        knownNodes.insert(nextNode);
+  // The files this file references a name of
+  constexpr auto MIN_FUID = std::numeric_limits<types::FileUID>::min();
+  constexpr auto MAX_FUID = std::numeric_limits<types::FileUID>::max();
+  auto usedBegin =
+      data->usage_reference_count.lower_bound({fileUID, MIN_FUID});
+  auto usedEnd = data->usage_reference_count.upper_bound({fileUID, MAX_FUID});
+  for (auto it = usedBegin; it != usedEnd; ++it) {
+    auto node = index.find(it->first.second);
+    if (it->second == 0 || node == index.end()) {
+      continue;
+    }
+    for (unsigned root : labels[node->second].set_bits()) {
+      depsMap[it->first.second].emplace(files[roots[root]]);
+    }
+  }
+
+  return depsMap;
+}
+
+std::set<types::FileUID> IncludeGraphDependencies::collectAllIncludes(
+    const IncludeGraphCSR *graph, const types::FileUID &fileUID) {
+  IncludeGraphCSR::Index start;
+  if (!graph->findIndex(fileUID, start)) {
+    return {fileUID};
+  }
+
+  const IncludeGraphCSR::Graph &includes = graph->getIncludeGraph();
+  std::vector<char> visited(graph->numNodes(), 0);
+  std::vector<IncludeGraphCSR::Index> queue{start};
+  visited[start] = 1;
+  for (size_t head = 0; head < queue.size(); ++head) {
+    for (auto next : includes.successors(queue[head])) {
+      if (!visited[next]) {
+        visited[next] = 1;
+        queue.push_back(next);
       }
     }
   }
+
+  std::set<types::FileUID> visitedNodes;
+  for (auto node : queue) {
+    visitedNodes.insert(graph->getUID(node));
+  }
+  return visitedNodes;
+}
+
+std::set<types::FileUID> IncludeGraphDependencies::collectAllIncludes(
+    const IncludeGraphReachability *index, const types::FileUID &fileUID) {
+  return index->getReachable(fileUID);
+}
+
+std::set<types::FileUID>
+IncludeGraphDependencies::liveDependencies(const IncludeGraphCSR *graph,
+                                           const types::FileUID &fileUID) {
+  std::set<types::FileUID> dependencies;
+  IncludeGraphCSR::Index from;
+  if (!graph->findIndex(fileUID, from)) {
+    return dependencies;
+  }
+
+  const IncludeGraphCSR::Graph &includes = graph->getIncludeGraph();
+  std::vector<char> used = usedBy(graph, from);
+  std::vector<char> knownUsages(graph->numNodes(), 0);
+  std::vector<char> knownNodes(graph->numNodes(), 0);
+  std::vector<IncludeGraphCSR::Index> queue;
+  queue.reserve(graph->numNodes() + 1);
+
+  for (auto dependency : includes.successors(from)) {
+    if (isRequired(includes, dependency, used, knownUsages, knownNodes,
+                   queue)) {
+      dependencies.insert(graph->getUID(dependency));
+    }
+  }
+
+  return dependencies;
+}
+
+std::set<types::FileUID> IncludeGraphDependencies::liveDependencies(
+    const IncludeGraphReachability *index, const types::FileUID &fileUID) {
+  IncludeGraphCSR::Index node;
+  if (!index->getGraph()->findIndex(fileUID, node)) {
+    return {};
+  }
+  return liveDependenciesOf(index, node);
+}
+
+IncludeGraphDependencies::LiveDependenciesMap
+IncludeGraphDependencies::allLiveDependencies(
+    const IncludeGraphReachability *index) {
+  const IncludeGraphCSR *graph = index->getGraph();
+  LiveDependenciesMap dependencies;
+  for (IncludeGraphCSR::Index node = 0; node < graph->numNodes(); ++node) {
+    dependencies.emplace_hint(dependencies.end(), graph->getUID(node),
+                              liveDependenciesOf(index, node));
+  }
+  return dependencies;
 }
 
 IncludeGraphDependencies::DirectDependenciesMap
 IncludeGraphDependencies::liveWeakDependencies(
-    const clangmetatool::collectors::IncludeGraphData *data,
-    const clangmetatool::types::FileUID &fileUID) {
+    const IncludeGraphCSR *graph, const types::FileUID &fileUID) {
   IncludeGraphDependencies::DirectDependenciesMap depsMap;
+  IncludeGraphCSR::Index forNode;
+  if (!graph->findIndex(fileUID, forNode)) {
+    return depsMap;
+  }
 
-  types::FileGraph::const_iterator rangeBegin, rangeEnd;
-  std::tie(rangeBegin, rangeEnd) = edgeRangeStartsWith(data, fileUID);
+  const IncludeGraphCSR::Graph &includes = graph->getIncludeGraph();
+  auto roots = includes.successors(forNode);
+  std::vector<llvm::BitVector> labels =
+      reachingRoots(graph->numNodes(), roots, [&](IncludeGraphCSR::Index node) {
+        return includes.successors(node);
+      });
 
-  for (auto it = rangeBegin; it != rangeEnd; ++it) {
-    assert(it->first == fileUID);
-    std::set<types::FileUID> knownNodes;
-    traverseFor(fileUID, it->second, data, knownNodes, depsMap);
+  for (auto used : graph->getUsageGraph().successors(forNode)) {
+    for (unsigned root : labels[used].set_bits()) {
+      depsMap[graph->getUID(used)].emplace(graph->getUID(roots[root]));
+    }
   }
 
   return depsMap;
 }
 
+std::set<types::FileUID> IncludeGraphDependencies::collectAllIncludes(
+    const ParallelIncludeGraphTraversal *traversal,
+    const types::FileUID &fileUID) {
+  const IncludeGraphCSR *graph = traversal->getGraph();
+  IncludeGraphCSR::Index start;
+  if (!graph->findIndex(fileUID, start)) {
+    return {fileUID};
+  }
+
+  llvm::BitVector reached = traversal->reach(start);
+  std::set<types::FileUID> visitedNodes;
+  for (unsigned node : reached.set_bits()) {
+    visitedNodes.emplace_hint(visitedNodes.end(), graph->getUID(node));
+  }
+  return visitedNodes;
+}
+
+std::set<types::FileUID> IncludeGraphDependencies::liveDependencies(
+    const ParallelIncludeGraphTraversal *traversal,
+    const types::FileUID &fileUID) {
+  const IncludeGraphCSR *graph = traversal->getGraph();
+  std::set<types::FileUID> dependencies;
+  IncludeGraphCSR::Index from;
+  if (!graph->findIndex(fileUID, from)) {
+    return dependencies;
+  }
+
+  auto roots = graph->getIncludeGraph().successors(from);
+  std::vector<IncludeGraphCSR::Index> first =
+      traversal->firstReachingSource(roots);
+  for (auto used : graph->getUsageGraph().successors(from)) {
+    if (first[used] < roots.size()) {
+      dependencies.insert(graph->getUID(roots[first[used]]));
+    }
+  }
+
+  return dependencies;
+}
+
+IncludeGraphDependencies::DirectDependenciesMap
+IncludeGraphDependencies::liveWeakDependencies(
+    const ParallelIncludeGraphTraversal *traversal,
+    const types::FileUID &fileUID) {
+  const IncludeGraphCSR *graph = traversal->getGraph();
+  IncludeGraphDependencies::DirectDependenciesMap depsMap;
+  IncludeGraphCSR::Index forNode;
+  if (!graph->findIndex(fileUID, forNode)) {
+    return depsMap;
+  }
+
+  auto roots = graph->getIncludeGraph().successors(forNode);
+  auto used = graph->getUsageGraph().successors(forNode);
+  std::vector<llvm::BitVector> labels =
+      traversal->reachingSources(roots, used);
+  for (size_t i = 0; i < used.size(); ++i) {
+    for (unsigned root : labels[i].set_bits()) {
+      depsMap[graph->getUID(used[i])].emplace(graph->getUID(roots[root]));
+    }
+  }
+
+  return depsMap;
+}
+
+std::map<types::FileUID, std::string>
+IncludeGraphDependencies::filePaths(const collectors::IncludeGraphData *data) {
+  std::map<types::FileUID, std::string> paths(data->fuid2name.begin(),
+                                              data->fuid2name.end());
+  for (const auto &p : data->path2fuid) {
+    paths[p.second] = p.first;
+  }
+  return paths;
+}
+
 } // namespace clangmetatool
@@ -0,0 +1,166 @@
+#include <clangmetatool/include_graph_reachability.h>
+
+#include <algorithm>
+#include <limits>
+#include <utility>
+
+namespace clangmetatool {
+
+namespace {
+
+typedef IncludeGraphCSR::Index Index;
+
+constexpr Index UNVISITED = std::numeric_limits<Index>::max();
+
+/**
+ * Tarjan's strongly connected components algorithm, without recursion
+ * so deep include chains can't overflow the stack. Components are
+ * numbered in the order they are completed, after every component they
+ * reach.
+ */
+std::vector<Index> findComponents(const IncludeGraphCSR::Graph &includes,
+                                  size_t numNodes) {
+  std::vector<Index> componentOf(numNodes, UNVISITED);
+  std::vector<Index> order(numNodes, UNVISITED);
+  std::vector<Index> lowLink(numNodes, 0);
+  std::vector<char> onStack(numNodes, 0);
+  std::vector<Index> stack;
+  // Node being visited and position of the next successor to look at
+  std::vector<std::pair<Index, size_t>> callStack;
+  Index nextOrder = 0;
+  Index nextComponent = 0;
+
+  auto visit = [&](Index node) {
+    order[node] = lowLink[node] = nextOrder++;
+    stack.push_back(node);
+    onStack[node] = 1;
+    callStack.emplace_back(node, 0);
+  };
+
+  for (Index root = 0; root < numNodes; ++root) {
+    if (order[root] != UNVISITED) {
+      continue;
+    }
+    visit(root);
+    while (!callStack.empty()) {
+      Index node = callStack.back().first;
+      auto successors = includes.successors(node);
+      size_t &next = callStack.back().second;
+      if (next < successors.size()) {
+        Index successor = successors[next++];
+        if (order[successor] == UNVISITED) {
+          visit(successor);
+        } else if (onStack[successor]) {
+          lowLink[node] = std::min(lowLink[node], order[successor]);
+        }
+        continue;
+      }
+
+      if (lowLink[node] == order[node]) {
+        Index member;
+        do {
+          member = stack.back();
+          stack.pop_back();
+          onStack[member] = 0;
+          componentOf[member] = nextComponent;
+        } while (member != node);
+        ++nextComponent;
+      }
+      callStack.pop_back();
+      if (!callStack.empty()) {
+        Index parent = callStack.back().first;
+        lowLink[parent] = std::min(lowLink[parent], lowLink[node]);
+      }
+    }
+  }
+
+  return componentOf;
+}
+
+} // namespace
+
+IncludeGraphReachability::IncludeGraphReachability(
+    const IncludeGraphCSR *graph)
+    : graph(graph) {
+  const IncludeGraphCSR::Graph &includes = graph->getIncludeGraph();
+  size_t numNodes = graph->numNodes();
+  componentOf = findComponents(includes, numNodes);
+
+  size_t numComponents = 0;
+  for (Index component : componentOf) {
+    numComponents = std::max<size_t>(numComponents, component + 1);
+  }
+
+  memberOffsets.assign(numComponents + 1, 0);
+  for (Index component : componentOf) {
+    ++memberOffsets[component + 1];
+  }
+  for (size_t i = 1; i < memberOffsets.size(); ++i) {
+    memberOffsets[i] += memberOffsets[i - 1];
+  }
+  members.resize(numNodes);
+  std::vector<Index> next(memberOffsets.begin(), memberOffsets.end() - 1);
+  for (Index node = 0; node < numNodes; ++node) {
+    members[next[componentOf[node]]++] = node;
+  }
+
+  // Every component a component includes was numbered before it
+  closures.resize(numComponents);
+  for (Index component = 0; component < numComponents; ++component) {
+    llvm::SparseBitVector<> &closure = closures[component];
+    closure.set(component);
+    for (Index i = memberOffsets[component]; i < memberOffsets[component + 1];
+         ++i) {
+      for (Index successor : includes.successors(members[i])) {
+        Index successorComponent = componentOf[successor];
+        if (successorComponent != component) {
+          closure |= closures[successorComponent];
+        }
+      }
+    }
+  }
+}
+
+bool IncludeGraphReachability::isReachable(types::FileUID from,
+                                           types::FileUID to) const {
+  Index fromNode, toNode;
+  if (!graph->findIndex(from, fromNode) || !graph->findIndex(to, toNode)) {
+    return from == to;
+  }
+  return isNodeReachable(fromNode, toNode);
+}
+
+std::set<types::FileUID>
+IncludeGraphReachability::getReachable(types::FileUID file) const {
+  Index node;
+  if (!graph->findIndex(file, node)) {
+    return {file};
+  }
+
+  std::set<types::FileUID> reachable;
+  for (unsigned component : closures[componentOf[node]]) {
+    for (Index i = memberOffsets[component]; i < memberOffsets[component + 1];
+         ++i) {
+      reachable.insert(graph->getUID(members[i]));
+    }
+  }
+  return reachable;
+}
+
+} // namespace clangmetatool
+
+// ----------------------------------------------------------------------------
+// Copyright 2026 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,376 @@
+#include <clangmetatool/include_graph_snapshot.h>
+
+#include <clang/Basic/FileManager.h>
+#include <llvm/ADT/StringMap.h>
+#include <llvm/Support/ErrorHandling.h>
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+namespace clangmetatool {
+
+namespace {
+
+const char snapshotMagic[8] = {'C', 'M', 'T', 'I', 'G', 'S', 0, 0};
+const uint32_t snapshotByteOrder = 0x01020304;
+
+/**
+ * Bump it whenever the layout changes.
+ */
+const uint32_t snapshotVersion = 1;
+
+const uint32_t systemFlag = 1;
+
+uint32_t clamp(size_t count) {
+  return static_cast<uint32_t>(
+      std::min<size_t>(count, std::numeric_limits<uint32_t>::max()));
+}
+
+/**
+ * NUL terminated strings, each written once. The empty string is at
+ * offset 0.
+ */
+class StringTable {
+private:
+  llvm::StringMap<uint32_t> offsets;
+  std::string data;
+
+public:
+  StringTable() : data(1, '\0') {}
+
+  uint32_t add(llvm::StringRef s) {
+    if (s.empty()) {
+      return 0;
+    }
+    auto inserted = offsets.try_emplace(s, static_cast<uint32_t>(data.size()));
+    if (inserted.second) {
+      data.append(s.data(), s.size());
+      data.push_back('\0');
+    }
+    return inserted.first->second;
+  }
+
+  /**
+   * The table, padded so that it ends on a 32 bit boundary.
+   */
+  const std::string &get() {
+    data.resize((data.size() + 3) & ~size_t(3), '\0');
+    return data;
+  }
+};
+
+template <class T> void writeArray(llvm::raw_ostream &os, llvm::ArrayRef<T> a) {
+  os.write(reinterpret_cast<const char *>(a.data()), a.size() * sizeof(T));
+}
+
+/**
+ * Reads consecutive arrays out of a buffer, checking that they fit.
+ */
+class ArrayReader {
+private:
+  const char *position;
+  const char *end;
+
+public:
+  ArrayReader(llvm::StringRef buffer)
+      : position(buffer.begin()), end(buffer.end()) {}
+
+  template <class T> bool read(size_t count, llvm::ArrayRef<T> &result) {
+    if (count > static_cast<size_t>(end - position) / sizeof(T)) {
+      return false;
+    }
+    result = llvm::ArrayRef<T>(reinterpret_cast<const T *>(position), count);
+    position += count * sizeof(T);
+    return true;
+  }
+
+  bool atEnd() const { return position == end; }
+};
+
+/**
+ * Whether offsets delimit count elements in rows.
+ */
+bool isValidRows(llvm::ArrayRef<uint32_t> offsets, size_t count) {
+  if (offsets.front() != 0 || offsets.back() != count) {
+    return false;
+  }
+  for (size_t i = 1; i < offsets.size(); ++i) {
+    if (offsets[i] < offsets[i - 1]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * Whether the rows of the graph are valid, and their targets are nodes
+ * in increasing order, as the binary searches on successors expect.
+ */
+bool isValidGraph(const IncludeGraphCSR::Graph &graph, size_t numNodes) {
+  if (!isValidRows(graph.offsets, graph.targets.size())) {
+    return false;
+  }
+  for (uint32_t target : graph.targets) {
+    if (target >= numNodes) {
+      return false;
+    }
+  }
+  for (size_t node = 0; node < numNodes; ++node) {
+    llvm::ArrayRef<IncludeGraphCSR::Index> row = graph.successors(node);
+    for (size_t i = 1; i < row.size(); ++i) {
+      if (row[i] <= row[i - 1]) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+} // namespace
+
+struct IncludeGraphSnapshot::Header {
+  char magic[8];
+  uint32_t byteOrder;
+  uint32_t version;
+  uint32_t numFiles;
+  uint32_t numIncludeEdges;
+  uint32_t numUseEdges;
+  uint32_t numUsageEdges;
+  uint32_t numStatements;
+  uint32_t stringsSize;
+};
+
+void IncludeGraphSnapshot::write(const collectors::IncludeGraphData *data,
+                                 const clang::SourceManager *sm,
+                                 llvm::raw_ostream &os) {
+  if (!sm && !data->include_statements.empty()) {
+    llvm::report_fatal_error(
+        "IncludeGraphSnapshot::write needs the source manager to write "
+        "include statements");
+  }
+
+  IncludeGraphCSR csr(data);
+  const IncludeGraphCSR::Graph &includes = csr.getIncludeGraph();
+  const IncludeGraphCSR::Graph &usages = csr.getUsageGraph();
+
+  std::vector<types::FileUID> uids;
+  StringTable strings;
+  std::vector<FileRecord> files;
+  for (Index node = 0; node < csr.numNodes(); ++node) {
+    types::FileUID uid = csr.getUID(node);
+    uids.push_back(uid);
+
+    FileRecord file = {0, 0, 0};
+    auto name = data->fuid2name.find(uid);
+    if (name != data->fuid2name.end()) {
+      file.name = strings.add(name->second);
+    }
+    auto entry = data->fuid2entry.find(uid);
+    if (entry != data->fuid2entry.end() && entry->second) {
+      file.path = strings.add(entry->second->tryGetRealPathName());
+    }
+    auto system = data->is_system.find(uid);
+    if (system != data->is_system.end() && system->second) {
+      file.flags |= systemFlag;
+    }
+    files.push_back(file);
+  }
+
+  std::vector<UsageCounts> counts;
+  for (Index from = 0; from < csr.numNodes(); ++from) {
+    for (Index to : usages.successors(from)) {
+      types::FileGraphEdge edge(csr.getUID(from), csr.getUID(to));
+      UsageCounts c;
+      c.total = clamp(data->usage_reference_count.at(edge));
+      c.macros = clamp(data->macro_references.count(edge));
+      c.declarations = clamp(data->decl_references.count(edge));
+      c.types = clamp(data->type_references.count(edge));
+      c.redeclarations = clamp(data->redeclarations.count(edge));
+      counts.push_back(c);
+    }
+  }
+
+  std::vector<uint32_t> statementOffsets(1, 0);
+  std::vector<IncludeStatement> statements;
+  for (Index from = 0; from < csr.numNodes(); ++from) {
+    for (Index to : includes.successors(from)) {
+      size_t first = statements.size();
+      auto range = data->include_statements.equal_range(
+          types::FileGraphEdge(csr.getUID(from), csr.getUID(to)));
+      for (auto it = range.first; it != range.second; ++it) {
+        statements.push_back({sm->getFileOffset(it->second.getBegin()),
+                              sm->getFileOffset(it->second.getEnd())});
+      }
+      std::sort(statements.begin() + first, statements.end(),
+                [](const IncludeStatement &a, const IncludeStatement &b) {
+                  return a.begin < b.begin;
+                });
+      statementOffsets.push_back(static_cast<uint32_t>(statements.size()));
+    }
+  }
+
+  const std::string &table = strings.get();
+
+  Header header;
+  std::memcpy(header.magic, snapshotMagic, sizeof(header.magic));
+  header.byteOrder = snapshotByteOrder;
+  header.version = snapshotVersion;
+  header.numFiles = static_cast<uint32_t>(csr.numNodes());
+  header.numIncludeEdges = static_cast<uint32_t>(includes.numEdges());
+  header.numUseEdges = static_cast<uint32_t>(csr.getUseGraph().numEdges());
+  header.numUsageEdges = static_cast<uint32_t>(usages.numEdges());
+  header.numStatements = static_cast<uint32_t>(statements.size());
+  header.stringsSize = static_cast<uint32_t>(table.size());
+
+  writeArray(os, llvm::ArrayRef<Header>(header));
+  writeArray(os, llvm::ArrayRef<types::FileUID>(uids));
+  writeArray(os, llvm::ArrayRef<FileRecord>(files));
+  for (const IncludeGraphCSR::Graph *graph :
+       {&includes, &csr.getUseGraph(), &usages}) {
+    writeArray(os, graph->offsets);
+    writeArray(os, graph->targets);
+  }
+  writeArray(os, llvm::ArrayRef<UsageCounts>(counts));
+  writeArray(os, llvm::ArrayRef<uint32_t>(statementOffsets));
+  writeArray(os, llvm::ArrayRef<IncludeStatement>(statements));
+  os << table;
+}
+
+std::unique_ptr<IncludeGraphSnapshot>
+IncludeGraphSnapshot::load(const std::string &path) {
+  // Without a null terminator, large files are mapped instead of read
+#if LLVM_VERSION_MAJOR >= 13
+  auto buffer = llvm::MemoryBuffer::getFile(path, /*IsText=*/false,
+                                            /*RequiresNullTerminator=*/false);
+#else
+  auto buffer = llvm::MemoryBuffer::getFile(path, /*FileSize=*/-1,
+                                            /*RequiresNullTerminator=*/false);
+#endif
+  if (!buffer) {
+    return nullptr;
+  }
+  return load(std::move(*buffer));
+}
+
+std::unique_ptr<IncludeGraphSnapshot>
+IncludeGraphSnapshot::load(std::unique_ptr<llvm::MemoryBuffer> buffer) {
+  if (reinterpret_cast<uintptr_t>(buffer->getBufferStart()) %
+          alignof(uint32_t) !=
+      0) {
+    buffer = llvm::MemoryBuffer::getMemBufferCopy(
+        buffer->getBuffer(), buffer->getBufferIdentifier());
+  }
+
+  std::unique_ptr<IncludeGraphSnapshot> snapshot(new IncludeGraphSnapshot());
+  ArrayReader reader(buffer->getBuffer());
+
+  llvm::ArrayRef<Header> headers;
+  if (!reader.read(1, headers)) {
+    return nullptr;
+  }
+  const Header &header = headers.front();
+  if (std::memcmp(header.magic, snapshotMagic, sizeof(header.magic)) != 0 ||
+      header.byteOrder != snapshotByteOrder ||
+      header.version != snapshotVersion) {
+    return nullptr;
+  }
+
+  size_t numFiles = header.numFiles;
+  llvm::ArrayRef<types::FileUID> uids;
+  IncludeGraphCSR::Graph includes, uses, usages;
+  llvm::ArrayRef<char> strings;
+  if (!reader.read(numFiles, uids) ||
+      !reader.read(numFiles, snapshot->files) ||
+      !reader.read(numFiles + 1, includes.offsets) ||
+      !reader.read(header.numIncludeEdges, includes.targets) ||
+      !reader.read(numFiles + 1, uses.offsets) ||
+      !reader.read(header.numUseEdges, uses.targets) ||
+      !reader.read(numFiles + 1, usages.offsets) ||
+      !reader.read(header.numUsageEdges, usages.targets) ||
+      !reader.read(header.numUsageEdges, snapshot->usageCounts) ||
+      !reader.read(size_t(header.numIncludeEdges) + 1,
+                   snapshot->statementOffsets) ||
+      !reader.read(header.numStatements, snapshot->statements) ||
+      !reader.read(header.stringsSize, strings) || !reader.atEnd()) {
+    return nullptr;
+  }
+
+  // Check everything the accessors rely on, so that a corrupted file
+  // can't make them read out of the buffer
+  for (size_t i = 1; i < uids.size(); ++i) {
+    if (uids[i] <= uids[i - 1]) {
+      return nullptr;
+    }
+  }
+  if (!isValidGraph(includes, numFiles) || !isValidGraph(uses, numFiles) ||
+      !isValidGraph(usages, numFiles) ||
+      !isValidRows(snapshot->statementOffsets, header.numStatements)) {
+    return nullptr;
+  }
+  if (strings.empty() || strings.back() != '\0') {
+    return nullptr;
+  }
+  for (const FileRecord &file : snapshot->files) {
+    if (file.name >= strings.size() || file.path >= strings.size()) {
+      return nullptr;
+    }
+  }
+
+  snapshot->strings = llvm::StringRef(strings.data(), strings.size());
+  snapshot->graph =
+      std::make_unique<IncludeGraphCSR>(uids, includes, uses, usages);
+  snapshot->buffer = std::move(buffer);
+  return snapshot;
+}
+
+llvm::StringRef IncludeGraphSnapshot::getName(Index node) const {
+  return strings.data() + files[node].name;
+}
+
+llvm::StringRef IncludeGraphSnapshot::getPath(Index node) const {
+  return strings.data() + files[node].path;
+}
+
+bool IncludeGraphSnapshot::isSystem(Index node) const {
+  return files[node].flags & systemFlag;
+}
+
+llvm::ArrayRef<IncludeGraphSnapshot::UsageCounts>
+IncludeGraphSnapshot::getUsageCounts(Index node) const {
+  const IncludeGraphCSR::Graph &usages = graph->getUsageGraph();
+  return usageCounts.slice(usages.offsets[node],
+                           usages.offsets[node + 1] - usages.offsets[node]);
+}
+
+llvm::ArrayRef<IncludeGraphSnapshot::IncludeStatement>
+IncludeGraphSnapshot::getIncludeStatements(Index from, Index to) const {
+  const IncludeGraphCSR::Graph &includes = graph->getIncludeGraph();
+  llvm::ArrayRef<Index> successors = includes.successors(from);
+  auto it = std::lower_bound(successors.begin(), successors.end(), to);
+  if (it == successors.end() || *it != to) {
+    return llvm::ArrayRef<IncludeStatement>();
+  }
+  size_t edge = includes.offsets[from] + (it - successors.begin());
+  return statements.slice(statementOffsets[edge],
+                          statementOffsets[edge + 1] - statementOffsets[edge]);
+}
+
+} // namespace clangmetatool
+
+// ----------------------------------------------------------------------------
+// Copyright 2026 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
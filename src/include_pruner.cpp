@@ -0,0 +1,288 @@
+#include <clangmetatool/include_pruner.h>
+
+#include <clangmetatool/include_graph_csr.h>
+#include <clangmetatool/include_graph_reachability.h>
+
+#include <clang/Basic/FileManager.h>
+#include <llvm/ADT/SmallString.h>
+#include <llvm/ADT/SparseBitVector.h>
+#include <llvm/ADT/StringRef.h>
+#include <llvm/Support/Error.h>
+#include <llvm/Support/FileSystem.h>
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+namespace clangmetatool {
+
+namespace {
+
+using types::FileGraphEdge;
+using types::FileUID;
+
+typedef IncludeGraphCSR::Index Index;
+
+/**
+ * Real path of a file of the source manager, or an empty string if it
+ * has none.
+ */
+std::string realPathOf(const clang::SourceManager &sm, clang::FileID fid) {
+  llvm::StringRef path;
+  const clang::FileEntry *entry = sm.getFileEntryForID(fid);
+  if (entry) {
+    path = entry->tryGetRealPathName();
+  }
+  if (path.empty()) {
+    path = sm.getFilename(sm.getLocForStartOfFile(fid));
+  }
+
+  llvm::SmallString<256> result;
+  if (path.empty() || llvm::sys::fs::real_path(path, result)) {
+    return std::string();
+  }
+  return result.str().str();
+}
+
+/**
+ * Find the line of the include statement from offset begin to offset
+ * end of the buffer, including its end of line. Returns false if the
+ * line can't be deleted on its own: something else is on it, a comment
+ * or a line continuation goes on past it, or it asks to be kept.
+ */
+bool findLine(llvm::StringRef buffer, unsigned begin, unsigned end,
+              unsigned &lineBegin, unsigned &lineEnd) {
+  if (begin > end || end > buffer.size()) {
+    return false;
+  }
+
+  lineBegin = begin;
+  while (lineBegin > 0 &&
+         (buffer[lineBegin - 1] == ' ' || buffer[lineBegin - 1] == '\t')) {
+    --lineBegin;
+  }
+  if (lineBegin > 0 && buffer[lineBegin - 1] != '\n') {
+    return false;
+  }
+
+  size_t newline = buffer.find('\n', end);
+  lineEnd = newline == llvm::StringRef::npos ? buffer.size() : newline + 1;
+
+  llvm::StringRef rest = buffer.slice(end, newline).rtrim();
+  if (rest.contains("IWYU pragma: keep") ||
+      (!rest.empty() && rest.back() == '\\')) {
+    return false;
+  }
+  size_t comment = rest.find("/*");
+  return comment == llvm::StringRef::npos ||
+         rest.find("*/", comment + 2) != llvm::StringRef::npos;
+}
+
+} // namespace
+
+std::set<FileGraphEdge>
+IncludePruner::removableIncludes(const collectors::IncludeGraphData *data) {
+  IncludeGraphCSR graph(data);
+  IncludeGraphReachability index(&graph);
+  const IncludeGraphCSR::Graph &includes = graph.getIncludeGraph();
+  const IncludeGraphCSR::Graph &usages = graph.getUsageGraph();
+
+  // Components used by the files that include each component, directly
+  // or not. Components only include components with a lower number, so
+  // going down the numbers visits every includer before its includes.
+  size_t numComponents = index.numComponents();
+  std::vector<llvm::SparseBitVector<>> usedAbove(numComponents);
+  for (Index component = numComponents; component-- > 0;) {
+    auto members = index.getMembers(component);
+    llvm::SparseBitVector<> used;
+    for (Index member : members) {
+      for (Index usedNode : usages.successors(member)) {
+        used.set(index.getComponent(usedNode));
+      }
+    }
+
+    // The files of a cycle include each other
+    if (members.size() > 1) {
+      usedAbove[component] |= used;
+    }
+    used |= usedAbove[component];
+
+    for (Index member : members) {
+      for (Index successor : includes.successors(member)) {
+        Index successorComponent = index.getComponent(successor);
+        if (successorComponent != component) {
+          usedAbove[successorComponent] |= used;
+        }
+      }
+    }
+  }
+
+  // Files often use what an earlier include of their includer brought
+  // in rather than including it themselves. For each component used
+  // that way, the components of the files using it.
+  std::vector<llvm::SparseBitVector<>> usedWithoutInclude(numComponents);
+  llvm::SparseBitVector<> usedWithoutIncludeAny;
+  for (Index component = 0; component < numComponents; ++component) {
+    const llvm::SparseBitVector<> &closure = index.getClosure(component);
+    for (Index member : index.getMembers(component)) {
+      for (Index usedNode : usages.successors(member)) {
+        Index usedComponent = index.getComponent(usedNode);
+        if (!closure.test(usedComponent)) {
+          usedWithoutInclude[usedComponent].set(component);
+          usedWithoutIncludeAny.set(usedComponent);
+        }
+      }
+    }
+  }
+
+  // Whether a file that stays in the translation unit when the
+  // components of the closure are gone uses one of them without
+  // including it
+  auto usedFromOutside = [&](const llvm::SparseBitVector<> &closure) {
+    for (unsigned used : usedWithoutIncludeAny & closure) {
+      if (!closure.contains(usedWithoutInclude[used])) {
+        return true;
+      }
+    }
+    return false;
+  };
+
+  std::set<FileGraphEdge> removable;
+  for (Index node = 0; node < graph.numNodes(); ++node) {
+    FileUID uid = graph.getUID(node);
+    auto system = data->is_system.find(uid);
+    if (system != data->is_system.end() && system->second) {
+      continue;
+    }
+
+    auto direct = includes.successors(node);
+    if (direct.empty()) {
+      continue;
+    }
+
+    // The live dependencies, except that a file used and included
+    // directly is kept rather than an include that leads to it
+    std::set<Index> live;
+    for (Index used : usages.successors(node)) {
+      if (std::find(direct.begin(), direct.end(), used) != direct.end()) {
+        live.insert(used);
+        continue;
+      }
+      for (Index dependency : direct) {
+        if (index.isNodeReachable(dependency, used)) {
+          live.insert(dependency);
+          break;
+        }
+      }
+    }
+
+    const llvm::SparseBitVector<> &neededAbove =
+        usedAbove[index.getComponent(node)];
+    for (Index dependency : direct) {
+      if (dependency == node || live.count(dependency)) {
+        continue;
+      }
+      const llvm::SparseBitVector<> &closure =
+          index.getClosure(index.getComponent(dependency));
+      if (neededAbove.intersects(closure) || usedFromOutside(closure)) {
+        continue;
+      }
+      removable.emplace(uid, graph.getUID(dependency));
+    }
+  }
+  return removable;
+}
+
+void IncludePruner::add(const collectors::IncludeGraphData *data,
+                        const clang::SourceManager &sm) {
+  // Only merging the verdicts below needs the lock
+  std::set<FileGraphEdge> removable = removableIncludes(data);
+
+  std::map<clang::FileID, std::string> paths;
+  std::map<std::string, std::map<unsigned, Statement>> found;
+  for (const auto &p : data->include_statements) {
+    std::pair<clang::FileID, unsigned> begin =
+        sm.getDecomposedLoc(sm.getFileLoc(p.second.getBegin()));
+    std::pair<clang::FileID, unsigned> end =
+        sm.getDecomposedLoc(sm.getFileLoc(p.second.getEnd()));
+    if (begin.first.isInvalid() || begin.first != end.first) {
+      continue;
+    }
+
+    auto path = paths.find(begin.first);
+    if (path == paths.end()) {
+      path = paths.emplace(begin.first, realPathOf(sm, begin.first)).first;
+    }
+    if (path->second.empty()) {
+      continue;
+    }
+
+    bool invalid = false;
+    llvm::StringRef buffer = sm.getBufferData(begin.first, &invalid);
+    if (invalid) {
+      continue;
+    }
+
+    unsigned lineBegin = begin.second, lineEnd = end.second;
+    bool deletable =
+        findLine(buffer, begin.second, end.second, lineBegin, lineEnd);
+
+    Statement statement = {lineEnd - lineBegin,
+                           !deletable || !removable.count(p.first)};
+    auto inserted = found[path->second].emplace(lineBegin, statement);
+    if (!inserted.second) {
+      inserted.first->second.needed |= statement.needed;
+    }
+  }
+
+  std::lock_guard<std::mutex> lock(mutex);
+  ++numTranslationUnits;
+  for (const auto &file : found) {
+    auto &merged = statements[file.first];
+    for (const auto &p : file.second) {
+      auto inserted = merged.emplace(p);
+      if (!inserted.second) {
+        inserted.first->second.needed |= p.second.needed;
+      }
+    }
+  }
+}
+
+size_t IncludePruner::getNumTranslationUnits() const {
+  std::lock_guard<std::mutex> lock(mutex);
+  return numTranslationUnits;
+}
+
+std::map<std::string, clang::tooling::Replacements>
+IncludePruner::getReplacements() const {
+  std::lock_guard<std::mutex> lock(mutex);
+  std::map<std::string, clang::tooling::Replacements> replacements;
+  for (const auto &file : statements) {
+    for (const auto &p : file.second) {
+      if (!p.second.needed) {
+        llvm::consumeError(replacements[file.first].add(
+            clang::tooling::Replacement(file.first, p.first, p.second.length,
+                                        "")));
+      }
+    }
+  }
+  return replacements;
+}
+
+} // namespace clangmetatool
+
+// ----------------------------------------------------------------------------
+// Copyright 2026 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
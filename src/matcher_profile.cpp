@@ -0,0 +1,110 @@
+#include <clangmetatool/matcher_profile.h>
+
+#include <llvm/ADT/StringRef.h>
+#include <llvm/Support/Format.h>
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+namespace clangmetatool {
+
+namespace {
+
+std::string collectorName(llvm::StringRef callbackID) {
+  return callbackID.split("::").first.str();
+}
+
+/**
+ * Entries of the map, from the largest to the smallest wall time.
+ */
+std::vector<std::pair<std::string, llvm::TimeRecord>>
+ranked(const std::map<std::string, llvm::TimeRecord> &records) {
+  std::vector<std::pair<std::string, llvm::TimeRecord>> result(
+      records.begin(), records.end());
+  std::stable_sort(result.begin(), result.end(),
+                   [](const std::pair<std::string, llvm::TimeRecord> &a,
+                      const std::pair<std::string, llvm::TimeRecord> &b) {
+                     return a.second.getWallTime() > b.second.getWallTime();
+                   });
+  return result;
+}
+
+} // namespace
+
+void MatcherProfile::add(const llvm::StringMap<llvm::TimeRecord> &records) {
+  std::lock_guard<std::mutex> lock(mutex);
+  for (const auto &entry : records) {
+    callbacks[entry.getKey().str()] += entry.getValue();
+  }
+  ++numTranslationUnits;
+}
+
+size_t MatcherProfile::getNumTranslationUnits() const {
+  std::lock_guard<std::mutex> lock(mutex);
+  return numTranslationUnits;
+}
+
+std::map<std::string, llvm::TimeRecord> MatcherProfile::getCallbacks() const {
+  std::lock_guard<std::mutex> lock(mutex);
+  return callbacks;
+}
+
+std::map<std::string, llvm::TimeRecord>
+MatcherProfile::getCollectors() const {
+  std::map<std::string, llvm::TimeRecord> collectors;
+  for (const auto &p : getCallbacks()) {
+    collectors[collectorName(p.first)] += p.second;
+  }
+  return collectors;
+}
+
+void MatcherProfile::printReport(llvm::raw_ostream &os) const {
+  auto callbacks = getCallbacks();
+  auto collectors = getCollectors();
+
+  double total = 0;
+  for (const auto &p : collectors) {
+    total += p.second.getWallTime();
+  }
+
+  os << "Matcher profile over " << getNumTranslationUnits()
+     << " translation units, wall time in seconds:\n";
+  for (const auto &collector : ranked(collectors)) {
+    double wall = collector.second.getWallTime();
+    os << llvm::format("%10.3f %5.1f%%  ", wall,
+                       total > 0 ? 100 * wall / total : 0.0)
+       << collector.first << "\n";
+
+    std::map<std::string, llvm::TimeRecord> own;
+    for (const auto &p : callbacks) {
+      if (collectorName(p.first) == collector.first) {
+        own.insert(p);
+      }
+    }
+    for (const auto &callback : ranked(own)) {
+      double callbackWall = callback.second.getWallTime();
+      os << llvm::format("    %10.3f %5.1f%%  ", callbackWall,
+                         total > 0 ? 100 * callbackWall / total : 0.0)
+         << callback.first << "\n";
+    }
+  }
+}
+
+} // namespace clangmetatool
+
+// ----------------------------------------------------------------------------
+// Copyright 2026 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
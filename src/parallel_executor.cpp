@@ -0,0 +1,216 @@
+#include <clangmetatool/parallel_executor.h>
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <numeric>
+#include <thread>
+#include <vector>
+
+namespace clangmetatool {
+
+namespace {
+
+/**
+ * Jobs assigned to a single worker. The owner takes jobs from the
+ * front, other workers steal from the back.
+ */
+struct JobQueue {
+  std::mutex mutex;
+  std::deque<size_t> jobs;
+
+  bool popFront(size_t &job) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (jobs.empty()) {
+      return false;
+    }
+    job = jobs.front();
+    jobs.pop_front();
+    return true;
+  }
+
+  bool popBack(size_t &job) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (jobs.empty()) {
+      return false;
+    }
+    job = jobs.back();
+    jobs.pop_back();
+    return true;
+  }
+};
+
+bool stealFromOthers(std::vector<JobQueue> &queues, size_t self,
+                     size_t &job) {
+  // No jobs are added once the workers are started, so when every queue
+  // was seen empty there is nothing left to do.
+  for (size_t i = 1; i < queues.size(); ++i) {
+    if (queues[(self + i) % queues.size()].popBack(job)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+} // namespace
+
+/**
+ * The worker threads of an executor. Every run bumps the generation,
+ * which wakes the workers up; the ones it needs call the worker
+ * function with their index and report when they are done.
+ */
+struct ParallelExecutor::Pool {
+  typedef std::function<void(size_t)> Worker;
+
+  /**
+   * Held by the run using the workers.
+   */
+  std::mutex runMutex;
+
+  std::mutex mutex;
+  std::condition_variable wake;
+  std::condition_variable done;
+  std::vector<std::thread> threads;
+  size_t generation = 0;
+  const Worker *worker = nullptr;
+  size_t numWorkers = 0;
+  size_t pending = 0;
+  bool stopping = false;
+
+  ~Pool() {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      stopping = true;
+    }
+    wake.notify_all();
+    for (auto &t : threads) {
+      t.join();
+    }
+  }
+
+  void loop(size_t self, size_t seen) {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+      wake.wait(lock, [&] { return stopping || generation != seen; });
+      if (stopping) {
+        return;
+      }
+      seen = generation;
+      if (self >= numWorkers) {
+        continue;
+      }
+
+      const Worker *w = worker;
+      lock.unlock();
+      (*w)(self);
+      lock.lock();
+      if (--pending == 0) {
+        done.notify_one();
+      }
+    }
+  }
+
+  /**
+   * Call the worker function with every index in [0, n), index 0 on
+   * the calling thread, and return once every call returned. The caller
+   * must hold runMutex.
+   */
+  void run(size_t n, const Worker &w) {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      // Threads started now wait for the generation after this one
+      while (threads.size() + 1 < n) {
+        size_t self = threads.size() + 1;
+        threads.emplace_back(&Pool::loop, this, self, generation);
+      }
+      worker = &w;
+      numWorkers = n;
+      pending = n - 1;
+      ++generation;
+    }
+    wake.notify_all();
+
+    w(0);
+
+    std::unique_lock<std::mutex> lock(mutex);
+    done.wait(lock, [this] { return pending == 0; });
+    worker = nullptr;
+  }
+};
+
+ParallelExecutor::ParallelExecutor(unsigned numThreads)
+    : numThreads(numThreads), pool(new Pool) {
+  if (this->numThreads == 0) {
+    this->numThreads = std::max(1u, std::thread::hardware_concurrency());
+  }
+}
+
+ParallelExecutor::~ParallelExecutor() = default;
+
+unsigned ParallelExecutor::getNumThreads() const { return numThreads; }
+
+void ParallelExecutor::run(size_t numJobs, const Job &job) const {
+  std::vector<size_t> order(numJobs);
+  std::iota(order.begin(), order.end(), 0);
+  run(order, job);
+}
+
+void ParallelExecutor::run(const std::vector<size_t> &order,
+                           const Job &job) const {
+  size_t numWorkers = std::min<size_t>(numThreads, order.size());
+  if (numWorkers <= 1) {
+    // no point in spawning a thread just to wait for it
+    for (size_t i : order) {
+      job(i);
+    }
+    return;
+  }
+
+  std::vector<JobQueue> queues(numWorkers);
+  for (size_t i = 0; i < order.size(); ++i) {
+    queues[i % numWorkers].jobs.push_back(order[i]);
+  }
+
+  Pool::Worker worker = [&](size_t self) {
+    size_t next;
+    while (queues[self].popFront(next) ||
+           stealFromOthers(queues, self, next)) {
+      job(next);
+    }
+  };
+
+  std::unique_lock<std::mutex> exclusive(pool->runMutex, std::try_to_lock);
+  if (exclusive) {
+    pool->run(numWorkers, worker);
+    return;
+  }
+
+  // Another run has the workers, and may be waiting for this one
+  std::vector<std::thread> workers;
+  workers.reserve(numWorkers);
+  for (size_t i = 0; i < numWorkers; ++i) {
+    workers.emplace_back(worker, i);
+  }
+  for (auto &w : workers) {
+    w.join();
+  }
+}
+
+} // namespace clangmetatool
+
+// ----------------------------------------------------------------------------
+// Copyright 2026 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
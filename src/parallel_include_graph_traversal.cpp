@@ -0,0 +1,329 @@
+#include <clangmetatool/parallel_include_graph_traversal.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+
+namespace clangmetatool {
+
+namespace {
+
+typedef IncludeGraphCSR::Index Index;
+
+/**
+ * A growing frontier switches to bottom-up when it has more than
+ * 1/ALPHA of the includers left to look at to follow, and back to
+ * top-down once it shrinks below 1/BETA of the nodes. These are the
+ * values Beamer, Asanović and Patterson suggest.
+ */
+constexpr size_t ALPHA = 14;
+constexpr size_t BETA = 24;
+
+/**
+ * Number of edges worth handing to a thread of its own.
+ */
+constexpr size_t GRAIN = 4096;
+
+size_t degree(const IncludeGraphCSR::Graph &graph, Index node) {
+  return graph.offsets[node + 1] - graph.offsets[node];
+}
+
+/**
+ * Split some work in jobs of at least GRAIN edges, a few per thread so
+ * that the ones that finish first can steal from the others.
+ */
+size_t numJobsFor(const ParallelExecutor *executor, size_t work,
+                  size_t numItems) {
+  size_t numJobs = std::min<size_t>(executor->getNumThreads() * 4,
+                                    std::max<size_t>(1, work / GRAIN));
+  return std::max<size_t>(1, std::min(numJobs, numItems));
+}
+
+} // namespace
+
+/**
+ * The nodes visited so far, as atomic bits so that the workers of a
+ * top-down level can race to claim a node. The workers are joined at
+ * the end of every level, so relaxed operations are enough.
+ */
+struct ParallelIncludeGraphTraversal::State {
+  std::vector<std::atomic<uint64_t>> words;
+
+  /**
+   * Number of includers of the nodes not visited yet: what a bottom-up
+   * level may have to look at.
+   */
+  size_t unvisitedIncluders;
+
+  State(size_t numNodes, size_t numEdges)
+      : words((numNodes + 63) / 64), unvisitedIncluders(numEdges) {}
+
+  bool test(Index node) const {
+    return words[node / 64].load(std::memory_order_relaxed) &
+           (uint64_t(1) << (node % 64));
+  }
+
+  /**
+   * Mark a node visited, return whether it wasn't yet.
+   */
+  bool set(Index node) {
+    // Most includes lead to nodes visited already, which a load tells
+    // without writing to the word
+    uint64_t bit = uint64_t(1) << (node % 64);
+    std::atomic<uint64_t> &word = words[node / 64];
+    return !(word.load(std::memory_order_relaxed) & bit) &&
+           !(word.fetch_or(bit, std::memory_order_relaxed) & bit);
+  }
+};
+
+ParallelIncludeGraphTraversal::ParallelIncludeGraphTraversal(
+    const IncludeGraphCSR *graph, const ParallelExecutor *executor)
+    : graph(graph), executor(executor) {
+  const IncludeGraphCSR::Graph &includes = graph->getIncludeGraph();
+  size_t numNodes = graph->numNodes();
+
+  includerOffsets.assign(numNodes + 1, 0);
+  for (Index target : includes.targets) {
+    ++includerOffsets[target + 1];
+  }
+  for (size_t i = 1; i < includerOffsets.size(); ++i) {
+    includerOffsets[i] += includerOffsets[i - 1];
+  }
+  includerTargets.resize(includes.numEdges());
+  std::vector<Index> next(includerOffsets.begin(), includerOffsets.end() - 1);
+  for (Index node = 0; node < numNodes; ++node) {
+    for (Index successor : includes.successors(node)) {
+      includerTargets[next[successor]++] = node;
+    }
+  }
+
+  includers.offsets = includerOffsets;
+  includers.targets = includerTargets;
+}
+
+void ParallelIncludeGraphTraversal::visit(llvm::ArrayRef<Index> sources,
+                                          State &state,
+                                          std::vector<Index> *visited) const {
+  const IncludeGraphCSR::Graph &includes = graph->getIncludeGraph();
+  size_t numNodes = graph->numNodes();
+
+  std::vector<Index> frontier;
+  for (Index source : sources) {
+    if (state.set(source)) {
+      frontier.push_back(source);
+    }
+  }
+
+  bool bottomUp = false;
+  size_t previous = 0;
+  while (!frontier.empty()) {
+    size_t frontierIncludes = 0;
+    for (Index node : frontier) {
+      frontierIncludes += degree(includes, node);
+      state.unvisitedIncluders -= degree(includers, node);
+    }
+    if (visited) {
+      visited->insert(visited->end(), frontier.begin(), frontier.end());
+    }
+
+    // Only a growing frontier goes bottom-up, so that the levels where
+    // it dwindles don't go back and forth
+    if (!bottomUp) {
+      bottomUp = frontier.size() > previous &&
+                 frontierIncludes * ALPHA > state.unvisitedIncluders;
+    } else {
+      bottomUp =
+          frontier.size() > previous || frontier.size() * BETA > numNodes;
+    }
+    previous = frontier.size();
+
+    std::vector<std::vector<Index>> next;
+    if (bottomUp) {
+      // Every node left looks for an includer in the frontier. Nodes
+      // are split in whole words so that no two jobs write to the same.
+      llvm::BitVector inFrontier(numNodes);
+      for (Index node : frontier) {
+        inFrontier.set(node);
+      }
+      size_t numWords = state.words.size();
+      size_t numJobs =
+          numJobsFor(executor, state.unvisitedIncluders, numWords);
+      size_t wordsPerJob = (numWords + numJobs - 1) / numJobs;
+      next.resize(numJobs);
+      executor->run(numJobs, [&](size_t job) {
+        size_t begin = std::min(numNodes, job * wordsPerJob * 64);
+        size_t end = std::min(numNodes, (job + 1) * wordsPerJob * 64);
+        for (size_t node = begin; node < end; ++node) {
+          if (state.test(node)) {
+            continue;
+          }
+          for (Index includer : includers.successors(node)) {
+            if (inFrontier.test(includer)) {
+              state.set(node);
+              next[job].push_back(node);
+              break;
+            }
+          }
+        }
+      });
+    } else {
+      // Every node of the frontier claims its includes not visited yet
+      size_t numJobs =
+          numJobsFor(executor, frontierIncludes, frontier.size());
+      size_t nodesPerJob = (frontier.size() + numJobs - 1) / numJobs;
+      next.resize(numJobs);
+      executor->run(numJobs, [&](size_t job) {
+        size_t begin = std::min(frontier.size(), job * nodesPerJob);
+        size_t end = std::min(frontier.size(), (job + 1) * nodesPerJob);
+        for (size_t i = begin; i < end; ++i) {
+          for (Index successor : includes.successors(frontier[i])) {
+            if (state.set(successor)) {
+              next[job].push_back(successor);
+            }
+          }
+        }
+      });
+    }
+
+    frontier.clear();
+    for (const auto &nodes : next) {
+      frontier.insert(frontier.end(), nodes.begin(), nodes.end());
+    }
+  }
+}
+
+llvm::BitVector
+ParallelIncludeGraphTraversal::reach(llvm::ArrayRef<Index> sources) const {
+  size_t numNodes = graph->numNodes();
+  State state(numNodes, graph->getIncludeGraph().numEdges());
+  visit(sources, state, nullptr);
+
+  llvm::BitVector reached(numNodes);
+  for (Index node = 0; node < numNodes; ++node) {
+    if (state.test(node)) {
+      reached.set(node);
+    }
+  }
+  return reached;
+}
+
+std::vector<Index> ParallelIncludeGraphTraversal::firstReachingSource(
+    llvm::ArrayRef<Index> sources) const {
+  size_t numNodes = graph->numNodes();
+  State state(numNodes, graph->getIncludeGraph().numEdges());
+  std::vector<Index> first(numNodes, sources.size());
+
+  // What the sources before reached is closed under includes, so each
+  // traversal only finds the nodes no source before reaches
+  std::vector<Index> visited;
+  for (size_t i = 0; i < sources.size(); ++i) {
+    visited.clear();
+    visit(sources.slice(i, 1), state, &visited);
+    for (Index node : visited) {
+      first[node] = i;
+    }
+  }
+  return first;
+}
+
+std::vector<llvm::BitVector> ParallelIncludeGraphTraversal::reachingSources(
+    llvm::ArrayRef<Index> sources, llvm::ArrayRef<Index> targets) const {
+  const IncludeGraphCSR::Graph &includes = graph->getIncludeGraph();
+  size_t numNodes = graph->numNodes();
+  std::vector<llvm::BitVector> result(targets.size(),
+                                      llvm::BitVector(sources.size()));
+
+  // The word of each node, and the last level it was put in the
+  // frontier of, so that the nodes that gain bits from many others in a
+  // level are only followed once in the next. The workers are joined at
+  // the end of every level, so relaxed operations are enough.
+  std::vector<std::atomic<uint64_t>> labels(numNodes);
+  std::vector<std::atomic<uint32_t>> queuedAt(numNodes);
+  uint32_t level = 0;
+
+  for (size_t batch = 0; batch < sources.size(); batch += 64) {
+    size_t batchSize = std::min<size_t>(64, sources.size() - batch);
+    for (auto &label : labels) {
+      label.store(0, std::memory_order_relaxed);
+    }
+
+    std::vector<Index> frontier;
+    ++level;
+    for (size_t i = 0; i < batchSize; ++i) {
+      Index source = sources[batch + i];
+      labels[source].fetch_or(uint64_t(1) << i, std::memory_order_relaxed);
+      if (queuedAt[source].exchange(level, std::memory_order_relaxed) !=
+          level) {
+        frontier.push_back(source);
+      }
+    }
+
+    while (!frontier.empty()) {
+      ++level;
+      size_t frontierIncludes = 0;
+      for (Index node : frontier) {
+        frontierIncludes += degree(includes, node);
+      }
+
+      size_t numJobs =
+          numJobsFor(executor, frontierIncludes, frontier.size());
+      size_t nodesPerJob = (frontier.size() + numJobs - 1) / numJobs;
+      std::vector<std::vector<Index>> next(numJobs);
+      executor->run(numJobs, [&](size_t job) {
+        size_t begin = std::min(frontier.size(), job * nodesPerJob);
+        size_t end = std::min(frontier.size(), (job + 1) * nodesPerJob);
+        for (size_t i = begin; i < end; ++i) {
+          uint64_t label =
+              labels[frontier[i]].load(std::memory_order_relaxed);
+          for (Index successor : includes.successors(frontier[i])) {
+            // Most includes bring no new bits, which a load tells
+            // without writing to the word
+            std::atomic<uint64_t> &word = labels[successor];
+            if ((word.load(std::memory_order_relaxed) & label) == label) {
+              continue;
+            }
+            uint64_t old = word.fetch_or(label, std::memory_order_relaxed);
+            if ((old & label) != label &&
+                queuedAt[successor].exchange(
+                    level, std::memory_order_relaxed) != level) {
+              next[job].push_back(successor);
+            }
+          }
+        }
+      });
+
+      frontier.clear();
+      for (const auto &nodes : next) {
+        frontier.insert(frontier.end(), nodes.begin(), nodes.end());
+      }
+    }
+
+    for (size_t t = 0; t < targets.size(); ++t) {
+      uint64_t label = labels[targets[t]].load(std::memory_order_relaxed);
+      for (size_t i = 0; i < batchSize; ++i) {
+        if (label & (uint64_t(1) << i)) {
+          result[t].set(batch + i);
+        }
+      }
+    }
+  }
+  return result;
+}
+
+} // namespace clangmetatool
+
+// ----------------------------------------------------------------------------
+// Copyright 2026 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
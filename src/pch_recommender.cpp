@@ -0,0 +1,270 @@
+#include <clangmetatool/pch_recommender.h>
+
+#include <clang/Basic/FileManager.h>
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/Format.h>
+
+#include <clangmetatool/include_graph_csr.h>
+#include <clangmetatool/include_graph_dependencies.h>
+
+#include <algorithm>
+#include <cinttypes>
+#include <cmath>
+#include <set>
+
+namespace clangmetatool {
+
+namespace {
+
+typedef IncludeGraphCSR::Index Index;
+
+/**
+ * Path of every file of the data, preferring the real path of its file
+ * entry when known.
+ */
+std::map<types::FileUID, std::string>
+realPathsOf(const collectors::IncludeGraphData *data) {
+  std::map<types::FileUID, std::string> paths =
+      IncludeGraphDependencies::filePaths(data);
+  for (const auto &p : data->fuid2entry) {
+    if (p.second && !p.second->tryGetRealPathName().empty()) {
+      paths[p.first] = p.second->tryGetRealPathName().str();
+    }
+  }
+  return paths;
+}
+
+std::map<types::FileUID, PCHRecommender::FileStatus>
+statAll(const std::map<types::FileUID, std::string> &paths) {
+  std::map<types::FileUID, PCHRecommender::FileStatus> files;
+  for (const auto &p : paths) {
+    llvm::sys::fs::file_status status;
+    if (!llvm::sys::fs::status(p.second, status)) {
+      PCHRecommender::FileStatus &file = files[p.first];
+      file.bytes = status.getSize();
+      file.modified = status.getLastModificationTime();
+    }
+  }
+  return files;
+}
+
+} // namespace
+
+PCHRecommender::PCHRecommender(const collectors::IncludeGraphData *data,
+                               const Options &options)
+    : PCHRecommender(data, statAll(realPathsOf(data)), options,
+                     std::chrono::system_clock::now()) {}
+
+PCHRecommender::PCHRecommender(const collectors::IncludeGraphData *data)
+    : PCHRecommender(data, Options()) {}
+
+PCHRecommender::PCHRecommender(
+    const collectors::IncludeGraphData *data,
+    const std::map<types::FileUID, FileStatus> &files,
+    const Options &options, llvm::sys::TimePoint<> now) {
+  std::map<types::FileUID, std::string> paths = realPathsOf(data);
+  IncludeGraphCSR csr(data);
+  const IncludeGraphCSR::Graph &graph = csr.getIncludeGraph();
+  size_t numNodes = csr.numNodes();
+
+  auto isSystem = [data](types::FileUID uid) {
+    auto system = data->is_system.find(uid);
+    return system != data->is_system.end() && system->second;
+  };
+  auto statusOf = [&files](types::FileUID uid) {
+    auto file = files.find(uid);
+    return file == files.end() ? FileStatus() : file->second;
+  };
+
+  std::vector<bool> included(numNodes, false);
+  std::vector<bool> includedByProject(numNodes, false);
+  for (Index node = 0; node < numNodes; ++node) {
+    bool fromProject = !isSystem(csr.getUID(node));
+    for (Index successor : graph.successors(node)) {
+      included[successor] = true;
+      if (fromProject) {
+        includedByProject[successor] = true;
+      }
+    }
+  }
+
+  std::vector<size_t> translationUnits(numNodes, 0);
+  for (Index root = 0; root < numNodes; ++root) {
+    if (included[root]) {
+      continue;
+    }
+    ++numTranslationUnits;
+    for (types::FileUID uid :
+         IncludeGraphDependencies::collectAllIncludes(&csr, csr.getUID(root))) {
+      Index reached;
+      if (csr.findIndex(uid, reached)) {
+        ++translationUnits[reached];
+      }
+    }
+  }
+
+  size_t minTranslationUnits = std::max<size_t>(
+      1, static_cast<size_t>(std::ceil(options.minTranslationUnitFraction *
+                                       numTranslationUnits)));
+
+  std::map<types::FileUID, std::set<types::FileUID>> closures;
+  for (Index node = 0; node < numNodes; ++node) {
+    if (!includedByProject[node] ||
+        translationUnits[node] < minTranslationUnits) {
+      continue;
+    }
+
+    Candidate candidate;
+    candidate.uid = csr.getUID(node);
+    candidate.path = paths[candidate.uid];
+    candidate.isSystem = isSystem(candidate.uid);
+    candidate.translationUnits = translationUnits[node];
+
+    std::set<types::FileUID> closure =
+        IncludeGraphDependencies::collectAllIncludes(&csr, candidate.uid);
+    bool changed = false;
+    llvm::sys::TimePoint<> lastChange;
+    for (types::FileUID uid : closure) {
+      FileStatus status = statusOf(uid);
+      candidate.closureBytes += status.bytes;
+      if (!isSystem(uid) && (!changed || status.modified > lastChange)) {
+        changed = true;
+        lastChange = status.modified;
+      }
+    }
+    if (changed) {
+      candidate.age =
+          std::chrono::duration_cast<std::chrono::seconds>(now - lastChange);
+      if (candidate.age < options.minStableAge) {
+        continue;
+      }
+    }
+
+    closures[candidate.uid] = std::move(closure);
+    candidates.push_back(candidate);
+  }
+  std::stable_sort(candidates.begin(), candidates.end(),
+                   [](const Candidate &a, const Candidate &b) {
+                     return a.closureBytes * a.translationUnits >
+                            b.closureBytes * b.translationUnits;
+                   });
+
+  // Pick the candidates in order, each adding what it includes that the
+  // picked ones don't include yet
+  std::set<types::FileUID> contents;
+  for (Candidate &candidate : candidates) {
+    if (contents.count(candidate.uid)) {
+      continue;
+    }
+    const std::set<types::FileUID> &closure = closures[candidate.uid];
+    uint64_t added = 0;
+    for (types::FileUID uid : closure) {
+      if (!contents.count(uid)) {
+        added += statusOf(uid).bytes;
+      }
+    }
+    if (options.maxBytes && bytes + added > options.maxBytes) {
+      continue;
+    }
+    candidate.selected = true;
+    bytes += added;
+    contents.insert(closure.begin(), closure.end());
+  }
+
+  // A header picked before one that includes it doesn't need to be
+  // included by the precompiled header
+  for (const Candidate &candidate : candidates) {
+    if (!candidate.selected) {
+      continue;
+    }
+    bool redundant = false;
+    for (const Candidate &other : candidates) {
+      if (other.selected && other.uid != candidate.uid &&
+          closures[other.uid].count(candidate.uid) &&
+          !closures[candidate.uid].count(other.uid)) {
+        redundant = true;
+        break;
+      }
+    }
+    if (!redundant) {
+      selection.push_back(candidate);
+    }
+  }
+  std::sort(selection.begin(), selection.end(),
+            [](const Candidate &a, const Candidate &b) {
+              if (a.isSystem != b.isSystem) {
+                return a.isSystem;
+              }
+              return a.path < b.path;
+            });
+
+  for (Index root = 0; root < numNodes; ++root) {
+    if (included[root]) {
+      continue;
+    }
+    uint64_t &saved = savedBytes[csr.getUID(root)];
+    for (types::FileUID uid :
+         IncludeGraphDependencies::collectAllIncludes(&csr, csr.getUID(root))) {
+      if (contents.count(uid)) {
+        saved += statusOf(uid).bytes;
+      }
+    }
+  }
+}
+
+double PCHRecommender::getAverageSavedBytes() const {
+  if (savedBytes.empty()) {
+    return 0;
+  }
+  uint64_t total = 0;
+  for (const auto &p : savedBytes) {
+    total += p.second;
+  }
+  return static_cast<double>(total) / savedBytes.size();
+}
+
+void PCHRecommender::writeHeader(llvm::raw_ostream &os) const {
+  os << "// Precompiled header suggested for " << numTranslationUnits
+     << " translation units,\n"
+     << llvm::format("// saving %.0f bytes of parsing per translation unit\n",
+                     getAverageSavedBytes());
+  for (const Candidate &candidate : selection) {
+    os << "#include \"" << candidate.path << "\"\n";
+  }
+}
+
+void PCHRecommender::printReport(llvm::raw_ostream &os, size_t limit) const {
+  os << "Precompiled header candidates over " << numTranslationUnits
+     << " translation units, as closure bytes x translation units and"
+        " days unchanged:\n";
+  for (size_t i = 0; i < candidates.size() && i < limit; ++i) {
+    const Candidate &candidate = candidates[i];
+    os << llvm::format("%c %12" PRIu64 " x %6zu %8" PRId64 "d  ",
+                       candidate.selected ? '*' : ' ', candidate.closureBytes,
+                       candidate.translationUnits,
+                       static_cast<int64_t>(candidate.age.count() / 86400))
+       << candidate.path << "\n";
+  }
+  os << "Suggested precompiled header: " << selection.size() << " headers, "
+     << bytes << " bytes, "
+     << llvm::format("%.0f", getAverageSavedBytes())
+     << " bytes saved per translation unit\n";
+}
+
+} // namespace clangmetatool
+
+// ----------------------------------------------------------------------------
+// Copyright 2026 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
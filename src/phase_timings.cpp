@@ -0,0 +1,55 @@
+#include <clangmetatool/phase_timings.h>
+
+#include <llvm/Support/JSON.h>
+
+#include <cstdint>
+
+namespace clangmetatool {
+
+void PhaseTimings::writeJSON(llvm::raw_ostream &os) const {
+  llvm::json::Object object{
+      {"file", mainFile},
+      {"setup", setupSeconds},
+      {"frontend", frontendSeconds},
+      {"match", matchSeconds},
+      {"postProcessing", postProcessingSeconds},
+      {"total", totalSeconds},
+      {"processPeakMemoryKB", static_cast<int64_t>(processPeakMemoryKB)},
+  };
+  os << llvm::json::Value(std::move(object)) << "\n";
+}
+
+PhaseTimingsLog::PhaseTimingsLog(llvm::raw_ostream &jsonLines)
+    : jsonLines(&jsonLines) {}
+
+void PhaseTimingsLog::record(const PhaseTimings &t) {
+  std::lock_guard<std::mutex> lock(mutex);
+  timings.push_back(t);
+  if (jsonLines) {
+    t.writeJSON(*jsonLines);
+    jsonLines->flush();
+  }
+}
+
+std::vector<PhaseTimings> PhaseTimingsLog::getTimings() const {
+  std::lock_guard<std::mutex> lock(mutex);
+  return timings;
+}
+
+} // namespace clangmetatool
+
+// ----------------------------------------------------------------------------
+// Copyright 2026 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,251 @@
+#include <clangmetatool/project_include_graph.h>
+
+#include <clang/Basic/FileManager.h>
+#include <llvm/ADT/SmallString.h>
+#include <llvm/ADT/StringRef.h>
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/MemoryBuffer.h>
+#include <llvm/Support/Path.h>
+#include <llvm/Support/xxhash.h>
+
+#include <algorithm>
+#include <cinttypes>
+#include <cstdio>
+
+namespace clangmetatool {
+
+namespace {
+
+using types::FileUID;
+
+/**
+ * Absolute path of the file, with symbolic links resolved when it
+ * exists.
+ */
+std::string canonicalPath(llvm::StringRef path) {
+  llvm::SmallString<256> result;
+  if (!llvm::sys::fs::real_path(path, result)) {
+    return result.str().str();
+  }
+  result = path;
+  llvm::sys::fs::make_absolute(result);
+  llvm::sys::path::remove_dots(result, true);
+  return result.str().str();
+}
+
+/**
+ * Path of the file with the given uid in the translation unit, or an
+ * empty string if it is not known.
+ */
+std::string pathOf(const collectors::IncludeGraphData *data,
+                   const clang::SourceManager &sm, FileUID uid) {
+  auto entry = data->fuid2entry.find(uid);
+  if (entry != data->fuid2entry.end() && entry->second) {
+    llvm::StringRef realPath = entry->second->tryGetRealPathName();
+    if (!realPath.empty()) {
+      return realPath.str();
+    }
+  }
+
+  const clang::FileEntry *main = sm.getFileEntryForID(sm.getMainFileID());
+  if (main && main->getUID() == uid) {
+    return sm.getFilename(sm.getLocForStartOfFile(sm.getMainFileID())).str();
+  }
+
+  auto name = data->fuid2name.find(uid);
+  if (name != data->fuid2name.end()) {
+    return name->second;
+  }
+  return std::string();
+}
+
+} // namespace
+
+ProjectIncludeGraph::ProjectIncludeGraph(FileIdentity identity)
+    : identity(identity) {}
+
+std::pair<std::string, std::string>
+ProjectIncludeGraph::keyOf(const std::string &path) {
+  {
+    std::lock_guard<std::mutex> lock(keysMutex);
+    auto it = keys.find(path);
+    if (it != keys.end()) {
+      return it->second;
+    }
+  }
+
+  std::string canonical = canonicalPath(path);
+  std::string key = canonical;
+  if (identity == FileIdentity::ContentHash) {
+    auto buffer = llvm::MemoryBuffer::getFile(canonical);
+    if (buffer) {
+      // Different headers often have the same content, empty or stub
+      // ones for instance, only copies of a file also have its name
+      char hex[17];
+      snprintf(hex, sizeof(hex), "%016" PRIx64,
+               llvm::xxHash64((*buffer)->getBuffer()));
+      key = std::string(hex) + " " +
+            llvm::sys::path::filename(canonical).str();
+    }
+  }
+
+  std::lock_guard<std::mutex> lock(keysMutex);
+  auto &result = keys[path];
+  result = std::make_pair(key, canonical);
+  return result;
+}
+
+void ProjectIncludeGraph::add(const collectors::IncludeGraphData *data,
+                              const clang::SourceManager &sm) {
+  // Read and hash the files first, the lock is only held for merging
+  // the edges
+  std::set<FileUID> uids;
+  for (const auto *graph :
+       {&data->include_graph, &data->use_graph, &data->definition_uses}) {
+    for (const auto &edge : *graph) {
+      uids.insert(edge.first);
+      uids.insert(edge.second);
+    }
+  }
+  for (const auto &p : data->usage_reference_count) {
+    uids.insert(p.first.first);
+    uids.insert(p.first.second);
+  }
+
+  std::map<FileUID, std::pair<std::string, std::string>> files;
+  for (FileUID uid : uids) {
+    std::string path = pathOf(data, sm, uid);
+    if (!path.empty()) {
+      files[uid] = keyOf(path);
+    }
+  }
+
+  std::lock_guard<std::mutex> lock(mutex);
+  ++numTranslationUnits;
+  if (!(data->details &
+        collectors::IncludeGraphData::ForwardDeclarationDetails)) {
+    definitionUsesComplete = false;
+  }
+
+  std::map<FileUID, FileID> local;
+  for (const auto &p : files) {
+    auto inserted = ids.emplace(p.second.first, paths.size());
+    if (inserted.second) {
+      paths.push_back(p.second.second);
+      isSystem.push_back(false);
+    }
+    FileID id = inserted.first->second;
+    local[p.first] = id;
+
+    // Identical copies share a key, the first of their paths is kept
+    // whatever the order they were seen in.
+    paths[id] = std::min(paths[id], p.second.second);
+
+    auto system = data->is_system.find(p.first);
+    if (system != data->is_system.end() && system->second) {
+      isSystem[id] = true;
+    }
+  }
+
+  auto translate = [&local](const types::FileGraphEdge &edge, Edge &result) {
+    auto from = local.find(edge.first);
+    auto to = local.find(edge.second);
+    if (from == local.end() || to == local.end()) {
+      return false;
+    }
+    result = Edge(from->second, to->second);
+    return true;
+  };
+
+  Edge edge;
+  for (const auto &e : data->include_graph) {
+    if (translate(e, edge)) {
+      includeGraph.insert(edge);
+    }
+  }
+  for (const auto &e : data->use_graph) {
+    if (translate(e, edge)) {
+      useGraph.insert(edge);
+    }
+  }
+  for (const auto &e : data->definition_uses) {
+    if (translate(e, edge)) {
+      definitionUses.insert(edge);
+    }
+  }
+  for (const auto &p : data->usage_reference_count) {
+    if (translate(p.first, edge)) {
+      size_t &count = usageReferenceCount[edge];
+      count = std::max(count, p.second);
+    }
+  }
+}
+
+size_t ProjectIncludeGraph::getNumTranslationUnits() const {
+  std::lock_guard<std::mutex> lock(mutex);
+  return numTranslationUnits;
+}
+
+size_t ProjectIncludeGraph::getNumFiles() const {
+  std::lock_guard<std::mutex> lock(mutex);
+  return ids.size();
+}
+
+collectors::IncludeGraphData ProjectIncludeGraph::getData() const {
+  std::lock_guard<std::mutex> lock(mutex);
+
+  // Ids are handed out in the order files are first seen, which depends
+  // on the scheduling of the translation units, the uids of the result
+  // follow the order of the keys instead.
+  std::vector<FileUID> uid(ids.size());
+  FileUID next = 0;
+  for (const auto &p : ids) {
+    uid[p.second] = next++;
+  }
+
+  collectors::IncludeGraphData result;
+  result.details =
+      definitionUsesComplete
+          ? collectors::IncludeGraphData::ForwardDeclarationDetails
+          : collectors::IncludeGraphData::NoDetails;
+  for (FileID id = 0; id < paths.size(); ++id) {
+    result.fuid2name.emplace(uid[id], paths[id]);
+    result.name2fuid.emplace(paths[id], uid[id]);
+    result.path2fuid.emplace(paths[id], uid[id]);
+    result.is_system.emplace(uid[id], isSystem[id]);
+  }
+  for (const auto &e : includeGraph) {
+    result.include_graph.emplace(uid[e.first], uid[e.second]);
+    result.included_by[uid[e.second]].push_back(uid[e.first]);
+  }
+  for (const auto &e : useGraph) {
+    result.use_graph.emplace(uid[e.first], uid[e.second]);
+  }
+  for (const auto &e : definitionUses) {
+    result.definition_uses.emplace(uid[e.first], uid[e.second]);
+  }
+  for (const auto &p : usageReferenceCount) {
+    result.usage_reference_count.emplace(
+        types::FileGraphEdge(uid[p.first.first], uid[p.first.second]),
+        p.second);
+  }
+  return result;
+}
+
+} // namespace clangmetatool
+
+// ----------------------------------------------------------------------------
+// Copyright 2026 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,300 @@
+#include <clangmetatool/result_cache.h>
+
+#include <clang/Tooling/ReplacementsYaml.h>
+#include <llvm/ADT/SmallString.h>
+#include <llvm/Support/Error.h>
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/MD5.h>
+#include <llvm/Support/MemoryBuffer.h>
+#include <llvm/Support/Path.h>
+#include <llvm/Support/YAMLTraits.h>
+#include <llvm/Support/raw_ostream.h>
+#include <llvm/Support/xxhash.h>
+
+#include <cinttypes>
+#include <cstdio>
+#include <system_error>
+#include <tuple>
+#include <vector>
+
+namespace clangmetatool {
+
+namespace {
+
+/**
+ * First line of every entry, bump it whenever the format changes.
+ */
+const char *const entryMagic = "clangmetatool-result-cache 2";
+
+/**
+ * Proxy file system that records the absolute path of every file that
+ * is opened through it, and of every path that was looked up in vain,
+ * such as the include directories searched before the one holding a
+ * header.
+ */
+class InputRecordingFileSystem : public llvm::vfs::ProxyFileSystem {
+private:
+  std::set<std::string> &inputs;
+  std::set<std::string> &missing;
+
+  void record(const llvm::Twine &path, std::error_code ec) {
+    if (ec && ec != std::errc::no_such_file_or_directory) {
+      return;
+    }
+    llvm::SmallString<256> absolute;
+    path.toVector(absolute);
+    if (makeAbsolute(absolute)) {
+      return;
+    }
+    llvm::sys::path::remove_dots(absolute, true);
+    (ec ? missing : inputs).insert(absolute.str().str());
+  }
+
+public:
+  InputRecordingFileSystem(llvm::IntrusiveRefCntPtr<llvm::vfs::FileSystem> fs,
+                           std::set<std::string> &inputs,
+                           std::set<std::string> &missing)
+      : ProxyFileSystem(std::move(fs)), inputs(inputs), missing(missing) {}
+
+  llvm::ErrorOr<llvm::vfs::Status> status(const llvm::Twine &path) override {
+    auto result = ProxyFileSystem::status(path);
+    if (!result) {
+      record(path, result.getError());
+    }
+    return result;
+  }
+
+  llvm::ErrorOr<std::unique_ptr<llvm::vfs::File>>
+  openFileForRead(const llvm::Twine &path) override {
+    auto file = ProxyFileSystem::openFileForRead(path);
+    record(path, file.getError());
+    return file;
+  }
+};
+
+/**
+ * Size and modification time of a file, used to avoid hashing files
+ * that were not touched since the entry was written.
+ */
+bool getStamp(const std::string &path, uint64_t &size, int64_t &mtime) {
+  llvm::sys::fs::file_status status;
+  if (llvm::sys::fs::status(path, status)) {
+    return false;
+  }
+  size = status.getSize();
+  mtime = status.getLastModificationTime().time_since_epoch().count();
+  return true;
+}
+
+} // namespace
+
+ResultCache::ResultCache(const std::string &directory,
+                         const std::string &toolKey)
+    : directory(directory), toolKey(toolKey) {
+  llvm::sys::fs::create_directories(directory);
+}
+
+std::string
+ResultCache::entryPath(const clang::tooling::CompilationDatabase &compilations,
+                       const std::string &sourcePath) const {
+  llvm::MD5 hash;
+  auto update = [&](llvm::StringRef s) {
+    // include the terminator so that ("ab", "c") and ("a", "bc") differ
+    hash.update(s);
+    hash.update(llvm::StringRef("", 1));
+  };
+  update(toolKey);
+  update(sourcePath);
+  for (const auto &command : compilations.getCompileCommands(sourcePath)) {
+    update(command.Directory);
+    update(command.Filename);
+    for (const auto &arg : command.CommandLine) {
+      update(arg);
+    }
+  }
+
+  llvm::MD5::MD5Result result;
+  hash.final(result);
+  llvm::SmallString<32> hex;
+  llvm::MD5::stringifyResult(result, hex);
+
+  llvm::SmallString<256> path(directory);
+  llvm::sys::path::append(path, hex.str() + ".yaml");
+  return path.str().str();
+}
+
+std::string ResultCache::contentHash(const std::string &path) {
+  {
+    std::lock_guard<std::mutex> lock(contentHashesMutex);
+    auto it = contentHashes.find(path);
+    if (it != contentHashes.end()) {
+      return it->second;
+    }
+  }
+
+  std::string hash;
+  auto buffer = llvm::MemoryBuffer::getFile(path);
+  if (buffer) {
+    char hex[17];
+    snprintf(hex, sizeof(hex), "%016" PRIx64,
+             llvm::xxHash64((*buffer)->getBuffer()));
+    hash = hex;
+  }
+
+  std::lock_guard<std::mutex> lock(contentHashesMutex);
+  contentHashes[path] = hash;
+  return hash;
+}
+
+bool ResultCache::lookup(
+    const clang::tooling::CompilationDatabase &compilations,
+    const std::string &sourcePath,
+    std::map<std::string, clang::tooling::Replacements> &replacements) {
+  auto buffer =
+      llvm::MemoryBuffer::getFile(entryPath(compilations, sourcePath));
+  if (!buffer) {
+    return false;
+  }
+
+  // An entry is made of the magic line, the number of inputs, one line
+  // per input with its hash, size, modification time and path, the
+  // number of missing inputs, one line per missing path, and the
+  // replacements as a YAML document.
+  llvm::StringRef rest = (*buffer)->getBuffer();
+  llvm::StringRef line;
+  std::tie(line, rest) = rest.split('\n');
+  if (line != entryMagic) {
+    return false;
+  }
+
+  size_t numInputs;
+  std::tie(line, rest) = rest.split('\n');
+  if (line.getAsInteger(10, numInputs)) {
+    return false;
+  }
+
+  for (size_t i = 0; i < numInputs; ++i) {
+    std::tie(line, rest) = rest.split('\n');
+
+    llvm::StringRef hash, size, mtime, path;
+    std::tie(hash, line) = line.split(' ');
+    std::tie(size, line) = line.split(' ');
+    std::tie(mtime, path) = line.split(' ');
+
+    uint64_t storedSize, currentSize;
+    int64_t storedMtime, currentMtime;
+    if (size.getAsInteger(10, storedSize) ||
+        mtime.getAsInteger(10, storedMtime) ||
+        !getStamp(path.str(), currentSize, currentMtime)) {
+      return false;
+    }
+    if (storedSize == currentSize && storedMtime == currentMtime) {
+      continue;
+    }
+    if (contentHash(path.str()) != hash) {
+      return false;
+    }
+  }
+
+  // A file that appeared where one was looked for would be used now
+  size_t numMissing;
+  std::tie(line, rest) = rest.split('\n');
+  if (line.getAsInteger(10, numMissing)) {
+    return false;
+  }
+  for (size_t i = 0; i < numMissing; ++i) {
+    std::tie(line, rest) = rest.split('\n');
+    if (llvm::sys::fs::exists(line)) {
+      return false;
+    }
+  }
+
+  clang::tooling::TranslationUnitReplacements TUR;
+  llvm::yaml::Input yaml_in(rest);
+  yaml_in >> TUR;
+  if (yaml_in.error()) {
+    return false;
+  }
+  for (const auto &r : TUR.Replacements) {
+    llvm::consumeError(replacements[r.getFilePath().str()].add(r));
+  }
+  return true;
+}
+
+void ResultCache::store(
+    const clang::tooling::CompilationDatabase &compilations,
+    const std::string &sourcePath, const std::set<std::string> &inputs,
+    const std::set<std::string> &missing,
+    const std::map<std::string, clang::tooling::Replacements> &replacements) {
+  std::string entry = entryPath(compilations, sourcePath);
+
+  // Write to a temporary file and move it in place, so that concurrent
+  // runs never see a partial entry.
+  int fd;
+  llvm::SmallString<256> tmpPath;
+  if (llvm::sys::fs::createUniqueFile(entry + ".tmp-%%%%%%%%", fd, tmpPath)) {
+    return;
+  }
+
+  {
+    llvm::raw_fd_ostream os(fd, /*shouldClose=*/true);
+    os << entryMagic << "\n" << inputs.size() << "\n";
+    for (const auto &path : inputs) {
+      uint64_t size = 0;
+      int64_t mtime = 0;
+      getStamp(path, size, mtime);
+      os << contentHash(path) << " " << size << " " << mtime << " " << path
+         << "\n";
+    }
+    os << missing.size() << "\n";
+    for (const auto &path : missing) {
+      os << path << "\n";
+    }
+
+    clang::tooling::TranslationUnitReplacements TUR;
+    TUR.MainSourceFile = sourcePath;
+    for (const auto &p : replacements) {
+      TUR.Replacements.insert(TUR.Replacements.end(), p.second.begin(),
+                              p.second.end());
+    }
+    llvm::yaml::Output yaml_out(os);
+    yaml_out << TUR;
+
+    os.flush();
+    if (os.has_error()) {
+      os.clear_error();
+      llvm::sys::fs::remove(tmpPath);
+      return;
+    }
+  }
+
+  if (llvm::sys::fs::rename(tmpPath, entry)) {
+    llvm::sys::fs::remove(tmpPath);
+  }
+}
+
+llvm::IntrusiveRefCntPtr<llvm::vfs::FileSystem>
+ResultCache::recordInputs(llvm::IntrusiveRefCntPtr<llvm::vfs::FileSystem> fs,
+                          std::set<std::string> &inputs,
+                          std::set<std::string> &missing) {
+  return llvm::IntrusiveRefCntPtr<llvm::vfs::FileSystem>(
+      new InputRecordingFileSystem(std::move(fs), inputs, missing));
+}
+
+} // namespace clangmetatool
+
+// ----------------------------------------------------------------------------
+// Copyright 2026 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,275 @@
+#include <clangmetatool/sharded_executor.h>
+
+#include <llvm/Support/ErrorHandling.h>
+#include <llvm/Support/raw_ostream.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include <poll.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace clangmetatool {
+
+namespace {
+
+/**
+ * State kept by the parent for every running worker process.
+ */
+struct Worker {
+  pid_t pid = -1;
+  int fd = -1;
+
+  // jobs of the shard that were not reported yet, in the order the
+  // worker processes them
+  std::deque<size_t> pending;
+
+  // data received from the worker and not yet parsed
+  std::string buffer;
+};
+
+bool writeAll(int fd, const char *data, size_t size) {
+  while (size > 0) {
+    ssize_t written = write(fd, data, size);
+    if (written < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return false;
+    }
+    data += written;
+    size -= written;
+  }
+  return true;
+}
+
+bool writeRecord(int fd, const std::string &header,
+                 const std::string &payload = "") {
+  return writeAll(fd, header.data(), header.size()) &&
+         writeAll(fd, payload.data(), payload.size());
+}
+
+/**
+ * Body of a worker process. Every job is reported with a
+ * "<index> <status> <size>\n" record followed by `size` bytes of output
+ * once it is done.
+ */
+[[noreturn]] void runWorker(int fd, const std::deque<size_t> &jobs,
+                            const ShardedExecutor::Job &job) {
+  for (size_t index : jobs) {
+    std::string output;
+    int status = job(index, output);
+    if (!writeRecord(fd,
+                     std::to_string(index) + " " +
+                         std::to_string(status) + " " +
+                         std::to_string(output.size()) + "\n",
+                     output)) {
+      _exit(1);
+    }
+  }
+  close(fd);
+  // Skip the destructors of global objects, those belong to the parent.
+  _exit(0);
+}
+
+/**
+ * Start a worker process for the pending jobs of the given worker.
+ * Returns false, after saying why on stderr, if it could not be started.
+ */
+bool spawn(Worker &w, const std::vector<Worker> &workers,
+           const ShardedExecutor::Job &job) {
+  int fds[2];
+  if (pipe(fds) != 0) {
+    llvm::errs() << "could not create pipe for worker process: "
+                 << strerror(errno) << "\n";
+    return false;
+  }
+
+  // Don't let buffered output be written by both processes
+  llvm::outs().flush();
+  std::cout.flush();
+
+  pid_t pid = fork();
+  if (pid < 0) {
+    llvm::errs() << "could not fork worker process: " << strerror(errno)
+                 << "\n";
+    close(fds[0]);
+    close(fds[1]);
+    return false;
+  }
+  if (pid == 0) {
+    close(fds[0]);
+    for (const Worker &other : workers) {
+      if (other.fd >= 0) {
+        close(other.fd);
+      }
+    }
+    runWorker(fds[1], w.pending, job);
+  }
+
+  close(fds[1]);
+  w.pid = pid;
+  w.fd = fds[0];
+  w.buffer.clear();
+  return true;
+}
+
+/**
+ * Start a worker process for the pending jobs of the given worker, or
+ * report all of them as not started if that fails. Returns whether a
+ * worker is running.
+ */
+bool start(Worker &w, const std::vector<Worker> &workers,
+           const ShardedExecutor::Job &job,
+           const ShardedExecutor::ResultHandler &onResult) {
+  if (spawn(w, workers, job)) {
+    return true;
+  }
+  for (size_t index : w.pending) {
+    onResult(index, ShardedExecutor::notStartedStatus, "");
+  }
+  w.pending.clear();
+  return false;
+}
+
+/**
+ * Parse the complete records in the buffer of the worker, reporting the
+ * jobs that finished.
+ */
+void parseRecords(Worker &w, const ShardedExecutor::ResultHandler &onResult) {
+  size_t pos = 0;
+  while (true) {
+    size_t eol = w.buffer.find('\n', pos);
+    if (eol == std::string::npos) {
+      break;
+    }
+    std::string header = w.buffer.substr(pos, eol - pos);
+    size_t index;
+    int status;
+    size_t size;
+    if (sscanf(header.c_str(), "%zu %d %zu", &index, &status, &size) != 3) {
+      llvm::report_fatal_error("malformed record from worker process");
+    }
+    if (w.buffer.size() - (eol + 1) < size) {
+      // wait for the rest of the output
+      break;
+    }
+    assert(!w.pending.empty() && w.pending.front() == index);
+    onResult(index, status, w.buffer.substr(eol + 1, size));
+    w.pending.pop_front();
+    pos = eol + 1 + size;
+  }
+  w.buffer.erase(0, pos);
+}
+
+} // namespace
+
+ShardedExecutor::ShardedExecutor(unsigned numWorkers)
+    : numWorkers(numWorkers) {
+  if (this->numWorkers == 0) {
+    this->numWorkers = std::max(1u, std::thread::hardware_concurrency());
+  }
+}
+
+unsigned ShardedExecutor::getNumWorkers() const { return numWorkers; }
+
+void ShardedExecutor::run(size_t numJobs, const Job &job,
+                          const ResultHandler &onResult) const {
+  std::vector<Worker> workers(std::min<size_t>(numWorkers, numJobs));
+  for (size_t i = 0; i < numJobs; ++i) {
+    workers[i % workers.size()].pending.push_back(i);
+  }
+  size_t running = 0;
+  for (Worker &w : workers) {
+    if (start(w, workers, job, onResult)) {
+      ++running;
+    }
+  }
+
+  while (running > 0) {
+    std::vector<pollfd> fds;
+    std::vector<Worker *> polled;
+    for (Worker &w : workers) {
+      if (w.fd >= 0) {
+        fds.push_back({w.fd, POLLIN, 0});
+        polled.push_back(&w);
+      }
+    }
+    if (poll(fds.data(), fds.size(), -1) < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      llvm::report_fatal_error("could not poll worker processes");
+    }
+
+    for (size_t i = 0; i < fds.size(); ++i) {
+      if (fds[i].revents == 0) {
+        continue;
+      }
+      Worker &w = *polled[i];
+
+      char data[65536];
+      ssize_t received = read(w.fd, data, sizeof(data));
+      if (received < 0) {
+        if (errno == EINTR) {
+          continue;
+        }
+        received = 0;
+      }
+      if (received > 0) {
+        w.buffer.append(data, received);
+        parseRecords(w, onResult);
+        continue;
+      }
+
+      // The worker is gone, either because it is done or because it died
+      close(w.fd);
+      w.fd = -1;
+      int waitStatus;
+      while (waitpid(w.pid, &waitStatus, 0) < 0 && errno == EINTR) {
+      }
+      if (w.pending.empty()) {
+        --running;
+        continue;
+      }
+
+      // Whatever job the worker was on killed it, report it and carry on
+      // with the rest of the shard in a new worker.
+      size_t index = w.pending.front();
+      w.pending.pop_front();
+      llvm::errs() << "worker process " << w.pid
+                   << " died while processing job " << index << "\n";
+      onResult(index, crashedStatus, "");
+      if (w.pending.empty() || !start(w, workers, job, onResult)) {
+        --running;
+      }
+    }
+  }
+}
+
+} // namespace clangmetatool
+
+// ----------------------------------------------------------------------------
+// Copyright 2026 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
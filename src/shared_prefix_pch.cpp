@@ -0,0 +1,476 @@
+#include <clangmetatool/shared_prefix_pch.h>
+
+#include <clangmetatool/parallel_executor.h>
+#include <clangmetatool/result_cache.h>
+
+#include <clang/Basic/LangOptions.h>
+#include <clang/Frontend/CompilerInstance.h>
+#include <clang/Frontend/FrontendActions.h>
+#include <clang/Frontend/PCHContainerOperations.h>
+#include <clang/Lex/Lexer.h>
+#include <clang/Tooling/Tooling.h>
+#include <llvm/ADT/SmallString.h>
+#include <llvm/ADT/StringRef.h>
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/MD5.h>
+#include <llvm/Support/MemoryBuffer.h>
+#include <llvm/Support/Path.h>
+#include <llvm/Support/raw_ostream.h>
+
+#include <algorithm>
+#include <cctype>
+#include <numeric>
+#include <tuple>
+#include <utility>
+
+namespace clangmetatool {
+
+namespace {
+
+/**
+ * GeneratePCHAction writing to a given file, whatever the command line
+ * says about the output.
+ */
+class PrefixPCHAction : public clang::GeneratePCHAction {
+private:
+  std::string outputFile;
+
+public:
+  explicit PrefixPCHAction(const std::string &outputFile)
+      : outputFile(outputFile) {}
+
+  bool BeginSourceFileAction(clang::CompilerInstance &ci) override {
+    ci.getFrontendOpts().OutputFile = outputFile;
+    return GeneratePCHAction::BeginSourceFileAction(ci);
+  }
+};
+
+class PrefixPCHActionFactory : public clang::tooling::FrontendActionFactory {
+private:
+  std::string outputFile;
+
+public:
+  explicit PrefixPCHActionFactory(const std::string &outputFile)
+      : outputFile(outputFile) {}
+
+  std::unique_ptr<clang::FrontendAction> create() override {
+    return std::make_unique<PrefixPCHAction>(outputFile);
+  }
+};
+
+/**
+ * A translation unit that may share its prefix with others.
+ */
+struct Candidate {
+  std::string sourcePath;
+  std::string absolutePath;
+  clang::tooling::CompileCommand command;
+
+  // identifies the translation units whose prefixes are compiled the
+  // same way
+  std::string key;
+
+  std::unique_ptr<llvm::MemoryBuffer> contents;
+
+  // the preamble, split where it can be cut
+  std::vector<llvm::StringRef> units;
+
+  // number of units shared with enough other translation units
+  size_t sharedUnits = 0;
+};
+
+std::string absolutePath(const std::string &path) {
+  llvm::SmallString<256> absolute(path);
+  llvm::sys::fs::make_absolute(absolute);
+  llvm::sys::path::remove_dots(absolute, true);
+  return absolute.str().str();
+}
+
+/**
+ * Split a preamble into complete lines, grouped so that no unit ends
+ * inside a conditional directive, a block comment or a continued line.
+ * An incomplete last line is left out.
+ */
+std::vector<llvm::StringRef> splitUnits(llvm::StringRef preamble) {
+  std::vector<llvm::StringRef> units;
+  size_t unitStart = 0;
+  size_t lineStart = 0;
+  int depth = 0;
+  bool inComment = false;
+
+  while (true) {
+    size_t lineEnd = preamble.find('\n', lineStart);
+    if (lineEnd == llvm::StringRef::npos) {
+      break;
+    }
+    llvm::StringRef line = preamble.slice(lineStart, lineEnd).rtrim('\r');
+
+    llvm::StringRef trimmed = line.ltrim();
+    if (!inComment && !trimmed.empty() && trimmed.front() == '#') {
+      llvm::StringRef directive = trimmed.drop_front().ltrim().take_while(
+          [](char c) { return isalpha(static_cast<unsigned char>(c)); });
+      if (directive == "if" || directive == "ifdef" ||
+          directive == "ifndef") {
+        ++depth;
+      } else if (directive == "endif") {
+        --depth;
+      }
+    }
+
+    for (size_t i = 0; i < line.size(); ++i) {
+      if (inComment) {
+        if (line[i] == '*' && i + 1 < line.size() && line[i + 1] == '/') {
+          inComment = false;
+          ++i;
+        }
+      } else if (line[i] == '/' && i + 1 < line.size()) {
+        if (line[i + 1] == '/') {
+          break;
+        }
+        if (line[i + 1] == '*') {
+          inComment = true;
+          ++i;
+        }
+      }
+    }
+
+    bool continued = !line.empty() && line.back() == '\\';
+    lineStart = lineEnd + 1;
+    if (depth == 0 && !inComment && !continued) {
+      units.push_back(preamble.slice(unitStart, lineStart));
+      unitStart = lineStart;
+    }
+  }
+  return units;
+}
+
+/**
+ * Everything in the compile command of a translation unit that affects
+ * how its prefix is compiled: the command without its input and output
+ * files, and the directory of the source file, which quoted includes
+ * are searched from.
+ */
+std::string commandKey(const clang::tooling::CompileCommand &command,
+                       const std::string &absolute) {
+  std::string key = command.Directory;
+  key += '\0';
+  key += llvm::sys::path::parent_path(absolute).str();
+  key += '\0';
+  const auto &args = command.CommandLine;
+  for (size_t i = 0; i < args.size(); ++i) {
+    if (args[i] == "-o") {
+      ++i;
+      continue;
+    }
+    if (args[i] == command.Filename || args[i] == absolute) {
+      continue;
+    }
+    key += args[i];
+    key += '\0';
+  }
+  return key;
+}
+
+/**
+ * Language to compile the prefix of the translation unit as: the one
+ * given with -x if any, otherwise the one implied by its extension.
+ */
+std::string headerLanguage(const clang::tooling::CompileCommand &command) {
+  std::string language;
+  const auto &args = command.CommandLine;
+  for (size_t i = 0; i < args.size(); ++i) {
+    llvm::StringRef arg(args[i]);
+    if (arg == "-x" && i + 1 < args.size()) {
+      language = args[++i];
+    } else if (arg.size() > 2 && arg.substr(0, 2) == "-x") {
+      language = arg.substr(2).str();
+    }
+  }
+
+  if (language.empty()) {
+    llvm::StringRef extension = llvm::sys::path::extension(command.Filename);
+    if (extension == ".c") {
+      language = "c";
+    } else if (extension == ".m") {
+      language = "objective-c";
+    } else if (extension == ".mm") {
+      language = "objective-c++";
+    } else {
+      language = "c++";
+    }
+  }
+
+  llvm::StringRef suffix("-header");
+  if (language.size() < suffix.size() ||
+      llvm::StringRef(language).take_back(suffix.size()) != suffix) {
+    language += suffix.str();
+  }
+  return language;
+}
+
+std::string md5Hex(llvm::StringRef data) {
+  llvm::MD5 hash;
+  hash.update(data);
+  llvm::MD5::MD5Result result;
+  hash.final(result);
+  llvm::SmallString<32> hex;
+  llvm::MD5::stringifyResult(result, hex);
+  return hex.str().str();
+}
+
+} // namespace
+
+SharedPrefixPCH::SharedPrefixPCH(const std::string &directory,
+                                 unsigned minGroupSize)
+    : directory(absolutePath(directory)),
+      minGroupSize(std::max(minGroupSize, 2u)) {
+  llvm::sys::fs::create_directories(this->directory);
+}
+
+size_t
+SharedPrefixPCH::build(const clang::tooling::CompilationDatabase &compilations,
+                       const std::vector<std::string> &sourcePaths,
+                       unsigned numThreads) {
+  clang::LangOptions langOpts;
+  langOpts.CPlusPlus = true;
+
+  std::vector<Candidate> candidates;
+  for (const auto &sourcePath : sourcePaths) {
+    auto commands = compilations.getCompileCommands(sourcePath);
+    if (commands.size() != 1) {
+      continue;
+    }
+
+    Candidate c;
+    c.sourcePath = sourcePath;
+    c.absolutePath = absolutePath(sourcePath);
+    auto buffer = llvm::MemoryBuffer::getFile(c.absolutePath);
+    if (!buffer) {
+      continue;
+    }
+    c.contents = std::move(*buffer);
+
+    auto bounds =
+        clang::Lexer::ComputePreamble(c.contents->getBuffer(), langOpts);
+    c.units = splitUnits(c.contents->getBuffer().substr(0, bounds.Size));
+    if (c.units.empty()) {
+      continue;
+    }
+    c.command = commands.front();
+    c.key = commandKey(c.command, c.absolutePath);
+    candidates.push_back(std::move(c));
+  }
+
+  // Sorting puts the translation units that share the longest prefixes
+  // next to each other, so the longest prefix a translation unit shares
+  // with minGroupSize - 1 others is found among its neighbours.
+  size_t n = candidates.size();
+  std::vector<size_t> order(n);
+  std::iota(order.begin(), order.end(), 0);
+  std::sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+    return std::tie(candidates[a].key, candidates[a].units) <
+           std::tie(candidates[b].key, candidates[b].units);
+  });
+
+  std::vector<size_t> common(n, 0);
+  for (size_t k = 0; k + 1 < n; ++k) {
+    const Candidate &a = candidates[order[k]];
+    const Candidate &b = candidates[order[k + 1]];
+    if (a.key != b.key) {
+      continue;
+    }
+    size_t shared = 0;
+    while (shared < a.units.size() && shared < b.units.size() &&
+           a.units[shared] == b.units[shared]) {
+      ++shared;
+    }
+    common[k] = shared;
+  }
+
+  size_t m = minGroupSize;
+  for (size_t k = 0; k + m <= n; ++k) {
+    // units shared by the window of m neighbours starting at k
+    size_t shared = common[k];
+    for (size_t j = k + 1; j + 1 < k + m; ++j) {
+      shared = std::min(shared, common[j]);
+    }
+    for (size_t j = k; j < k + m; ++j) {
+      Candidate &c = candidates[order[j]];
+      c.sharedUnits = std::max(c.sharedUnits, shared);
+    }
+  }
+
+  // Translation units that share the same prefix use the same PCH
+  std::map<std::pair<std::string, std::string>, std::vector<size_t>> groups;
+  for (size_t i = 0; i < n; ++i) {
+    Candidate &c = candidates[i];
+    if (c.sharedUnits == 0) {
+      continue;
+    }
+    llvm::StringRef buffer = c.contents->getBuffer();
+    size_t size = c.units[c.sharedUnits - 1].end() - buffer.begin();
+    groups[std::make_pair(c.key, buffer.substr(0, size).str())].push_back(i);
+  }
+
+  std::vector<std::pair<const std::pair<std::string, std::string> *,
+                        const std::vector<size_t> *>>
+      jobs;
+  for (const auto &g : groups) {
+    // the members of a window may all have found longer prefixes
+    if (g.second.size() >= m) {
+      jobs.emplace_back(&g.first, &g.second);
+    }
+  }
+
+  std::vector<std::shared_ptr<Prefix>> built(jobs.size());
+  ParallelExecutor(numThreads).run(jobs.size(), [&](size_t i) {
+    const std::string &key = jobs[i].first->first;
+    const std::string &text = jobs[i].first->second;
+    const Candidate &first = candidates[jobs[i].second->front()];
+
+    auto prefix = std::make_shared<Prefix>();
+    prefix->text = text;
+    std::string base = directory + "/" + md5Hex(key + '\0' + text);
+    std::string header = base + ".h";
+    prefix->pchPath = base + ".pch";
+
+    {
+      std::error_code ec;
+      llvm::raw_fd_ostream ofs(header, ec);
+      if (ec) {
+        return;
+      }
+      ofs << text;
+      ofs.flush();
+      if (ofs.has_error()) {
+        ofs.clear_error();
+        return;
+      }
+    }
+
+    // Compile the prefix header in place of the source file, searching
+    // quoted includes from the directory of the source file before any
+    // other, as the source file itself would
+    std::string sourceFile = first.absolutePath;
+    std::string sourceDir = llvm::sys::path::parent_path(sourceFile).str();
+    std::string language = headerLanguage(first.command);
+    clang::tooling::ArgumentsAdjuster useHeader =
+        [=](const clang::tooling::CommandLineArguments &args,
+            llvm::StringRef filename) {
+          clang::tooling::CommandLineArguments result;
+          for (const auto &arg : args) {
+            if (arg == filename || arg == sourceFile) {
+              result.push_back("-x");
+              result.push_back(language);
+              result.push_back(header);
+            } else {
+              result.push_back(arg);
+              if (result.size() == 1) {
+                // right after the compiler, ahead of every -iquote and -I
+                result.push_back("-iquote");
+                result.push_back(sourceDir);
+              }
+            }
+          }
+          return result;
+        };
+
+    llvm::IntrusiveRefCntPtr<llvm::vfs::FileSystem> fs(
+        llvm::vfs::createPhysicalFileSystem().release());
+    fs = ResultCache::recordInputs(fs, prefix->inputs, prefix->missingInputs);
+    clang::tooling::ClangTool tool(
+        compilations, {first.sourcePath},
+        std::make_shared<clang::PCHContainerOperations>(), fs);
+    tool.setRestoreWorkingDir(false);
+    tool.appendArgumentsAdjuster(useHeader);
+
+    PrefixPCHActionFactory factory(prefix->pchPath);
+    if (tool.run(&factory) == 0) {
+      built[i] = prefix;
+    }
+  });
+
+  size_t numBuilt = 0;
+  for (size_t i = 0; i < jobs.size(); ++i) {
+    if (!built[i]) {
+      continue;
+    }
+    ++numBuilt;
+    for (size_t c : *jobs[i].second) {
+      prefixes[candidates[c].absolutePath] = built[i];
+    }
+  }
+  return numBuilt;
+}
+
+const SharedPrefixPCH::Prefix *
+SharedPrefixPCH::lookup(const std::string &sourcePath) const {
+  auto it = prefixes.find(absolutePath(sourcePath));
+  if (it == prefixes.end()) {
+    return nullptr;
+  }
+  return it->second.get();
+}
+
+const SharedPrefixPCH::Prefix *
+SharedPrefixPCH::apply(const std::string &sourcePath,
+                       llvm::IntrusiveRefCntPtr<llvm::vfs::FileSystem> &fs,
+                       clang::tooling::ArgumentsAdjuster &adjuster) const {
+  const Prefix *prefix = lookup(sourcePath);
+  if (!prefix) {
+    return nullptr;
+  }
+
+  std::string absolute = absolutePath(sourcePath);
+  auto buffer = llvm::MemoryBuffer::getFile(absolute);
+  if (!buffer) {
+    return nullptr;
+  }
+  llvm::StringRef contents = (*buffer)->getBuffer();
+  if (contents.substr(0, prefix->text.size()) != prefix->text) {
+    // the source file changed since the PCH was built
+    return nullptr;
+  }
+
+  // Blank out the prefix without moving anything else
+  std::string blanked = contents.str();
+  for (size_t i = 0; i < prefix->text.size(); ++i) {
+    if (blanked[i] != '\n' && blanked[i] != '\r') {
+      blanked[i] = ' ';
+    }
+  }
+
+  llvm::IntrusiveRefCntPtr<llvm::vfs::InMemoryFileSystem> memory(
+      new llvm::vfs::InMemoryFileSystem);
+  memory->addFile(absolute, 0,
+                  llvm::MemoryBuffer::getMemBufferCopy(blanked, absolute));
+  llvm::IntrusiveRefCntPtr<llvm::vfs::OverlayFileSystem> overlay(
+      new llvm::vfs::OverlayFileSystem(fs));
+  overlay->pushOverlay(memory);
+  fs = overlay;
+
+  auto includePCH = clang::tooling::getInsertArgumentAdjuster(
+      {"-include-pch", prefix->pchPath},
+      clang::tooling::ArgumentInsertPosition::END);
+  adjuster = adjuster ? clang::tooling::combineAdjusters(adjuster, includePCH)
+                      : includePCH;
+  return prefix;
+}
+
+} // namespace clangmetatool
+
+// ----------------------------------------------------------------------------
+// Copyright 2026 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
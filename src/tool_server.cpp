@@ -0,0 +1,439 @@
+#include <clangmetatool/tool_server.h>
+
+#include <clang/Basic/FileSystemOptions.h>
+#include <llvm/ADT/SmallString.h>
+#include <llvm/ADT/StringRef.h>
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/Path.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <tuple>
+
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace clangmetatool {
+
+namespace {
+
+/**
+ * File served from the contents cached by the server.
+ */
+class CachedVFSFile : public llvm::vfs::File {
+private:
+  llvm::vfs::Status fileStatus;
+  const llvm::MemoryBuffer &contents;
+
+public:
+  CachedVFSFile(const llvm::vfs::Status &fileStatus,
+                const llvm::MemoryBuffer &contents)
+      : fileStatus(fileStatus), contents(contents) {}
+
+  llvm::ErrorOr<llvm::vfs::Status> status() override { return fileStatus; }
+
+  llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer>>
+  getBuffer(const llvm::Twine &name, int64_t, bool requiresNullTerminator,
+            bool) override {
+    return llvm::MemoryBuffer::getMemBuffer(contents.getBuffer(), name.str(),
+                                            requiresNullTerminator);
+  }
+
+  std::error_code close() override { return std::error_code(); }
+};
+
+/**
+ * Proxy file system that keeps the contents of every file read through
+ * it, records which ones were opened, and remembers the directories in
+ * which paths were looked up but didn't exist.
+ */
+class CachingFileSystem : public llvm::vfs::ProxyFileSystem {
+private:
+  std::map<std::string, ToolServer::CachedFile> &files;
+  std::set<std::string> &opened;
+  std::map<std::string, llvm::sys::TimePoint<>> &missingDirectories;
+
+  std::string absolutePath(const llvm::Twine &path) {
+    llvm::SmallString<256> absolute;
+    path.toVector(absolute);
+    if (makeAbsolute(absolute)) {
+      return "";
+    }
+    llvm::sys::path::remove_dots(absolute, true);
+    return absolute.str().str();
+  }
+
+  /**
+   * Remember when the closest existing directory above the missing
+   * path was last modified, creating the path would change it.
+   */
+  void addMissing(const std::string &absolute) {
+    llvm::StringRef directory = llvm::sys::path::parent_path(absolute);
+    while (!directory.empty() && !missingDirectories.count(directory.str())) {
+      llvm::sys::fs::file_status current;
+      if (!llvm::sys::fs::status(directory, current)) {
+        missingDirectories.emplace(directory.str(),
+                                   current.getLastModificationTime());
+        return;
+      }
+      directory = llvm::sys::path::parent_path(directory);
+    }
+  }
+
+public:
+  CachingFileSystem(
+      llvm::IntrusiveRefCntPtr<llvm::vfs::FileSystem> fs,
+      std::map<std::string, ToolServer::CachedFile> &files,
+      std::set<std::string> &opened,
+      std::map<std::string, llvm::sys::TimePoint<>> &missingDirectories)
+      : ProxyFileSystem(std::move(fs)), files(files), opened(opened),
+        missingDirectories(missingDirectories) {}
+
+  llvm::ErrorOr<llvm::vfs::Status> status(const llvm::Twine &path) override {
+    auto result = ProxyFileSystem::status(path);
+    if (!result) {
+      std::string absolute = absolutePath(path);
+      if (!absolute.empty()) {
+        addMissing(absolute);
+      }
+    }
+    return result;
+  }
+
+  llvm::ErrorOr<std::unique_ptr<llvm::vfs::File>>
+  openFileForRead(const llvm::Twine &path) override {
+    std::string absolute = absolutePath(path);
+    if (absolute.empty()) {
+      return ProxyFileSystem::openFileForRead(path);
+    }
+
+    auto it = files.find(absolute);
+    if (it == files.end()) {
+      auto file = ProxyFileSystem::openFileForRead(path);
+      if (!file) {
+        addMissing(absolute);
+        return file;
+      }
+      auto fileStatus = (*file)->status();
+      auto contents = (*file)->getBuffer(path);
+      if (!fileStatus || !contents) {
+        return ProxyFileSystem::openFileForRead(path);
+      }
+      it = files
+               .emplace(absolute, ToolServer::CachedFile{
+                                      *fileStatus, std::move(*contents)})
+               .first;
+    }
+    opened.insert(absolute);
+
+    return std::unique_ptr<llvm::vfs::File>(new CachedVFSFile(
+        llvm::vfs::Status::copyWithNewName(it->second.status, path.str()),
+        *it->second.contents));
+  }
+};
+
+bool makeAddress(const std::string &socketPath, sockaddr_un &addr) {
+  memset(&addr, 0, sizeof(addr));
+  addr.sun_family = AF_UNIX;
+  if (socketPath.size() >= sizeof(addr.sun_path)) {
+    llvm::errs() << "Socket path is too long: " << socketPath << "\n";
+    return false;
+  }
+  strncpy(addr.sun_path, socketPath.c_str(), sizeof(addr.sun_path) - 1);
+  return true;
+}
+
+bool sendAll(int fd, const std::string &data) {
+  const char *p = data.data();
+  size_t size = data.size();
+  while (size > 0) {
+    // Don't let a client that went away kill the server with SIGPIPE
+    ssize_t sent = send(fd, p, size, MSG_NOSIGNAL);
+    if (sent < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return false;
+    }
+    p += sent;
+    size -= sent;
+  }
+  return true;
+}
+
+/**
+ * Read until the peer closes its end. With a timeout, give up if the
+ * whole of it takes longer than that many milliseconds.
+ */
+bool receiveAll(int fd, std::string &data, int timeoutMs = -1) {
+  auto deadline = std::chrono::steady_clock::now() +
+                  std::chrono::milliseconds(timeoutMs);
+  char buffer[4096];
+  while (true) {
+    if (timeoutMs >= 0) {
+      auto left = std::chrono::duration_cast<std::chrono::milliseconds>(
+          deadline - std::chrono::steady_clock::now());
+      pollfd pfd = {fd, POLLIN, 0};
+      int ready = poll(&pfd, 1, std::max<int64_t>(0, left.count()));
+      if (ready < 0 && errno == EINTR) {
+        continue;
+      }
+      if (ready <= 0) {
+        return false;
+      }
+    }
+    ssize_t received = read(fd, buffer, sizeof(buffer));
+    if (received < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return false;
+    }
+    if (received == 0) {
+      return true;
+    }
+    data.append(buffer, received);
+  }
+}
+
+/**
+ * Send a request to the server and wait for its response.
+ */
+int sendRequest(const std::string &socketPath, const std::string &request,
+                llvm::raw_ostream &os) {
+  sockaddr_un addr;
+  if (!makeAddress(socketPath, addr)) {
+    return 1;
+  }
+
+  int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+  if (fd < 0 || connect(fd, reinterpret_cast<sockaddr *>(&addr),
+                        sizeof(addr)) != 0) {
+    llvm::errs() << "Cannot connect to " << socketPath << ": "
+                 << strerror(errno) << "\n";
+    if (fd >= 0) {
+      close(fd);
+    }
+    return 1;
+  }
+
+  std::string response;
+  bool ok = sendAll(fd, request) && ::shutdown(fd, SHUT_WR) == 0 &&
+            receiveAll(fd, response);
+  close(fd);
+
+  llvm::StringRef status, output;
+  std::tie(status, output) = llvm::StringRef(response).split('\n');
+  int r;
+  if (!ok || status.getAsInteger(10, r)) {
+    llvm::errs() << "Invalid response from " << socketPath << "\n";
+    return 1;
+  }
+  os << output;
+  return r;
+}
+
+} // namespace
+
+ToolServer::ToolServer(const std::string &socketPath, int receiveTimeoutMs)
+    : socketPath(socketPath), receiveTimeoutMs(receiveTimeoutMs) {}
+
+void ToolServer::refresh(const std::vector<std::string> &sourcePaths) {
+  // Only the files the requested translation units opened last time
+  // are checked, unless one of them was never processed
+  std::set<std::string> toCheck;
+  bool checkAll = false;
+  for (const auto &path : sourcePaths) {
+    auto it = filesBySource.find(path);
+    if (it == filesBySource.end()) {
+      checkAll = true;
+      break;
+    }
+    toCheck.insert(it->second.begin(), it->second.end());
+  }
+
+  auto isUnchanged = [](const std::string &path, const CachedFile &file) {
+    llvm::sys::fs::file_status current;
+    return !llvm::sys::fs::status(path, current) &&
+           current.getSize() == file.status.getSize() &&
+           current.getLastModificationTime() ==
+               file.status.getLastModificationTime();
+  };
+
+  bool changed = false;
+  if (checkAll) {
+    for (auto it = files.begin(); !changed && it != files.end(); ++it) {
+      changed = !isUnchanged(it->first, it->second);
+    }
+  } else {
+    for (auto it = toCheck.begin(); !changed && it != toCheck.end(); ++it) {
+      auto file = files.find(*it);
+      changed = file != files.end() && !isUnchanged(file->first, file->second);
+    }
+  }
+
+  // The file managers remember missing paths whichever translation
+  // unit looked them up, so all of them are checked, a directory at a
+  // time
+  for (auto it = missingDirectories.begin();
+       !changed && it != missingDirectories.end(); ++it) {
+    llvm::sys::fs::file_status current;
+    changed = llvm::sys::fs::status(it->first, current) ||
+              current.getLastModificationTime() != it->second;
+  }
+
+  if (changed) {
+    fileManagers.clear();
+    files.clear();
+    filesBySource.clear();
+    missingDirectories.clear();
+  }
+}
+
+int ToolServer::serve(const Handler &handler) {
+  sockaddr_un addr;
+  if (!makeAddress(socketPath, addr)) {
+    return 1;
+  }
+
+  int listener = socket(AF_UNIX, SOCK_STREAM, 0);
+  if (listener < 0) {
+    llvm::errs() << "Cannot create socket: " << strerror(errno) << "\n";
+    return 1;
+  }
+  // A socket left behind by a previous server would make bind fail. Only
+  // the owner may connect, since requests run with our credentials, and
+  // nobody can before listen is called.
+  unlink(socketPath.c_str());
+  if (bind(listener, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) != 0 ||
+      chmod(socketPath.c_str(), S_IRUSR | S_IWUSR) != 0 ||
+      listen(listener, 16) != 0) {
+    llvm::errs() << "Cannot listen on " << socketPath << ": "
+                 << strerror(errno) << "\n";
+    close(listener);
+    return 1;
+  }
+
+  bool running = true;
+  while (running) {
+    int fd = accept(listener, nullptr, nullptr);
+    if (fd < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      llvm::errs() << "Cannot accept on " << socketPath << ": "
+                   << strerror(errno) << "\n";
+      break;
+    }
+
+    // Requests are handled one at a time, a client that never finishes
+    // sending its request must not hold up the others
+    std::string request;
+    if (!receiveAll(fd, request, receiveTimeoutMs)) {
+      llvm::errs() << "Dropping an incomplete request\n";
+      close(fd);
+      continue;
+    }
+
+    llvm::StringRef command, rest;
+    std::tie(command, rest) = llvm::StringRef(request).split('\n');
+
+    int status = 0;
+    std::string output;
+    if (command == "run") {
+      std::vector<std::string> sourcePaths;
+      while (!rest.empty()) {
+        llvm::StringRef path;
+        std::tie(path, rest) = rest.split('\n');
+        if (!path.empty()) {
+          sourcePaths.push_back(path.str());
+        }
+      }
+
+      refresh(sourcePaths);
+      opened.clear();
+      llvm::raw_string_ostream os(output);
+      status = handler(sourcePaths, os);
+      os.flush();
+      // Without telling which translation unit opened what, each one of
+      // the request gets all the files of the request
+      for (const auto &path : sourcePaths) {
+        filesBySource[path].insert(opened.begin(), opened.end());
+      }
+    } else if (command == "shutdown") {
+      running = false;
+    } else {
+      status = 1;
+      output = "Unknown command: " + command.str() + "\n";
+    }
+
+    sendAll(fd, std::to_string(status) + "\n" + output);
+    close(fd);
+  }
+
+  close(listener);
+  unlink(socketPath.c_str());
+  return running ? 1 : 0;
+}
+
+llvm::IntrusiveRefCntPtr<clang::FileManager>
+ToolServer::getFileManager(const std::string &workingDir) {
+  auto &fileManager = fileManagers[workingDir];
+  if (!fileManager) {
+    // Setting the working directory makes the file manager resolve
+    // relative paths itself, so its caches never mix up directories
+    clang::FileSystemOptions options;
+    options.WorkingDir = workingDir;
+    llvm::IntrusiveRefCntPtr<llvm::vfs::FileSystem> fs(
+        new CachingFileSystem(llvm::vfs::getRealFileSystem(), files, opened,
+                              missingDirectories));
+    fileManager = new clang::FileManager(options, fs);
+  }
+  return fileManager;
+}
+
+llvm::IntrusiveRefCntPtr<llvm::vfs::FileSystem> ToolServer::getFileSystem() {
+  return new CachingFileSystem(llvm::vfs::getRealFileSystem(), files, opened,
+                               missingDirectories);
+}
+
+size_t ToolServer::getNumCachedFiles() const { return files.size(); }
+
+int ToolServer::request(const std::string &socketPath,
+                        const std::vector<std::string> &sourcePaths,
+                        llvm::raw_ostream &os) {
+  std::string request = "run\n";
+  for (const auto &path : sourcePaths) {
+    request += path + "\n";
+  }
+  return sendRequest(socketPath, request, os);
+}
+
+int ToolServer::shutdown(const std::string &socketPath) {
+  return sendRequest(socketPath, "shutdown\n", llvm::nulls());
+}
+
+} // namespace clangmetatool
+
+// ----------------------------------------------------------------------------
+// Copyright 2026 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,103 @@
+#include <clangmetatool/translation_unit_history.h>
+
+#include <llvm/Support/Format.h>
+#include <llvm/Support/MemoryBuffer.h>
+#include <llvm/Support/raw_ostream.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <limits>
+#include <numeric>
+#include <tuple>
+
+namespace clangmetatool {
+
+TranslationUnitHistory::TranslationUnitHistory(const std::string &fileName)
+    : fileName(fileName) {
+  auto buffer = llvm::MemoryBuffer::getFile(fileName);
+  if (!buffer) {
+    return;
+  }
+
+  llvm::StringRef contents = (*buffer)->getBuffer();
+  while (!contents.empty()) {
+    llvm::StringRef line;
+    std::tie(line, contents) = contents.split('\n');
+
+    std::string text = line.str();
+    Record r;
+    int pathStart = -1;
+    if (sscanf(text.c_str(), "%lf %zu %n", &r.wallSeconds,
+               &r.processPeakMemoryKB, &pathStart) != 2 ||
+        pathStart < 0 || static_cast<size_t>(pathStart) >= text.size()) {
+      continue;
+    }
+    records[text.substr(pathStart)] = r;
+  }
+}
+
+const TranslationUnitHistory::Record *
+TranslationUnitHistory::lookup(const std::string &sourcePath) const {
+  auto it = records.find(sourcePath);
+  if (it == records.end()) {
+    return nullptr;
+  }
+  return &it->second;
+}
+
+void TranslationUnitHistory::record(const std::string &sourcePath,
+                                    const Record &r) {
+  records[sourcePath] = r;
+}
+
+std::vector<size_t> TranslationUnitHistory::schedule(
+    const std::vector<std::string> &sourcePaths) const {
+  // Unknown translation units sort before everything else
+  std::vector<double> cost(sourcePaths.size());
+  for (size_t i = 0; i < sourcePaths.size(); ++i) {
+    const Record *r = lookup(sourcePaths[i]);
+    cost[i] = r ? r->wallSeconds : std::numeric_limits<double>::infinity();
+  }
+
+  std::vector<size_t> order(sourcePaths.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(),
+                   [&](size_t a, size_t b) { return cost[a] > cost[b]; });
+  return order;
+}
+
+std::error_code TranslationUnitHistory::save() const {
+  std::error_code ec;
+  llvm::raw_fd_ostream ofs(fileName, ec);
+  if (ec) {
+    return ec;
+  }
+  for (const auto &p : records) {
+    ofs << llvm::format("%f %zu ", p.second.wallSeconds,
+                        p.second.processPeakMemoryKB)
+        << p.first << "\n";
+  }
+  ofs.flush();
+  // Hand the error to the caller instead of letting the stream abort
+  ec = ofs.error();
+  ofs.clear_error();
+  return ec;
+}
+
+} // namespace clangmetatool
+
+// ----------------------------------------------------------------------------
+// Copyright 2026 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
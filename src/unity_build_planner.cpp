@@ -0,0 +1,398 @@
+#include <clangmetatool/unity_build_planner.h>
+
+#include <clang/AST/Decl.h>
+#include <clang/AST/DeclBase.h>
+#include <clang/Basic/FileManager.h>
+#include <llvm/ADT/SmallString.h>
+#include <llvm/ADT/StringRef.h>
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/xxhash.h>
+
+#include <clangmetatool/include_graph_dependencies.h>
+
+#include <algorithm>
+#include <iterator>
+#include <limits>
+#include <unordered_map>
+#include <utility>
+
+namespace clangmetatool {
+
+namespace {
+
+using types::FileUID;
+
+constexpr uint64_t EMPTY_BIN = std::numeric_limits<uint64_t>::max();
+
+/**
+ * The finalizer of splitmix64, to spread the bits of a hash.
+ */
+uint64_t mix(uint64_t x) {
+  x ^= x >> 30;
+  x *= 0xbf58476d1ce4e5b9ULL;
+  x ^= x >> 27;
+  x *= 0x94d049bb133111ebULL;
+  x ^= x >> 31;
+  return x;
+}
+
+/**
+ * Absolute path of the file, with symbolic links resolved when it
+ * exists.
+ */
+std::string canonicalPath(llvm::StringRef path) {
+  llvm::SmallString<256> result;
+  if (!llvm::sys::fs::real_path(path, result)) {
+    return result.str().str();
+  }
+  result = path;
+  llvm::sys::fs::make_absolute(result);
+  return result.str().str();
+}
+
+/**
+ * MinHash signature of a set of hashes, with one hash per element
+ * instead of one per value of the signature: the hash of an element
+ * picks the value it competes for, and the rest of it is the
+ * competing value. Values no element picked borrow the next value
+ * that was picked, offset by how far it is, as in the densified
+ * one permutation hashing of Shrivastava and Li, so they agree between
+ * two sets about as often as the other values do.
+ */
+std::vector<uint64_t> signatureOf(const std::vector<uint64_t> &hashes,
+                                  size_t size) {
+  std::vector<uint64_t> picked(size, EMPTY_BIN);
+  for (uint64_t hash : hashes) {
+    uint64_t &value = picked[hash % size];
+    value = std::min(value, hash / size);
+  }
+
+  std::vector<uint64_t> signature(picked);
+  for (size_t i = 0; i < size; ++i) {
+    if (picked[i] != EMPTY_BIN) {
+      continue;
+    }
+    size_t distance = 1;
+    while (picked[(i + distance) % size] == EMPTY_BIN) {
+      ++distance;
+    }
+    signature[i] = mix(picked[(i + distance) % size] + distance);
+  }
+  return signature;
+}
+
+/**
+ * Estimated Jaccard similarity of the sets with the given signatures.
+ */
+double similarity(const std::vector<uint64_t> &a,
+                  const std::vector<uint64_t> &b) {
+  size_t equal = 0;
+  for (size_t i = 0; i < a.size(); ++i) {
+    if (a[i] == b[i]) {
+      ++equal;
+    }
+  }
+  return static_cast<double>(equal) / a.size();
+}
+
+/**
+ * Name an internal definition would clash on with the same name in
+ * another main file of the same unity build, where the anonymous
+ * namespaces of all of them are the same namespace.
+ */
+std::string clashingName(const clang::NamedDecl *decl) {
+  std::string name = decl->getQualifiedNameAsString();
+  const std::string anonymous = "(anonymous namespace)::";
+  for (size_t pos = name.find(anonymous); pos != std::string::npos;
+       pos = name.find(anonymous, pos)) {
+    name.erase(pos, anonymous.size());
+  }
+  return name;
+}
+
+} // namespace
+
+uint64_t UnityBuildPlanner::sizeOf(const std::string &path) {
+  {
+    std::lock_guard<std::mutex> lock(sizesMutex);
+    auto it = sizes.find(path);
+    if (it != sizes.end()) {
+      return it->second;
+    }
+  }
+
+  uint64_t size = 0;
+  llvm::sys::fs::file_status status;
+  if (!llvm::sys::fs::status(path, status)) {
+    size = status.getSize();
+  }
+
+  std::lock_guard<std::mutex> lock(sizesMutex);
+  sizes[path] = size;
+  return size;
+}
+
+void UnityBuildPlanner::add(const collectors::IncludeGraphData *includeGraph,
+                            const collectors::DefinitionsData *definitions,
+                            const clang::SourceManager &sm) {
+  const clang::FileEntry *main = sm.getFileEntryForID(sm.getMainFileID());
+  if (!main) {
+    return;
+  }
+  FileUID mainUID = main->getUID();
+  llvm::StringRef mainName = main->tryGetRealPathName();
+  if (mainName.empty()) {
+    mainName = sm.getFilename(sm.getLocForStartOfFile(sm.getMainFileID()));
+  }
+  std::string mainPath = canonicalPath(mainName);
+
+  std::map<FileUID, std::string> paths =
+      IncludeGraphDependencies::filePaths(includeGraph);
+
+  // Sizes are read from disk here, outside of the lock
+  std::vector<std::pair<std::string, uint64_t>> headers;
+  for (FileUID uid :
+       IncludeGraphDependencies::collectAllIncludes(includeGraph, mainUID)) {
+    auto path = paths.find(uid);
+    if (uid != mainUID && path != paths.end()) {
+      headers.emplace_back(path->second, sizeOf(path->second));
+    }
+  }
+
+  std::set<std::string> symbols;
+  std::set<std::string> externalSymbols;
+  if (definitions) {
+    auto range = definitions->defs.equal_range(mainUID);
+    for (auto it = range.first; it != range.second; ++it) {
+      const clang::NamedDecl *decl = it->second;
+      if (decl->isImplicit() ||
+          !decl->getDeclContext()->getRedeclContext()->isFileContext()) {
+        continue;
+      }
+      std::string name = clashingName(decl);
+      if (name.empty()) {
+        continue;
+      }
+      if (decl->isExternallyVisible()) {
+        externalSymbols.insert(name);
+      } else {
+        symbols.insert(name);
+      }
+    }
+  }
+  uint64_t mainBytes = sizeOf(mainPath);
+
+  std::lock_guard<std::mutex> lock(mutex);
+  std::vector<HeaderID> ids;
+  for (const auto &header : headers) {
+    auto inserted = headerIds.emplace(header.first, headerBytes.size());
+    if (inserted.second) {
+      headerBytes.push_back(header.second);
+      headerHashes.push_back(mix(llvm::xxHash64(header.first)));
+    }
+    ids.push_back(inserted.first->second);
+  }
+  std::sort(ids.begin(), ids.end());
+  ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+
+  auto index = unitIndex.emplace(mainPath, units.size());
+  if (index.second) {
+    units.emplace_back();
+    units.back().path = mainPath;
+    units.back().bytes = mainBytes;
+  }
+  TranslationUnit &unit = units[index.first->second];
+  std::vector<HeaderID> merged;
+  std::set_union(unit.headers.begin(), unit.headers.end(), ids.begin(),
+                 ids.end(), std::back_inserter(merged));
+  unit.headers.swap(merged);
+  unit.symbols.insert(symbols.begin(), symbols.end());
+  unit.externalSymbols.insert(externalSymbols.begin(), externalSymbols.end());
+}
+
+size_t UnityBuildPlanner::getNumTranslationUnits() const {
+  std::lock_guard<std::mutex> lock(mutex);
+  return units.size();
+}
+
+std::vector<UnityBuildPlanner::Group> UnityBuildPlanner::plan() const {
+  return plan(Options());
+}
+
+std::vector<UnityBuildPlanner::Group>
+UnityBuildPlanner::plan(const Options &options) const {
+  std::lock_guard<std::mutex> lock(mutex);
+  size_t rows = std::max(1u, options.rowsPerBand);
+  size_t numBands = std::max(1u, options.numBands);
+  size_t signatureSize = rows * numBands;
+
+  // Translation units that include nothing share nothing, they get no
+  // signature and stay alone
+  std::vector<std::vector<uint64_t>> signatures(units.size());
+  std::vector<std::unordered_map<uint64_t, std::vector<size_t>>> buckets(
+      numBands);
+  auto bandKey = [&](size_t unit, size_t band) {
+    return llvm::xxHash64(llvm::StringRef(
+        reinterpret_cast<const char *>(&signatures[unit][band * rows]),
+        rows * sizeof(uint64_t)));
+  };
+  for (size_t i = 0; i < units.size(); ++i) {
+    if (units[i].headers.empty()) {
+      continue;
+    }
+    std::vector<uint64_t> hashes;
+    hashes.reserve(units[i].headers.size());
+    for (HeaderID id : units[i].headers) {
+      hashes.push_back(headerHashes[id]);
+    }
+    signatures[i] = signatureOf(hashes, signatureSize);
+    for (size_t band = 0; band < numBands; ++band) {
+      buckets[band][bandKey(i, band)].push_back(i);
+    }
+  }
+
+  std::vector<size_t> order(units.size());
+  for (size_t i = 0; i < order.size(); ++i) {
+    order[i] = i;
+  }
+  std::sort(order.begin(), order.end(), [this](size_t a, size_t b) {
+    if (units[a].headers.size() != units[b].headers.size()) {
+      return units[a].headers.size() > units[b].headers.size();
+    }
+    return units[a].path < units[b].path;
+  });
+
+  std::vector<Group> groups;
+  std::vector<bool> grouped(units.size(), false);
+  for (size_t seed : order) {
+    if (grouped[seed]) {
+      continue;
+    }
+    grouped[seed] = true;
+
+    std::set<std::string> symbols(units[seed].symbols);
+    std::set<std::string> externalSymbols(units[seed].externalSymbols);
+    std::set<HeaderID> files(units[seed].headers.begin(),
+                             units[seed].headers.end());
+    Group group;
+    group.translationUnits.push_back(units[seed].path);
+    group.bytes = units[seed].bytes;
+    for (HeaderID id : files) {
+      group.bytes += headerBytes[id];
+    }
+
+    // What shares a bucket with the seed, most similar first. Grouped
+    // translation units are dropped from the buckets on the way, so
+    // that large buckets of near copies don't get scanned again and
+    // again.
+    std::vector<std::pair<double, size_t>> candidates;
+    if (!signatures[seed].empty()) {
+      std::set<size_t> seen;
+      for (size_t band = 0;
+           band < numBands && seen.size() < options.maxCandidates; ++band) {
+        std::vector<size_t> &bucket = buckets[band][bandKey(seed, band)];
+        for (size_t i = 0;
+             i < bucket.size() && seen.size() < options.maxCandidates;) {
+          size_t other = bucket[i];
+          if (grouped[other]) {
+            bucket[i] = bucket.back();
+            bucket.pop_back();
+            continue;
+          }
+          ++i;
+          if (!seen.insert(other).second) {
+            continue;
+          }
+          double score = similarity(signatures[seed], signatures[other]);
+          if (score >= options.minSimilarity) {
+            candidates.emplace_back(score, other);
+          }
+        }
+      }
+    }
+    std::sort(candidates.begin(), candidates.end(),
+              [this](const std::pair<double, size_t> &a,
+                     const std::pair<double, size_t> &b) {
+                if (a.first != b.first) {
+                  return a.first > b.first;
+                }
+                return units[a.second].path < units[b.second].path;
+              });
+
+    for (const auto &candidate : candidates) {
+      if (group.translationUnits.size() >= options.maxTranslationUnits) {
+        break;
+      }
+      const TranslationUnit &unit = units[candidate.second];
+      if (std::any_of(unit.symbols.begin(), unit.symbols.end(),
+                      [&](const std::string &symbol) {
+                        return symbols.count(symbol) != 0 ||
+                               externalSymbols.count(symbol) != 0;
+                      }) ||
+          std::any_of(unit.externalSymbols.begin(),
+                      unit.externalSymbols.end(),
+                      [&symbols](const std::string &symbol) {
+                        return symbols.count(symbol) != 0;
+                      })) {
+        continue;
+      }
+
+      uint64_t added = unit.bytes;
+      for (HeaderID id : unit.headers) {
+        if (!files.count(id)) {
+          added += headerBytes[id];
+        }
+      }
+      if (options.maxBytes && group.bytes + added > options.maxBytes) {
+        continue;
+      }
+
+      grouped[candidate.second] = true;
+      group.translationUnits.push_back(unit.path);
+      group.bytes += added;
+      files.insert(unit.headers.begin(), unit.headers.end());
+      symbols.insert(unit.symbols.begin(), unit.symbols.end());
+      externalSymbols.insert(unit.externalSymbols.begin(),
+                             unit.externalSymbols.end());
+    }
+
+    std::sort(group.translationUnits.begin(), group.translationUnits.end());
+    groups.push_back(std::move(group));
+  }
+  return groups;
+}
+
+void UnityBuildPlanner::writeGroups(const std::vector<Group> &groups,
+                                    llvm::raw_ostream &os) {
+  for (const Group &group : groups) {
+    for (size_t i = 0; i < group.translationUnits.size(); ++i) {
+      os << (i ? " " : "") << group.translationUnits[i];
+    }
+    os << "\n";
+  }
+}
+
+void UnityBuildPlanner::writeUnitySource(const Group &group,
+                                         llvm::raw_ostream &os) {
+  for (const std::string &path : group.translationUnits) {
+    os << "#include \"" << path << "\"\n";
+  }
+}
+
+} // namespace clangmetatool
+
+// ----------------------------------------------------------------------------
+// Copyright 2026 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,118 @@
+#include "clangmetatool-testconfig.h"
+
+#include <map>
+#include <set>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include <clangmetatool/collectors/find_functions.h>
+#include <clangmetatool/meta_tool.h>
+#include <clangmetatool/meta_tool_factory.h>
+
+#include <clang/Frontend/FrontendAction.h>
+#include <clang/Tooling/CommonOptionsParser.h>
+#include <clang/Tooling/Core/Replacement.h>
+#include <clang/Tooling/Refactoring.h>
+#include <clang/Tooling/Tooling.h>
+#include <llvm/Support/CommandLine.h>
+#include <llvm/Support/Error.h>
+
+namespace {
+
+const std::string dataDir =
+    CMAKE_SOURCE_DIR "/t/data/045-meta-tool-factory-parallel/";
+
+class MyTool {
+private:
+  clang::CompilerInstance *ci;
+  clangmetatool::collectors::FindFunctions ff;
+
+public:
+  MyTool(clang::CompilerInstance *ci, clang::ast_matchers::MatchFinder *f)
+      : ci(ci), ff(ci, f) {}
+
+  void postProcessing(
+      std::map<std::string, clang::tooling::Replacements> &replacementsMap) {
+    clang::SourceManager &sm = ci->getSourceManager();
+    for (const auto &fn : *ff.getData()) {
+      auto nameSource = fn->getNameInfo().getSourceRange();
+      clang::tooling::Replacement r(sm, nameSource.getBegin(), 0, "new_");
+      llvm::consumeError(replacementsMap[r.getFilePath().str()].add(r));
+    }
+
+    // Every translation unit that includes the shared header asks for the
+    // same edit on it.
+    std::string mainFile =
+        sm.getFilename(sm.getLocForStartOfFile(sm.getMainFileID())).str();
+    if (mainFile != dataDir + "c.cpp") {
+      clang::tooling::Replacement r(dataDir + "shared.h", 0, 0, "// shared\n");
+      llvm::consumeError(replacementsMap[r.getFilePath().str()].add(r));
+    }
+  }
+};
+
+std::set<clang::tooling::Replacement> flatten(
+    const std::map<std::string, clang::tooling::Replacements> &replacements) {
+  std::set<clang::tooling::Replacement> result;
+  for (const auto &p : replacements) {
+    result.insert(p.second.begin(), p.second.end());
+  }
+  return result;
+}
+
+} // anonymous namespace
+
+TEST(MetaToolFactoryParallel, matchesSerialRun) {
+  llvm::cl::OptionCategory MyToolCategory("my-tool options");
+
+  std::string a = dataDir + "a.cpp";
+  std::string b = dataDir + "b.cpp";
+  std::string c = dataDir + "c.cpp";
+  const char *argv[] = {"foo", a.c_str(), b.c_str(), c.c_str(), "--", "-xc++"};
+  int argc = sizeof(argv) / sizeof(argv[0]);
+
+  auto result = clang::tooling::CommonOptionsParser::create(
+      argc, argv, MyToolCategory, llvm::cl::OneOrMore);
+  ASSERT_TRUE(!!result);
+  clang::tooling::CommonOptionsParser &optionsParser = result.get();
+
+  std::map<std::string, clang::tooling::Replacements> parallelReplacements;
+  clangmetatool::MetaToolFactory<clangmetatool::MetaTool<MyTool>> raf(
+      parallelReplacements);
+  int r = raf.runParallel(optionsParser.getCompilations(),
+                          optionsParser.getSourcePathList(), 2);
+  ASSERT_EQ(0, r);
+
+  std::set<clang::tooling::Replacement> expected = {
+      clang::tooling::Replacement(a, 25, 0, "new_"),
+      clang::tooling::Replacement(b, 25, 0, "new_"),
+      clang::tooling::Replacement(c, 4, 0, "new_"),
+      clang::tooling::Replacement(dataDir + "shared.h", 0, 0, "// shared\n"),
+  };
+  EXPECT_EQ(expected, flatten(parallelReplacements));
+
+  // The merged result is the same as what a serial run produces
+  clang::tooling::RefactoringTool tool(optionsParser.getCompilations(),
+                                       optionsParser.getSourcePathList());
+  clangmetatool::MetaToolFactory<clangmetatool::MetaTool<MyTool>> serial(
+      tool.getReplacements());
+  ASSERT_EQ(0, tool.run(&serial));
+  EXPECT_EQ(flatten(tool.getReplacements()), flatten(parallelReplacements));
+}
+
+// ----------------------------------------------------------------------------
+// Copyright 2026 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
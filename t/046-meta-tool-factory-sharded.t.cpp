@@ -0,0 +1,221 @@
+#include "clangmetatool-testconfig.h"
+
+#include <cstdlib>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <clangmetatool/collectors/find_functions.h>
+#include <clangmetatool/meta_tool.h>
+#include <clangmetatool/meta_tool_factory.h>
+#include <clangmetatool/sharded_executor.h>
+
+#include <clang/Frontend/FrontendAction.h>
+#include <clang/Tooling/CommonOptionsParser.h>
+#include <clang/Tooling/Core/Replacement.h>
+#include <clang/Tooling/Refactoring.h>
+#include <clang/Tooling/Tooling.h>
+#include <llvm/Support/CommandLine.h>
+#include <llvm/Support/Error.h>
+#include <llvm/Support/YAMLTraits.h>
+#include <llvm/Support/raw_ostream.h>
+
+#include <sys/resource.h>
+#include <unistd.h>
+
+namespace {
+
+const std::string dataDir =
+    CMAKE_SOURCE_DIR "/t/data/046-meta-tool-factory-sharded/";
+
+class MyTool {
+private:
+  clang::CompilerInstance *ci;
+  clangmetatool::collectors::FindFunctions ff;
+
+public:
+  MyTool(clang::CompilerInstance *ci, clang::ast_matchers::MatchFinder *f)
+      : ci(ci), ff(ci, f) {}
+
+  void postProcessing(
+      std::map<std::string, clang::tooling::Replacements> &replacementsMap) {
+    clang::SourceManager &sm = ci->getSourceManager();
+    std::string mainFile =
+        sm.getFilename(sm.getLocForStartOfFile(sm.getMainFileID())).str();
+    if (mainFile == dataDir + "crash.cpp") {
+      abort();
+    }
+
+    for (const auto &fn : *ff.getData()) {
+      auto nameSource = fn->getNameInfo().getSourceRange();
+      clang::tooling::Replacement r(sm, nameSource.getBegin(), 0, "new_");
+      llvm::consumeError(replacementsMap[r.getFilePath().str()].add(r));
+    }
+
+    // Every translation unit that includes the shared header asks for the
+    // same edit on it.
+    if (mainFile != dataDir + "c.cpp") {
+      clang::tooling::Replacement r(dataDir + "shared.h", 0, 0, "// shared\n");
+      llvm::consumeError(replacementsMap[r.getFilePath().str()].add(r));
+    }
+  }
+};
+
+static void eatDiagnostics(const llvm::SMDiagnostic &, void *) {}
+
+} // anonymous namespace
+
+TEST(MetaToolFactorySharded, exportsFixesFromAllShards) {
+  llvm::cl::OptionCategory MyToolCategory("my-tool options");
+
+  std::string a = dataDir + "a.cpp";
+  std::string b = dataDir + "b.cpp";
+  std::string c = dataDir + "c.cpp";
+  const char *argv[] = {"foo", a.c_str(), b.c_str(), c.c_str(), "--", "-xc++"};
+  int argc = sizeof(argv) / sizeof(argv[0]);
+
+  auto result = clang::tooling::CommonOptionsParser::create(
+      argc, argv, MyToolCategory, llvm::cl::OneOrMore);
+  ASSERT_TRUE(!!result);
+  clang::tooling::CommonOptionsParser &optionsParser = result.get();
+
+  std::map<std::string, clang::tooling::Replacements> replacements;
+  clangmetatool::MetaToolFactory<clangmetatool::MetaTool<MyTool>> raf(
+      replacements);
+
+  std::string O;
+  llvm::raw_string_ostream os(O);
+  int r = raf.runShardedAndExportFixes(optionsParser.getCompilations(),
+                                       optionsParser.getSourcePathList(), 2,
+                                       os);
+  ASSERT_EQ(0, r);
+
+  std::set<clang::tooling::Replacement> expected = {
+      clang::tooling::Replacement(a, 25, 0, "new_"),
+      clang::tooling::Replacement(b, 25, 0, "new_"),
+      clang::tooling::Replacement(c, 4, 0, "new_"),
+      clang::tooling::Replacement(dataDir + "shared.h", 0, 0, "// shared\n"),
+  };
+
+  // The replacements of every shard end up in the factory's map...
+  std::set<clang::tooling::Replacement> merged;
+  for (const auto &p : replacements) {
+    merged.insert(p.second.begin(), p.second.end());
+  }
+  EXPECT_EQ(expected, merged);
+
+  // ...and in a single exported document
+  llvm::yaml::Input replacementsYaml(os.str(), nullptr, &eatDiagnostics);
+  clang::tooling::TranslationUnitReplacements TURs;
+  replacementsYaml >> TURs;
+  ASSERT_FALSE(replacementsYaml.error());
+  EXPECT_EQ("", TURs.MainSourceFile);
+  EXPECT_EQ(expected,
+            std::set<clang::tooling::Replacement>(TURs.Replacements.begin(),
+                                                  TURs.Replacements.end()));
+}
+
+TEST(MetaToolFactorySharded, isolatesCrashingTranslationUnits) {
+  llvm::cl::OptionCategory MyToolCategory("my-tool options");
+
+  // With two workers, crash.cpp is the first job of the second shard,
+  // and c.cpp has to be processed by the worker that replaces it
+  std::string a = dataDir + "a.cpp";
+  std::string b = dataDir + "b.cpp";
+  std::string c = dataDir + "c.cpp";
+  std::string crash = dataDir + "crash.cpp";
+  const char *argv[] = {"foo",     a.c_str(), crash.c_str(), b.c_str(),
+                        c.c_str(), "--",      "-xc++"};
+  int argc = sizeof(argv) / sizeof(argv[0]);
+
+  auto result = clang::tooling::CommonOptionsParser::create(
+      argc, argv, MyToolCategory, llvm::cl::OneOrMore);
+  ASSERT_TRUE(!!result);
+  clang::tooling::CommonOptionsParser &optionsParser = result.get();
+
+  std::map<std::string, clang::tooling::Replacements> replacements;
+  clangmetatool::MetaToolFactory<clangmetatool::MetaTool<MyTool>> raf(
+      replacements);
+
+  std::string O;
+  llvm::raw_string_ostream os(O);
+  testing::internal::CaptureStderr();
+  int r = raf.runShardedAndExportFixes(optionsParser.getCompilations(),
+                                       optionsParser.getSourcePathList(), 2,
+                                       os);
+  std::string errors = testing::internal::GetCapturedStderr();
+  EXPECT_EQ(1, r);
+
+  // Only crash.cpp is reported
+  EXPECT_NE(std::string::npos,
+            errors.find("the worker processing " + crash + " crashed"));
+  for (const std::string &path : {a, b, c}) {
+    EXPECT_EQ(std::string::npos, errors.find(path)) << path;
+  }
+
+  // The fixes of the other translation units, c.cpp included, are
+  // still exported
+  std::set<clang::tooling::Replacement> expected = {
+      clang::tooling::Replacement(a, 25, 0, "new_"),
+      clang::tooling::Replacement(b, 25, 0, "new_"),
+      clang::tooling::Replacement(c, 4, 0, "new_"),
+      clang::tooling::Replacement(dataDir + "shared.h", 0, 0, "// shared\n"),
+  };
+  llvm::yaml::Input replacementsYaml(os.str(), nullptr, &eatDiagnostics);
+  clang::tooling::TranslationUnitReplacements TURs;
+  replacementsYaml >> TURs;
+  ASSERT_FALSE(replacementsYaml.error());
+  EXPECT_EQ(expected,
+            std::set<clang::tooling::Replacement>(TURs.Replacements.begin(),
+                                                  TURs.Replacements.end()));
+}
+
+
+TEST(ShardedExecutor, reportsShardsThatCannotStart) {
+  // Lower the limit to the lowest free file descriptor, so that no
+  // worker gets a pipe
+  struct rlimit limit;
+  ASSERT_EQ(0, getrlimit(RLIMIT_NOFILE, &limit));
+  int next = dup(0);
+  ASSERT_LE(0, next);
+  close(next);
+  struct rlimit lowered = limit;
+  lowered.rlim_cur = next;
+  ASSERT_EQ(0, setrlimit(RLIMIT_NOFILE, &lowered));
+
+  std::vector<int> statuses(3, 0);
+  std::vector<int> reports(3, 0);
+  clangmetatool::ShardedExecutor executor(2);
+  executor.run(
+      statuses.size(), [](size_t, std::string &) { return 0; },
+      [&](size_t i, int status, const std::string &) {
+        statuses[i] = status;
+        ++reports[i];
+      });
+  ASSERT_EQ(0, setrlimit(RLIMIT_NOFILE, &limit));
+
+  for (size_t i = 0; i < statuses.size(); ++i) {
+    EXPECT_EQ(clangmetatool::ShardedExecutor::notStartedStatus, statuses[i])
+        << i;
+    EXPECT_EQ(1, reports[i]) << i;
+  }
+}
+
+// ----------------------------------------------------------------------------
+// Copyright 2026 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,154 @@
+#include "clangmetatool-testconfig.h"
+
+#include <cstdio>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <clangmetatool/meta_tool.h>
+#include <clangmetatool/meta_tool_factory.h>
+#include <clangmetatool/result_cache.h>
+#include <clangmetatool/translation_unit_history.h>
+
+#include <clang/Frontend/FrontendAction.h>
+#include <clang/Tooling/CommonOptionsParser.h>
+#include <clang/Tooling/Core/Replacement.h>
+#include <clang/Tooling/Tooling.h>
+#include <llvm/Support/CommandLine.h>
+#include <llvm/Support/FileSystem.h>
+
+namespace {
+
+class MyTool {
+public:
+  MyTool(clang::CompilerInstance *ci, clang::ast_matchers::MatchFinder *f) {}
+
+  void postProcessing(
+      std::map<std::string, clang::tooling::Replacements> &replacementsMap) {}
+};
+
+} // anonymous namespace
+
+TEST(TranslationUnitHistory, scheduleMostExpensiveFirst) {
+  std::string historyFile =
+      CMAKE_BINARY_DIR "/t/047-translation-unit-history.schedule";
+  std::remove(historyFile.c_str());
+
+  clangmetatool::TranslationUnitHistory history(historyFile);
+  EXPECT_EQ(nullptr, history.lookup("a.cpp"));
+
+  history.record("a.cpp", {1.0, 10});
+  history.record("b.cpp", {3.0, 30});
+  history.record("c.cpp", {2.0, 20});
+
+  // unknown translation units come first
+  EXPECT_EQ(std::vector<size_t>({3, 1, 2, 0}),
+            history.schedule({"a.cpp", "b.cpp", "c.cpp", "d.cpp"}));
+
+  ASSERT_FALSE(history.save());
+
+  clangmetatool::TranslationUnitHistory reloaded(historyFile);
+  ASSERT_NE(nullptr, reloaded.lookup("b.cpp"));
+  EXPECT_EQ(3.0, reloaded.lookup("b.cpp")->wallSeconds);
+  EXPECT_EQ(30u, reloaded.lookup("b.cpp")->processPeakMemoryKB);
+  EXPECT_EQ(std::vector<size_t>({1, 2, 0}),
+            reloaded.schedule({"a.cpp", "b.cpp", "c.cpp"}));
+}
+
+TEST(TranslationUnitHistory, recordedByParallelRun) {
+  std::string historyFile =
+      CMAKE_BINARY_DIR "/t/047-translation-unit-history.run";
+  std::remove(historyFile.c_str());
+
+  llvm::cl::OptionCategory MyToolCategory("my-tool options");
+
+  std::string light =
+      CMAKE_SOURCE_DIR "/t/data/047-translation-unit-history/light.cpp";
+  std::string heavy =
+      CMAKE_SOURCE_DIR "/t/data/047-translation-unit-history/heavy.cpp";
+  const char *argv[] = {"foo", light.c_str(), heavy.c_str(), "--", "-xc++"};
+  int argc = sizeof(argv) / sizeof(argv[0]);
+
+  auto result = clang::tooling::CommonOptionsParser::create(
+      argc, argv, MyToolCategory, llvm::cl::OneOrMore);
+  ASSERT_TRUE(!!result);
+  clang::tooling::CommonOptionsParser &optionsParser = result.get();
+
+  clangmetatool::TranslationUnitHistory history(historyFile);
+
+  std::map<std::string, clang::tooling::Replacements> replacements;
+  clangmetatool::MetaToolFactory<clangmetatool::MetaTool<MyTool>> raf(
+      replacements);
+  raf.setHistory(&history);
+  int r = raf.runParallel(optionsParser.getCompilations(),
+                          optionsParser.getSourcePathList(), 2);
+  ASSERT_EQ(0, r);
+
+  for (const auto &path : optionsParser.getSourcePathList()) {
+    const auto *record = history.lookup(path);
+    ASSERT_NE(nullptr, record);
+    EXPECT_LT(0.0, record->wallSeconds);
+    EXPECT_LT(0u, record->processPeakMemoryKB);
+  }
+  ASSERT_FALSE(history.save());
+}
+
+TEST(TranslationUnitHistory, cacheHitsAreNotRecorded) {
+  std::string dir = CMAKE_BINARY_DIR "/t/047-translation-unit-history.cache";
+  llvm::sys::fs::remove_directories(dir);
+
+  llvm::cl::OptionCategory MyToolCategory("my-tool options");
+
+  std::string light =
+      CMAKE_SOURCE_DIR "/t/data/047-translation-unit-history/light.cpp";
+  const char *argv[] = {"foo", light.c_str(), "--", "-xc++"};
+  int argc = sizeof(argv) / sizeof(argv[0]);
+
+  auto result = clang::tooling::CommonOptionsParser::create(
+      argc, argv, MyToolCategory, llvm::cl::OneOrMore);
+  ASSERT_TRUE(!!result);
+  clang::tooling::CommonOptionsParser &optionsParser = result.get();
+
+  clangmetatool::TranslationUnitHistory history(dir + "/history");
+  clangmetatool::ResultCache cache(dir + "/cache", "047");
+
+  std::map<std::string, clang::tooling::Replacements> replacements;
+  clangmetatool::MetaToolFactory<clangmetatool::MetaTool<MyTool>> raf(
+      replacements);
+  raf.setHistory(&history);
+  raf.setCache(&cache);
+
+  // the first run parses the translation unit and fills the cache
+  ASSERT_EQ(0, raf.runParallel(optionsParser.getCompilations(),
+                               optionsParser.getSourcePathList(), 1));
+  const auto *record = history.lookup(light);
+  ASSERT_NE(nullptr, record);
+
+  // the second one only reads the cache, which says nothing about what
+  // the translation unit costs
+  history.record(light, {1000.0, 1});
+  ASSERT_EQ(0, raf.runParallel(optionsParser.getCompilations(),
+                               optionsParser.getSourcePathList(), 1));
+  record = history.lookup(light);
+  ASSERT_NE(nullptr, record);
+  EXPECT_EQ(1000.0, record->wallSeconds);
+  EXPECT_EQ(1u, record->processPeakMemoryKB);
+}
+
+// ----------------------------------------------------------------------------
+// Copyright 2026 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
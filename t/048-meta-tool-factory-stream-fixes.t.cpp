@@ -0,0 +1,121 @@
+#include "clangmetatool-testconfig.h"
+
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <clangmetatool/collectors/find_functions.h>
+#include <clangmetatool/meta_tool.h>
+#include <clangmetatool/meta_tool_factory.h>
+
+#include <clang/Frontend/FrontendAction.h>
+#include <clang/Tooling/CommonOptionsParser.h>
+#include <clang/Tooling/Core/Replacement.h>
+#include <clang/Tooling/Refactoring.h>
+#include <clang/Tooling/Tooling.h>
+#include <llvm/Support/CommandLine.h>
+#include <llvm/Support/Error.h>
+#include <llvm/Support/YAMLTraits.h>
+#include <llvm/Support/raw_ostream.h>
+
+namespace {
+
+const std::string dataDir =
+    CMAKE_SOURCE_DIR "/t/data/048-meta-tool-factory-stream-fixes/";
+
+class MyTool {
+private:
+  clang::CompilerInstance *ci;
+  clangmetatool::collectors::FindFunctions ff;
+
+public:
+  MyTool(clang::CompilerInstance *ci, clang::ast_matchers::MatchFinder *f)
+      : ci(ci), ff(ci, f) {}
+
+  void postProcessing(
+      std::map<std::string, clang::tooling::Replacements> &replacementsMap) {
+    clang::SourceManager &sm = ci->getSourceManager();
+    for (const auto &fn : *ff.getData()) {
+      auto nameSource = fn->getNameInfo().getSourceRange();
+      clang::tooling::Replacement r(sm, nameSource.getBegin(), 0, "new_");
+      llvm::consumeError(replacementsMap[r.getFilePath().str()].add(r));
+    }
+
+    // Every translation unit asks for the same edit on the shared header
+    clang::tooling::Replacement r(dataDir + "shared.h", 0, 0, "// shared\n");
+    llvm::consumeError(replacementsMap[r.getFilePath().str()].add(r));
+  }
+};
+
+static void eatDiagnostics(const llvm::SMDiagnostic &, void *) {}
+
+} // anonymous namespace
+
+LLVM_YAML_IS_DOCUMENT_LIST_VECTOR(clang::tooling::TranslationUnitReplacements)
+
+TEST(MetaToolFactoryStreamFixes, oneDocumentPerTranslationUnit) {
+  llvm::cl::OptionCategory MyToolCategory("my-tool options");
+
+  std::string a = dataDir + "a.cpp";
+  std::string b = dataDir + "b.cpp";
+  const char *argv[] = {"foo", a.c_str(), b.c_str(), "--", "-xc++"};
+  int argc = sizeof(argv) / sizeof(argv[0]);
+
+  auto result = clang::tooling::CommonOptionsParser::create(
+      argc, argv, MyToolCategory, llvm::cl::OneOrMore);
+  ASSERT_TRUE(!!result);
+  clang::tooling::CommonOptionsParser &optionsParser = result.get();
+
+  std::map<std::string, clang::tooling::Replacements> replacements;
+  clangmetatool::MetaToolFactory<clangmetatool::MetaTool<MyTool>> raf(
+      replacements);
+
+  std::string O;
+  llvm::raw_string_ostream os(O);
+  int r = raf.runAndStreamFixes(optionsParser.getCompilations(),
+                                optionsParser.getSourcePathList(), os);
+  ASSERT_EQ(0, r);
+
+  // Nothing is kept around in the factory
+  EXPECT_TRUE(replacements.empty());
+
+  std::vector<clang::tooling::TranslationUnitReplacements> documents;
+  llvm::yaml::Input replacementsYaml(os.str(), nullptr, &eatDiagnostics);
+  replacementsYaml >> documents;
+  ASSERT_FALSE(replacementsYaml.error());
+  ASSERT_EQ(2u, documents.size());
+
+  std::map<std::string, std::set<clang::tooling::Replacement>> byTU;
+  for (const auto &doc : documents) {
+    byTU[doc.MainSourceFile].insert(doc.Replacements.begin(),
+                                    doc.Replacements.end());
+  }
+
+  clang::tooling::Replacement shared(dataDir + "shared.h", 0, 0,
+                                     "// shared\n");
+  EXPECT_EQ(std::set<clang::tooling::Replacement>(
+                {clang::tooling::Replacement(a, 25, 0, "new_"), shared}),
+            byTU[a]);
+  EXPECT_EQ(std::set<clang::tooling::Replacement>(
+                {clang::tooling::Replacement(b, 25, 0, "new_"), shared}),
+            byTU[b]);
+}
+
+// ----------------------------------------------------------------------------
+// Copyright 2026 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,181 @@
+#include "clangmetatool-testconfig.h"
+
+#include <map>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include <clangmetatool/meta_tool.h>
+#include <clangmetatool/meta_tool_factory.h>
+#include <clangmetatool/result_cache.h>
+
+#include <clang/ASTMatchers/ASTMatchFinder.h>
+#include <clang/Frontend/CompilerInstance.h>
+#include <clang/Frontend/FrontendAction.h>
+#include <clang/Tooling/CommonOptionsParser.h>
+#include <clang/Tooling/Core/Replacement.h>
+#include <clang/Tooling/Tooling.h>
+#include <llvm/Support/CommandLine.h>
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/raw_ostream.h>
+
+namespace {
+
+int parses = 0;
+
+class MyTool {
+private:
+  clang::CompilerInstance *ci;
+
+public:
+  MyTool(clang::CompilerInstance *ci, clang::ast_matchers::MatchFinder *f)
+      : ci(ci) {
+    ++parses;
+  }
+
+  void postProcessing(
+      std::map<std::string, clang::tooling::Replacements> &replacementsMap) {
+    clang::SourceManager &sm = ci->getSourceManager();
+    std::string mainFile =
+        sm.getFilename(sm.getLocForStartOfFile(sm.getMainFileID())).str();
+    clang::tooling::Replacement r(mainFile, 0, 0, "// visited\n");
+    llvm::consumeError(replacementsMap[mainFile].add(r));
+  }
+};
+
+void writeFile(const std::string &path, const std::string &contents) {
+  std::error_code ec;
+  llvm::raw_fd_ostream ofs(path, ec);
+  ASSERT_FALSE(ec);
+  ofs << contents;
+}
+
+int run(const char *source, clangmetatool::ResultCache &cache,
+        std::map<std::string, clang::tooling::Replacements> &replacements) {
+  llvm::cl::OptionCategory MyToolCategory("my-tool options");
+
+  const char *argv[] = {"foo", source, "--", "-xc++"};
+  int argc = sizeof(argv) / sizeof(argv[0]);
+
+  auto result = clang::tooling::CommonOptionsParser::create(
+      argc, argv, MyToolCategory, llvm::cl::OneOrMore);
+  if (!result) {
+    llvm::consumeError(result.takeError());
+    return -1;
+  }
+  clang::tooling::CommonOptionsParser &optionsParser = result.get();
+
+  clangmetatool::MetaToolFactory<clangmetatool::MetaTool<MyTool>> raf(
+      replacements);
+  raf.setCache(&cache);
+  return raf.runParallel(optionsParser.getCompilations(),
+                         optionsParser.getSourcePathList(), 1);
+}
+
+} // anonymous namespace
+
+TEST(ResultCache, skipsUnchangedTranslationUnits) {
+  std::string dir = CMAKE_BINARY_DIR "/t/049-result-cache";
+  llvm::sys::fs::remove_directories(dir);
+  ASSERT_FALSE(llvm::sys::fs::create_directories(dir + "/src"));
+
+  std::string header = dir + "/src/header.h";
+  std::string source = dir + "/src/main.cpp";
+  writeFile(header, "int f();\n");
+  writeFile(source, "#include \"header.h\"\nint g() { return f(); }\n");
+
+  clang::tooling::Replacement expected(source, 0, 0, "// visited\n");
+
+  {
+    clangmetatool::ResultCache cache(dir + "/cache", "049");
+    std::map<std::string, clang::tooling::Replacements> replacements;
+    parses = 0;
+    ASSERT_EQ(0, run(source.c_str(), cache, replacements));
+    EXPECT_EQ(1, parses);
+    ASSERT_EQ(1u, replacements[source].size());
+    EXPECT_EQ(expected, *replacements[source].begin());
+  }
+
+  // nothing changed, the stored replacements are used
+  {
+    clangmetatool::ResultCache cache(dir + "/cache", "049");
+    std::map<std::string, clang::tooling::Replacements> replacements;
+    parses = 0;
+    ASSERT_EQ(0, run(source.c_str(), cache, replacements));
+    EXPECT_EQ(0, parses);
+    ASSERT_EQ(1u, replacements[source].size());
+    EXPECT_EQ(expected, *replacements[source].begin());
+  }
+
+  // a different tool key doesn't share entries
+  {
+    clangmetatool::ResultCache cache(dir + "/cache", "049-other");
+    std::map<std::string, clang::tooling::Replacements> replacements;
+    parses = 0;
+    ASSERT_EQ(0, run(source.c_str(), cache, replacements));
+    EXPECT_EQ(1, parses);
+  }
+
+  // changing an included header invalidates the entry
+  writeFile(header, "int f();\nint h();\n");
+  {
+    clangmetatool::ResultCache cache(dir + "/cache", "049");
+    std::map<std::string, clang::tooling::Replacements> replacements;
+    parses = 0;
+    ASSERT_EQ(0, run(source.c_str(), cache, replacements));
+    EXPECT_EQ(1, parses);
+    ASSERT_EQ(1u, replacements[source].size());
+  }
+}
+
+TEST(ResultCache, noticesFilesThatAppear) {
+  std::string dir = CMAKE_BINARY_DIR "/t/049-result-cache-missing";
+  llvm::sys::fs::remove_directories(dir);
+  ASSERT_FALSE(llvm::sys::fs::create_directories(dir + "/src"));
+
+  std::string source = dir + "/src/main.cpp";
+  writeFile(source, "#if __has_include(\"extra.h\")\n#include \"extra.h\"\n"
+                    "#endif\nint g();\n");
+
+  {
+    clangmetatool::ResultCache cache(dir + "/cache", "049");
+    std::map<std::string, clang::tooling::Replacements> replacements;
+    parses = 0;
+    ASSERT_EQ(0, run(source.c_str(), cache, replacements));
+    EXPECT_EQ(1, parses);
+  }
+
+  {
+    clangmetatool::ResultCache cache(dir + "/cache", "049");
+    std::map<std::string, clang::tooling::Replacements> replacements;
+    parses = 0;
+    ASSERT_EQ(0, run(source.c_str(), cache, replacements));
+    EXPECT_EQ(0, parses);
+  }
+
+  // the header that wasn't there would now be included
+  writeFile(dir + "/src/extra.h", "int h();\n");
+  {
+    clangmetatool::ResultCache cache(dir + "/cache", "049");
+    std::map<std::string, clang::tooling::Replacements> replacements;
+    parses = 0;
+    ASSERT_EQ(0, run(source.c_str(), cache, replacements));
+    EXPECT_EQ(1, parses);
+  }
+}
+
+// ----------------------------------------------------------------------------
+// Copyright 2026 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
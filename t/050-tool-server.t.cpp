@@ -0,0 +1,202 @@
+#include "clangmetatool-testconfig.h"
+
+#include <map>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <clangmetatool/meta_tool.h>
+#include <clangmetatool/meta_tool_factory.h>
+#include <clangmetatool/tool_server.h>
+
+#include <clang/ASTMatchers/ASTMatchFinder.h>
+#include <clang/Basic/FileManager.h>
+#include <clang/Frontend/CompilerInstance.h>
+#include <clang/Frontend/FrontendAction.h>
+#include <clang/Frontend/PCHContainerOperations.h>
+#include <clang/Tooling/CompilationDatabase.h>
+#include <clang/Tooling/Core/Replacement.h>
+#include <clang/Tooling/Tooling.h>
+#include <llvm/Config/llvm-config.h>
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/VirtualFileSystem.h>
+#include <llvm/Support/raw_ostream.h>
+
+#include <unistd.h>
+
+namespace {
+
+int parses = 0;
+
+class MyTool {
+private:
+  clang::CompilerInstance *ci;
+
+public:
+  MyTool(clang::CompilerInstance *ci, clang::ast_matchers::MatchFinder *f)
+      : ci(ci) {
+    ++parses;
+  }
+
+  void postProcessing(
+      std::map<std::string, clang::tooling::Replacements> &replacementsMap) {
+    clang::SourceManager &sm = ci->getSourceManager();
+    std::string mainFile =
+        sm.getFilename(sm.getLocForStartOfFile(sm.getMainFileID())).str();
+    clang::tooling::Replacement r(mainFile, 0, 0, "// visited\n");
+    llvm::consumeError(replacementsMap[mainFile].add(r));
+  }
+};
+
+void writeFile(const std::string &path, const std::string &contents) {
+  std::error_code ec;
+  llvm::raw_fd_ostream ofs(path, ec);
+  ASSERT_FALSE(ec);
+  ofs << contents;
+}
+
+} // anonymous namespace
+
+TEST(ToolServer, keepsFileCachesBetweenRequests) {
+  std::string dir = CMAKE_BINARY_DIR "/t/050-tool-server";
+  llvm::sys::fs::remove_directories(dir);
+  ASSERT_FALSE(llvm::sys::fs::create_directories(dir));
+
+  std::string header = dir + "/header.h";
+  std::string source = dir + "/main.cpp";
+  std::string other = dir + "/other.cpp";
+  writeFile(header, "int f();\n");
+  writeFile(source, "#include \"header.h\"\n#if __has_include(\"extra.h\")\n"
+                    "#include \"extra.h\"\n#endif\nint g() { return f(); }\n");
+  writeFile(other, "int k();\n");
+
+  clang::tooling::FixedCompilationDatabase compilations(
+      dir, std::vector<std::string>({"-xc++"}));
+
+  // Socket paths are limited to about a hundred characters
+  std::string socketPath =
+      "/tmp/clangmetatool-050-" + std::to_string(getpid()) + ".sock";
+  clangmetatool::ToolServer server(socketPath);
+
+  std::vector<clang::FileManager *> fileManagers;
+  std::vector<size_t> numCachedFiles;
+  std::vector<size_t> numKeptFiles;
+  std::thread serverThread([&]() {
+    server.serve([&](const std::vector<std::string> &sourcePaths,
+                     llvm::raw_ostream &os) {
+      numKeptFiles.push_back(server.getNumCachedFiles());
+      std::map<std::string, clang::tooling::Replacements> replacements;
+      clangmetatool::MetaToolFactory<clangmetatool::MetaTool<MyTool>> raf(
+          replacements);
+      auto files = server.getFileManager(dir);
+      fileManagers.push_back(files.get());
+#if LLVM_VERSION_MAJOR >= 10
+      clang::tooling::ClangTool tool(
+          compilations, sourcePaths,
+          std::make_shared<clang::PCHContainerOperations>(),
+          llvm::vfs::getRealFileSystem(), files);
+#else
+      clang::tooling::ClangTool tool(
+          compilations, sourcePaths,
+          std::make_shared<clang::PCHContainerOperations>(),
+          server.getFileSystem());
+#endif
+      int r = tool.run(&raf);
+      numCachedFiles.push_back(server.getNumCachedFiles());
+      raf.exportFixes(os);
+      return r;
+    });
+  });
+
+  // wait for the server to be listening
+  std::string output;
+  int r = 1;
+  for (int attempt = 0; attempt < 100 && r != 0; ++attempt) {
+    output.clear();
+    llvm::raw_string_ostream os(output);
+    r = clangmetatool::ToolServer::request(socketPath, {source}, os);
+    os.flush();
+    if (r != 0) {
+      usleep(50000);
+    }
+  }
+  ASSERT_EQ(0, r);
+  EXPECT_EQ(1, parses);
+
+  // other users can't make the server run anything
+  llvm::sys::fs::file_status socketStatus;
+  ASSERT_FALSE(llvm::sys::fs::status(socketPath, socketStatus));
+  EXPECT_EQ(llvm::sys::fs::owner_read | llvm::sys::fs::owner_write,
+            socketStatus.permissions());
+  EXPECT_NE(std::string::npos, output.find("// visited"));
+
+  {
+    llvm::raw_string_ostream os(output);
+    EXPECT_EQ(0, clangmetatool::ToolServer::request(socketPath, {source}, os));
+  }
+  EXPECT_EQ(2, parses);
+
+  // changing the header drops the caches
+  writeFile(header, "int f();\nint h();\n");
+  {
+    llvm::raw_string_ostream os(output);
+    EXPECT_EQ(0, clangmetatool::ToolServer::request(socketPath, {source}, os));
+  }
+  EXPECT_EQ(3, parses);
+
+  // other.cpp doesn't open the header, changing it again keeps the
+  // caches for other.cpp once it is known, not for main.cpp
+  for (int i = 0; i < 2; ++i) {
+    llvm::raw_string_ostream os(output);
+    EXPECT_EQ(0, clangmetatool::ToolServer::request(socketPath, {other}, os));
+    writeFile(header, "int f();\nint h(int);\n");
+  }
+  {
+    llvm::raw_string_ostream os(output);
+    EXPECT_EQ(0, clangmetatool::ToolServer::request(socketPath, {source}, os));
+  }
+
+  // a header appearing where it was looked for drops the caches too
+  writeFile(dir + "/extra.h", "int e();\n");
+  {
+    llvm::raw_string_ostream os(output);
+    EXPECT_EQ(0, clangmetatool::ToolServer::request(socketPath, {other}, os));
+  }
+
+  EXPECT_EQ(0, clangmetatool::ToolServer::shutdown(socketPath));
+  serverThread.join();
+
+  ASSERT_EQ(7u, fileManagers.size());
+  // the main file and the header were cached by the first request, and
+  // reused by the second one
+  EXPECT_EQ(fileManagers[0], fileManagers[1]);
+  EXPECT_LE(2u, numCachedFiles[0]);
+  EXPECT_EQ(numCachedFiles[0], numCachedFiles[1]);
+  EXPECT_EQ(numCachedFiles[0], numKeptFiles[1]);
+  // and read again by the third one
+  EXPECT_EQ(0u, numKeptFiles[2]);
+  EXPECT_LE(2u, numCachedFiles[2]);
+  EXPECT_EQ(numCachedFiles[2], numKeptFiles[3]);
+  EXPECT_EQ(numCachedFiles[3], numKeptFiles[4]);
+  EXPECT_EQ(0u, numKeptFiles[5]);
+  EXPECT_EQ(0u, numKeptFiles[6]);
+}
+
+// ----------------------------------------------------------------------------
+// Copyright 2026 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,254 @@
+#include "clangmetatool-testconfig.h"
+
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include <clangmetatool/collectors/find_functions.h>
+#include <clangmetatool/collectors/include_graph.h>
+#include <clangmetatool/collectors/include_graph_data.h>
+#include <clangmetatool/meta_tool.h>
+#include <clangmetatool/meta_tool_factory.h>
+#include <clangmetatool/shared_prefix_pch.h>
+
+#include <clang/Frontend/FrontendAction.h>
+#include <clang/Tooling/CommonOptionsParser.h>
+#include <clang/Tooling/Core/Replacement.h>
+#include <clang/Tooling/Tooling.h>
+#include <llvm/Support/CommandLine.h>
+#include <llvm/Support/Error.h>
+#include <llvm/Support/FileSystem.h>
+
+namespace {
+
+const std::string dataDir =
+    CMAKE_SOURCE_DIR "/t/data/051-shared-prefix-pch/";
+
+class MyTool {
+private:
+  clangmetatool::collectors::FindFunctions ff;
+
+public:
+  MyTool(clang::CompilerInstance *ci, clang::ast_matchers::MatchFinder *f)
+      : ff(ci, f) {}
+
+  void postProcessing(
+      std::map<std::string, clang::tooling::Replacements> &replacementsMap) {
+    for (const auto &fn : *ff.getData()) {
+      auto &sm = fn->getASTContext().getSourceManager();
+      auto nameSource = fn->getNameInfo().getSourceRange();
+      clang::tooling::Replacement r(sm, nameSource.getBegin(), 0, "new_");
+      llvm::consumeError(replacementsMap[r.getFilePath().str()].add(r));
+    }
+  }
+};
+
+/**
+ * What the IncludeGraph collector saw of every translation unit, with
+ * files named and locations as offsets, so that runs can be compared.
+ */
+std::mutex summariesMutex;
+std::map<std::string, std::set<std::string>> *summaries = nullptr;
+
+class IncludeGraphTool {
+private:
+  clang::CompilerInstance *ci;
+  clangmetatool::collectors::IncludeGraph includeGraph;
+
+public:
+  IncludeGraphTool(clang::CompilerInstance *ci,
+                   clang::ast_matchers::MatchFinder *f)
+      : ci(ci), includeGraph(ci, f) {}
+
+  void postProcessing(
+      std::map<std::string, clang::tooling::Replacements> &replacementsMap) {
+    clangmetatool::collectors::IncludeGraphData *data = includeGraph.getData();
+    clang::SourceManager &sm = ci->getSourceManager();
+    auto name = [&](clangmetatool::types::FileUID uid) -> std::string {
+      auto it = data->fuid2name.find(uid);
+      return it == data->fuid2name.end() ? "<main>" : it->second;
+    };
+    auto edge = [&](const clangmetatool::types::FileGraphEdge &e) {
+      return name(e.first) + " -> " + name(e.second);
+    };
+
+    std::set<std::string> summary;
+    for (const auto &e : data->include_graph) {
+      summary.insert("include " + edge(e));
+    }
+    for (const auto &p : data->include_statements) {
+      summary.insert("statement " + edge(p.first) + " at " +
+                     std::to_string(sm.getFileOffset(p.second.getBegin())));
+    }
+    for (const auto &p : data->macro_references) {
+      const clang::Token &token = std::get<0>(p.second);
+      summary.insert("macro " + edge(p.first) + " " +
+                     token.getIdentifierInfo()->getName().str() + " at " +
+                     std::to_string(sm.getFileOffset(token.getLocation())));
+    }
+
+    std::string mainFile =
+        sm.getFilename(sm.getLocForStartOfFile(sm.getMainFileID())).str();
+    std::lock_guard<std::mutex> lock(summariesMutex);
+    (*summaries)[mainFile] = summary;
+  }
+};
+
+std::set<clang::tooling::Replacement> flatten(
+    const std::map<std::string, clang::tooling::Replacements> &replacements) {
+  std::set<clang::tooling::Replacement> result;
+  for (const auto &p : replacements) {
+    result.insert(p.second.begin(), p.second.end());
+  }
+  return result;
+}
+
+} // anonymous namespace
+
+TEST(SharedPrefixPCH, matchesRunWithoutPCH) {
+  llvm::cl::OptionCategory MyToolCategory("my-tool options");
+
+  std::string a = dataDir + "a.cpp";
+  std::string b = dataDir + "b.cpp";
+  std::string c = dataDir + "c.cpp";
+  const char *argv[] = {"foo", a.c_str(), b.c_str(), c.c_str(), "--", "-xc++"};
+  int argc = sizeof(argv) / sizeof(argv[0]);
+
+  auto result = clang::tooling::CommonOptionsParser::create(
+      argc, argv, MyToolCategory, llvm::cl::OneOrMore);
+  ASSERT_TRUE(!!result);
+  clang::tooling::CommonOptionsParser &optionsParser = result.get();
+
+  std::string pchDir = CMAKE_BINARY_DIR "/t/051-shared-prefix-pch";
+  llvm::sys::fs::remove_directories(pchDir);
+  clangmetatool::SharedPrefixPCH pch(pchDir);
+
+  // a.cpp and b.cpp share their first two includes, c.cpp shares nothing
+  ASSERT_EQ(1u, pch.build(optionsParser.getCompilations(),
+                          optionsParser.getSourcePathList()));
+  ASSERT_NE(nullptr, pch.lookup(a));
+  EXPECT_EQ(pch.lookup(a), pch.lookup(b));
+  EXPECT_EQ("#include \"common.h\"\n#include \"other.h\"\n",
+            pch.lookup(a)->text);
+  EXPECT_TRUE(llvm::sys::fs::exists(pch.lookup(a)->pchPath));
+  EXPECT_EQ(1u, pch.lookup(a)->inputs.count(dataDir + "common.h"));
+  EXPECT_EQ(nullptr, pch.lookup(c));
+
+  std::map<std::string, clang::tooling::Replacements> withPCH;
+  clangmetatool::MetaToolFactory<clangmetatool::MetaTool<MyTool>> raf(
+      withPCH);
+  raf.setSharedPrefixPCH(&pch);
+  ASSERT_EQ(0, raf.runParallel(optionsParser.getCompilations(),
+                               optionsParser.getSourcePathList(), 2));
+
+  // Blanking the prefix doesn't move anything in the source files
+  std::set<clang::tooling::Replacement> expected = {
+      clang::tooling::Replacement(a, 44, 0, "new_"),
+      clang::tooling::Replacement(b, 62, 0, "new_"),
+      clang::tooling::Replacement(c, 24, 0, "new_"),
+  };
+  EXPECT_EQ(expected, flatten(withPCH));
+
+  std::map<std::string, clang::tooling::Replacements> withoutPCH;
+  clangmetatool::MetaToolFactory<clangmetatool::MetaTool<MyTool>> plain(
+      withoutPCH);
+  ASSERT_EQ(0, plain.runParallel(optionsParser.getCompilations(),
+                                 optionsParser.getSourcePathList(), 2));
+  EXPECT_EQ(flatten(withoutPCH), flatten(withPCH));
+}
+
+TEST(SharedPrefixPCH, searchesSourceDirectoryFirst) {
+  llvm::cl::OptionCategory MyToolCategory("my-tool options");
+
+  std::string a = dataDir + "a.cpp";
+  std::string b = dataDir + "b.cpp";
+  std::string shadow = dataDir + "shadow";
+  const char *argv[] = {"foo", a.c_str(), b.c_str(), "--", "-xc++", "-iquote",
+                        shadow.c_str()};
+  int argc = sizeof(argv) / sizeof(argv[0]);
+
+  auto result = clang::tooling::CommonOptionsParser::create(
+      argc, argv, MyToolCategory, llvm::cl::OneOrMore);
+  ASSERT_TRUE(!!result);
+  clang::tooling::CommonOptionsParser &optionsParser = result.get();
+
+  std::string pchDir = CMAKE_BINARY_DIR "/t/051-shared-prefix-pch-iquote";
+  llvm::sys::fs::remove_directories(pchDir);
+  clangmetatool::SharedPrefixPCH pch(pchDir);
+  ASSERT_EQ(1u, pch.build(optionsParser.getCompilations(),
+                          optionsParser.getSourcePathList()));
+
+  // The source files find common.h next to them, before the -iquote
+  // directory, and so must the PCH
+  ASSERT_NE(nullptr, pch.lookup(a));
+  EXPECT_EQ(1u, pch.lookup(a)->inputs.count(dataDir + "common.h"));
+  EXPECT_EQ(0u, pch.lookup(a)->inputs.count(shadow + "/common.h"));
+}
+
+TEST(SharedPrefixPCH, isNotUsedWithPreprocessorCallbacks) {
+  llvm::cl::OptionCategory MyToolCategory("my-tool options");
+
+  std::string a = dataDir + "a.cpp";
+  std::string b = dataDir + "b.cpp";
+  std::string c = dataDir + "c.cpp";
+  const char *argv[] = {"foo", a.c_str(), b.c_str(), c.c_str(), "--", "-xc++"};
+  int argc = sizeof(argv) / sizeof(argv[0]);
+
+  auto result = clang::tooling::CommonOptionsParser::create(
+      argc, argv, MyToolCategory, llvm::cl::OneOrMore);
+  ASSERT_TRUE(!!result);
+  clang::tooling::CommonOptionsParser &optionsParser = result.get();
+
+  std::string pchDir = CMAKE_BINARY_DIR "/t/051-shared-prefix-pch-callbacks";
+  llvm::sys::fs::remove_directories(pchDir);
+  clangmetatool::SharedPrefixPCH pch(pchDir);
+  ASSERT_EQ(1u, pch.build(optionsParser.getCompilations(),
+                          optionsParser.getSourcePathList()));
+
+  typedef clangmetatool::MetaToolFactory<
+      clangmetatool::MetaTool<IncludeGraphTool>>
+      Factory;
+
+  std::map<std::string, std::set<std::string>> withPCH;
+  summaries = &withPCH;
+  std::map<std::string, clang::tooling::Replacements> replacements;
+  Factory raf(replacements);
+  raf.setSharedPrefixPCH(&pch);
+  ASSERT_EQ(0, raf.runParallel(optionsParser.getCompilations(),
+                               optionsParser.getSourcePathList(), 2));
+
+  std::map<std::string, std::set<std::string>> withoutPCH;
+  summaries = &withoutPCH;
+  Factory plain(replacements);
+  ASSERT_EQ(0, plain.runParallel(optionsParser.getCompilations(),
+                                 optionsParser.getSourcePathList(), 2));
+  summaries = nullptr;
+
+  // The includes of the prefix, and the macros they define, are seen as
+  // if there was no precompiled prefix
+  ASSERT_EQ(3u, withoutPCH.size());
+  EXPECT_EQ(1u, withoutPCH[a].count("include <main> -> common.h"));
+  EXPECT_EQ(1u, withoutPCH[a].count("statement <main> -> other.h at 20"));
+  EXPECT_EQ(1u, withoutPCH[b].count(
+                    "macro <main> -> common.h COMMON_VALUE at 114"));
+  EXPECT_EQ(withoutPCH, withPCH);
+}
+
+// ----------------------------------------------------------------------------
+// Copyright 2026 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,119 @@
+#include "clangmetatool-testconfig.h"
+
+#include <map>
+#include <set>
+#include <string>
+#include <tuple>
+
+#include <gtest/gtest.h>
+
+#include <clangmetatool/collectors/find_functions.h>
+#include <clangmetatool/meta_tool.h>
+#include <clangmetatool/meta_tool_factory.h>
+#include <clangmetatool/phase_timings.h>
+
+#include <clang/Frontend/FrontendAction.h>
+#include <clang/Tooling/CommonOptionsParser.h>
+#include <clang/Tooling/Core/Replacement.h>
+#include <clang/Tooling/Tooling.h>
+#include <llvm/ADT/StringRef.h>
+#include <llvm/Support/CommandLine.h>
+#include <llvm/Support/raw_ostream.h>
+
+namespace {
+
+const std::string dataDir = CMAKE_SOURCE_DIR "/t/data/052-phase-timings/";
+
+class MyTool {
+private:
+  clangmetatool::collectors::FindFunctions ff;
+
+public:
+  MyTool(clang::CompilerInstance *ci, clang::ast_matchers::MatchFinder *f)
+      : ff(ci, f) {}
+
+  void postProcessing(
+      std::map<std::string, clang::tooling::Replacements> &replacementsMap) {
+    EXPECT_EQ(1u, ff.getData()->size());
+  }
+};
+
+} // anonymous namespace
+
+TEST(PhaseTimings, recordedForEveryTranslationUnit) {
+  llvm::cl::OptionCategory MyToolCategory("my-tool options");
+
+  std::string a = dataDir + "a.cpp";
+  std::string b = dataDir + "b.cpp";
+  const char *argv[] = {"foo", a.c_str(), b.c_str(), "--", "-xc++"};
+  int argc = sizeof(argv) / sizeof(argv[0]);
+
+  auto result = clang::tooling::CommonOptionsParser::create(
+      argc, argv, MyToolCategory, llvm::cl::OneOrMore);
+  ASSERT_TRUE(!!result);
+  clang::tooling::CommonOptionsParser &optionsParser = result.get();
+
+  std::string jsonLines;
+  llvm::raw_string_ostream os(jsonLines);
+  clangmetatool::PhaseTimingsLog log(os);
+
+  std::map<std::string, clang::tooling::Replacements> replacements;
+  clangmetatool::MetaToolFactory<clangmetatool::MetaTool<MyTool>> raf(
+      replacements);
+  raf.setTimingsLog(&log);
+  ASSERT_EQ(0, raf.runParallel(optionsParser.getCompilations(),
+                               optionsParser.getSourcePathList(), 2));
+
+  auto timings = log.getTimings();
+  ASSERT_EQ(2u, timings.size());
+  std::set<std::string> files;
+  for (const auto &t : timings) {
+    files.insert(t.mainFile);
+    EXPECT_LE(0.0, t.setupSeconds);
+    EXPECT_LT(0.0, t.frontendSeconds);
+    EXPECT_LE(0.0, t.matchSeconds);
+    EXPECT_LE(0.0, t.postProcessingSeconds);
+    EXPECT_LE(t.setupSeconds + t.frontendSeconds + t.matchSeconds +
+                  t.postProcessingSeconds,
+              t.totalSeconds * 1.0001);
+    EXPECT_LT(0u, t.processPeakMemoryKB);
+  }
+  EXPECT_EQ(std::set<std::string>({a, b}), files);
+
+  // One JSON object per translation unit
+  os.flush();
+  llvm::StringRef rest(jsonLines);
+  size_t lines = 0;
+  while (!rest.empty()) {
+    llvm::StringRef line;
+    std::tie(line, rest) = rest.split('\n');
+    EXPECT_EQ('{', line.front());
+    EXPECT_NE(llvm::StringRef::npos, line.find("\"frontend\":"));
+    ++lines;
+  }
+  EXPECT_EQ(2u, lines);
+
+  // A serial run through ClangTool records timings as well
+  clangmetatool::PhaseTimingsLog serialLog;
+  raf.setTimingsLog(&serialLog);
+  clang::tooling::ClangTool tool(optionsParser.getCompilations(),
+                                 optionsParser.getSourcePathList());
+  ASSERT_EQ(0, tool.run(&raf));
+  EXPECT_EQ(2u, serialLog.getTimings().size());
+}
+
+// ----------------------------------------------------------------------------
+// Copyright 2026 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,127 @@
+#include "clangmetatool-testconfig.h"
+
+#include <map>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include <clangmetatool/collectors/find_functions.h>
+#include <clangmetatool/collectors/include_graph.h>
+#include <clangmetatool/match_forwarder.h>
+#include <clangmetatool/matcher_profile.h>
+#include <clangmetatool/meta_tool.h>
+#include <clangmetatool/meta_tool_factory.h>
+
+#include <clang/Frontend/FrontendAction.h>
+#include <clang/Tooling/CommonOptionsParser.h>
+#include <clang/Tooling/Core/Replacement.h>
+#include <clang/Tooling/Tooling.h>
+#include <llvm/Support/CommandLine.h>
+#include <llvm/Support/raw_ostream.h>
+
+namespace {
+
+const std::string dataDir = CMAKE_SOURCE_DIR "/t/data/053-matcher-profile/";
+
+class MyTool {
+private:
+  clangmetatool::collectors::FindFunctions ff;
+  clangmetatool::collectors::IncludeGraph ig;
+  clangmetatool::MatchForwarder mf;
+
+public:
+  MyTool(clang::CompilerInstance *ci, clang::ast_matchers::MatchFinder *f)
+      : ff(ci, f), ig(ci, f), mf(f, "Forwarded::Functions") {
+    using namespace clang::ast_matchers;
+    mf.addMatcher(functionDecl(),
+                  [](const clangmetatool::MatchForwarder::ResultType &) {});
+  }
+
+  void postProcessing(
+      std::map<std::string, clang::tooling::Replacements> &replacementsMap) {}
+};
+
+} // anonymous namespace
+
+TEST(MatcherProfile, attributesTimeToCollectors) {
+  llvm::cl::OptionCategory MyToolCategory("my-tool options");
+
+  std::string a = dataDir + "a.cpp";
+  std::string b = dataDir + "b.cpp";
+  const char *argv[] = {"foo", a.c_str(), b.c_str(), "--", "-xc++"};
+  int argc = sizeof(argv) / sizeof(argv[0]);
+
+  auto result = clang::tooling::CommonOptionsParser::create(
+      argc, argv, MyToolCategory, llvm::cl::OneOrMore);
+  ASSERT_TRUE(!!result);
+  clang::tooling::CommonOptionsParser &optionsParser = result.get();
+
+  clangmetatool::MatcherProfile profile;
+  std::map<std::string, clang::tooling::Replacements> replacements;
+  clangmetatool::MetaToolFactory<clangmetatool::MetaTool<MyTool>> raf(
+      replacements);
+  raf.setMatcherProfile(&profile);
+  ASSERT_EQ(0, raf.runParallel(optionsParser.getCompilations(),
+                               optionsParser.getSourcePathList(), 2));
+
+  EXPECT_EQ(2u, profile.getNumTranslationUnits());
+
+  auto callbacks = profile.getCallbacks();
+  EXPECT_EQ(1u, callbacks.count("FindFunctions::AnnotateFunction"));
+  EXPECT_EQ(1u, callbacks.count("IncludeGraph::FindDeclRefMatchCallback"));
+  EXPECT_EQ(1u, callbacks.count("Forwarded::Functions"));
+
+  auto collectors = profile.getCollectors();
+  EXPECT_EQ(1u, collectors.count("FindFunctions"));
+  EXPECT_EQ(1u, collectors.count("IncludeGraph"));
+  EXPECT_EQ(1u, collectors.count("Forwarded"));
+  EXPECT_EQ(0u, collectors.count("MatchForwarder"));
+  EXPECT_EQ(0u, collectors.count("<unknown>"));
+
+  std::string report;
+  llvm::raw_string_ostream os(report);
+  profile.printReport(os);
+  os.flush();
+  EXPECT_NE(std::string::npos, report.find("over 2 translation units"));
+  EXPECT_NE(std::string::npos, report.find("FindFunctions::AnnotateFunction"));
+  EXPECT_NE(std::string::npos, report.find("IncludeGraph\n"));
+}
+
+TEST(MatcherProfile, notCollectedByDefault) {
+  llvm::cl::OptionCategory MyToolCategory("my-tool options");
+
+  std::string b = dataDir + "b.cpp";
+  const char *argv[] = {"foo", b.c_str(), "--", "-xc++"};
+  int argc = sizeof(argv) / sizeof(argv[0]);
+
+  auto result = clang::tooling::CommonOptionsParser::create(
+      argc, argv, MyToolCategory, llvm::cl::OneOrMore);
+  ASSERT_TRUE(!!result);
+  clang::tooling::CommonOptionsParser &optionsParser = result.get();
+
+  clangmetatool::MatcherProfile profile;
+  std::map<std::string, clang::tooling::Replacements> replacements;
+  clangmetatool::MetaToolFactory<clangmetatool::MetaTool<MyTool>> raf(
+      replacements);
+  raf.setMatcherProfile(&profile);
+  raf.setMatcherProfile(nullptr);
+  ASSERT_EQ(0, raf.runParallel(optionsParser.getCompilations(),
+                               optionsParser.getSourcePathList(), 1));
+  EXPECT_EQ(0u, profile.getNumTranslationUnits());
+}
+
+// ----------------------------------------------------------------------------
+// Copyright 2026 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
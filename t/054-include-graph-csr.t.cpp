@@ -0,0 +1,147 @@
+#include "clangmetatool-testconfig.h"
+
+#include <algorithm>
+#include <map>
+#include <set>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include <clangmetatool/collectors/include_graph.h>
+#include <clangmetatool/collectors/include_graph_data.h>
+#include <clangmetatool/include_graph_csr.h>
+#include <clangmetatool/include_graph_dependencies.h>
+#include <clangmetatool/meta_tool.h>
+#include <clangmetatool/meta_tool_factory.h>
+
+#include <clang/Frontend/FrontendAction.h>
+#include <clang/Tooling/CommonOptionsParser.h>
+#include <clang/Tooling/Core/Replacement.h>
+#include <clang/Tooling/Refactoring.h>
+#include <clang/Tooling/Tooling.h>
+#include <llvm/Support/CommandLine.h>
+
+namespace {
+
+using clangmetatool::IncludeGraphCSR;
+using clangmetatool::IncludeGraphDependencies;
+using clangmetatool::types::FileUID;
+
+class CSRTool {
+private:
+  clang::CompilerInstance *ci;
+  clangmetatool::collectors::IncludeGraph includeGraph;
+
+public:
+  CSRTool(clang::CompilerInstance *ci, clang::ast_matchers::MatchFinder *f)
+      : ci(ci), includeGraph(ci, f) {}
+
+  void postProcessing(
+      std::map<std::string, clang::tooling::Replacements> &replacementsMap) {
+    clangmetatool::collectors::IncludeGraphData *data = includeGraph.getData();
+    IncludeGraphCSR csr(data);
+
+    clang::SourceManager &sm = ci->getSourceManager();
+    FileUID mainFile = sm.getFileEntryForID(sm.getMainFileID())->getUID();
+
+    // The main file and every included file are in the view
+    ASSERT_EQ(data->fuid2name.size() + 1, csr.numNodes());
+    IncludeGraphCSR::Index index;
+    EXPECT_TRUE(csr.findIndex(mainFile, index));
+    for (const auto &file : data->fuid2name) {
+      EXPECT_TRUE(csr.findIndex(file.first, index)) << file.second;
+    }
+
+    // Every edge is in the view, and only those
+    EXPECT_EQ(data->include_graph.size(),
+              csr.getIncludeGraph().numEdges());
+    EXPECT_EQ(data->use_graph.size(), csr.getUseGraph().numEdges());
+    for (const auto &edge : data->include_graph) {
+      IncludeGraphCSR::Index from, to;
+      ASSERT_TRUE(csr.findIndex(edge.first, from));
+      ASSERT_TRUE(csr.findIndex(edge.second, to));
+      EXPECT_EQ(edge.first, csr.getUID(from));
+      auto successors = csr.getIncludeGraph().successors(from);
+      EXPECT_NE(successors.end(),
+                std::find(successors.begin(), successors.end(), to));
+    }
+
+    // The queries give the same answers on the view
+    for (IncludeGraphCSR::Index i = 0; i < csr.numNodes(); ++i) {
+      FileUID uid = csr.getUID(i);
+      EXPECT_EQ(IncludeGraphDependencies::collectAllIncludes(data, uid),
+                IncludeGraphDependencies::collectAllIncludes(&csr, uid))
+          << uid;
+      EXPECT_EQ(IncludeGraphDependencies::liveDependencies(data, uid),
+                IncludeGraphDependencies::liveDependencies(&csr, uid))
+          << uid;
+      EXPECT_EQ(IncludeGraphDependencies::liveWeakDependencies(data, uid),
+                IncludeGraphDependencies::liveWeakDependencies(&csr, uid))
+          << uid;
+    }
+
+    std::map<std::string, FileUID> fname2uid;
+    for (const auto &file : data->fuid2name) {
+      fname2uid[file.second] = file.first;
+    }
+
+    // def1.h is first reached through a.h, def2.h through b.h
+    std::set<FileUID> expected = {fname2uid["a.h"], fname2uid["b.h"]};
+    EXPECT_EQ(expected,
+              IncludeGraphDependencies::liveDependencies(&csr, mainFile));
+
+    IncludeGraphDependencies::DirectDependenciesMap expectedWeak = {
+        {fname2uid["def1.h"], {fname2uid["a.h"], fname2uid["b.h"]}},
+        {fname2uid["def2.h"], {fname2uid["b.h"], fname2uid["diam.h"]}},
+    };
+    EXPECT_EQ(expectedWeak,
+              IncludeGraphDependencies::liveWeakDependencies(&csr, mainFile));
+
+    // Files that are not part of the graph have no dependencies
+    FileUID unknown = csr.getUID(csr.numNodes() - 1) + 1;
+    EXPECT_TRUE(
+        IncludeGraphDependencies::liveDependencies(&csr, unknown).empty());
+    EXPECT_EQ(std::set<FileUID>{unknown},
+              IncludeGraphDependencies::collectAllIncludes(&csr, unknown));
+  }
+};
+
+} // anonymous namespace
+
+TEST(IncludeGraphCSR, matchesIncludeGraphData) {
+  llvm::cl::OptionCategory MyToolCategory("my-tool options");
+
+  const char *argv[] = {
+      "foo", CMAKE_SOURCE_DIR "/t/data/054-include-graph-csr/foo.cpp", "--",
+      "-xc++"};
+  int argc = sizeof(argv) / sizeof(argv[0]);
+
+  auto result = clang::tooling::CommonOptionsParser::create(
+      argc, argv, MyToolCategory, llvm::cl::OneOrMore);
+  ASSERT_TRUE(!!result);
+  clang::tooling::CommonOptionsParser &optionsParser = result.get();
+
+  clang::tooling::RefactoringTool tool(optionsParser.getCompilations(),
+                                       optionsParser.getSourcePathList());
+
+  clangmetatool::MetaToolFactory<clangmetatool::MetaTool<CSRTool>> raf(
+      tool.getReplacements());
+
+  ASSERT_EQ(0, tool.run(&raf));
+}
+
+// ----------------------------------------------------------------------------
+// Copyright 2026 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
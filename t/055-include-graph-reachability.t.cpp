@@ -0,0 +1,132 @@
+#include "clangmetatool-testconfig.h"
+
+#include <map>
+#include <set>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include <clangmetatool/collectors/include_graph.h>
+#include <clangmetatool/collectors/include_graph_data.h>
+#include <clangmetatool/include_graph_csr.h>
+#include <clangmetatool/include_graph_dependencies.h>
+#include <clangmetatool/include_graph_reachability.h>
+#include <clangmetatool/meta_tool.h>
+#include <clangmetatool/meta_tool_factory.h>
+
+#include <clang/Frontend/FrontendAction.h>
+#include <clang/Tooling/CommonOptionsParser.h>
+#include <clang/Tooling/Core/Replacement.h>
+#include <clang/Tooling/Refactoring.h>
+#include <clang/Tooling/Tooling.h>
+#include <llvm/Support/CommandLine.h>
+
+namespace {
+
+using clangmetatool::IncludeGraphCSR;
+using clangmetatool::IncludeGraphDependencies;
+using clangmetatool::IncludeGraphReachability;
+using clangmetatool::types::FileUID;
+
+class ReachabilityTool {
+private:
+  clang::CompilerInstance *ci;
+  clangmetatool::collectors::IncludeGraph includeGraph;
+
+public:
+  ReachabilityTool(clang::CompilerInstance *ci,
+                   clang::ast_matchers::MatchFinder *f)
+      : ci(ci), includeGraph(ci, f) {}
+
+  void postProcessing(
+      std::map<std::string, clang::tooling::Replacements> &replacementsMap) {
+    clangmetatool::collectors::IncludeGraphData *data = includeGraph.getData();
+    IncludeGraphCSR csr(data);
+    IncludeGraphReachability reachability(&csr);
+
+    std::map<std::string, FileUID> uid;
+    for (const auto &file : data->fuid2name) {
+      uid[file.second] = file.first;
+    }
+    clang::SourceManager &sm = ci->getSourceManager();
+    uid["foo.cpp"] = sm.getFileEntryForID(sm.getMainFileID())->getUID();
+
+    // a.h and b.h include each other
+    ASSERT_EQ(5u, csr.numNodes());
+    EXPECT_EQ(4u, reachability.numComponents());
+    IncludeGraphCSR::Index a, b, d;
+    ASSERT_TRUE(csr.findIndex(uid["a.h"], a));
+    ASSERT_TRUE(csr.findIndex(uid["b.h"], b));
+    ASSERT_TRUE(csr.findIndex(uid["d.h"], d));
+    EXPECT_EQ(reachability.getComponent(a), reachability.getComponent(b));
+    EXPECT_GT(reachability.getComponent(a), reachability.getComponent(d));
+
+    EXPECT_TRUE(reachability.isReachable(uid["a.h"], uid["b.h"]));
+    EXPECT_TRUE(reachability.isReachable(uid["b.h"], uid["a.h"]));
+    EXPECT_TRUE(reachability.isReachable(uid["a.h"], uid["a.h"]));
+    EXPECT_TRUE(reachability.isReachable(uid["foo.cpp"], uid["d.h"]));
+    EXPECT_TRUE(reachability.isReachable(uid["c.h"], uid["d.h"]));
+    EXPECT_FALSE(reachability.isReachable(uid["c.h"], uid["a.h"]));
+    EXPECT_FALSE(reachability.isReachable(uid["d.h"], uid["b.h"]));
+    EXPECT_FALSE(reachability.isReachable(uid["a.h"], uid["foo.cpp"]));
+
+    std::set<FileUID> expected = {uid["a.h"], uid["b.h"], uid["d.h"]};
+    EXPECT_EQ(expected, IncludeGraphDependencies::collectAllIncludes(
+                            &reachability, uid["b.h"]));
+
+    // The index gives the same answers as a traversal
+    for (IncludeGraphCSR::Index i = 0; i < csr.numNodes(); ++i) {
+      FileUID file = csr.getUID(i);
+      std::set<FileUID> all =
+          IncludeGraphDependencies::collectAllIncludes(data, file);
+      EXPECT_EQ(all, IncludeGraphDependencies::collectAllIncludes(
+                         &reachability, file))
+          << file;
+      for (IncludeGraphCSR::Index j = 0; j < csr.numNodes(); ++j) {
+        EXPECT_EQ(all.count(csr.getUID(j)) > 0,
+                  reachability.isReachable(file, csr.getUID(j)))
+            << file << " " << csr.getUID(j);
+      }
+    }
+  }
+};
+
+} // anonymous namespace
+
+TEST(IncludeGraphReachability, condensesIncludeCycles) {
+  llvm::cl::OptionCategory MyToolCategory("my-tool options");
+
+  const char *argv[] = {
+      "foo", CMAKE_SOURCE_DIR "/t/data/055-include-graph-reachability/foo.cpp",
+      "--", "-xc++"};
+  int argc = sizeof(argv) / sizeof(argv[0]);
+
+  auto result = clang::tooling::CommonOptionsParser::create(
+      argc, argv, MyToolCategory, llvm::cl::OneOrMore);
+  ASSERT_TRUE(!!result);
+  clang::tooling::CommonOptionsParser &optionsParser = result.get();
+
+  clang::tooling::RefactoringTool tool(optionsParser.getCompilations(),
+                                       optionsParser.getSourcePathList());
+
+  clangmetatool::MetaToolFactory<clangmetatool::MetaTool<ReachabilityTool>>
+      raf(tool.getReplacements());
+
+  ASSERT_EQ(0, tool.run(&raf));
+}
+
+// ----------------------------------------------------------------------------
+// Copyright 2026 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,121 @@
+#include "clangmetatool-testconfig.h"
+
+#include <map>
+#include <set>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include <clangmetatool/collectors/include_graph.h>
+#include <clangmetatool/collectors/include_graph_data.h>
+#include <clangmetatool/include_graph_csr.h>
+#include <clangmetatool/include_graph_dependencies.h>
+#include <clangmetatool/include_graph_reachability.h>
+#include <clangmetatool/meta_tool.h>
+#include <clangmetatool/meta_tool_factory.h>
+
+#include <clang/Frontend/FrontendAction.h>
+#include <clang/Tooling/CommonOptionsParser.h>
+#include <clang/Tooling/Core/Replacement.h>
+#include <clang/Tooling/Refactoring.h>
+#include <clang/Tooling/Tooling.h>
+#include <llvm/Support/CommandLine.h>
+
+namespace {
+
+using clangmetatool::IncludeGraphCSR;
+using clangmetatool::IncludeGraphDependencies;
+using clangmetatool::IncludeGraphReachability;
+using clangmetatool::types::FileUID;
+
+class AllLiveDependenciesTool {
+private:
+  clang::CompilerInstance *ci;
+  clangmetatool::collectors::IncludeGraph includeGraph;
+
+public:
+  AllLiveDependenciesTool(clang::CompilerInstance *ci,
+                          clang::ast_matchers::MatchFinder *f)
+      : ci(ci), includeGraph(ci, f) {}
+
+  void postProcessing(
+      std::map<std::string, clang::tooling::Replacements> &replacementsMap) {
+    clangmetatool::collectors::IncludeGraphData *data = includeGraph.getData();
+    IncludeGraphCSR csr(data);
+    IncludeGraphReachability reachability(&csr);
+
+    std::map<std::string, FileUID> uid;
+    for (const auto &file : data->fuid2name) {
+      uid[file.second] = file.first;
+    }
+    clang::SourceManager &sm = ci->getSourceManager();
+    uid["foo.cpp"] = sm.getFileEntryForID(sm.getMainFileID())->getUID();
+
+    IncludeGraphDependencies::LiveDependenciesMap all =
+        IncludeGraphDependencies::allLiveDependencies(&reachability);
+
+    // def1.h is first reached through a.h, def2.h through b.h, and
+    // def3.h through b.h, which includes b2.h, which includes b.h
+    std::set<FileUID> expected = {uid["a.h"], uid["b.h"]};
+    EXPECT_EQ(expected, all[uid["foo.cpp"]]);
+    // b.h comes first, having the lower uid, and reaches def3.h back
+    // through b2.h
+    expected = {uid["b.h"]};
+    EXPECT_EQ(expected, all[uid["b2.h"]]);
+    EXPECT_TRUE(all[uid["diam.h"]].empty());
+
+    // Every file of the graph gets the same answer as a traversal
+    ASSERT_EQ(csr.numNodes(), all.size());
+    for (const auto &file : all) {
+      EXPECT_EQ(IncludeGraphDependencies::liveDependencies(data, file.first),
+                file.second)
+          << file.first;
+      EXPECT_EQ(file.second, IncludeGraphDependencies::liveDependencies(
+                                 &reachability, file.first))
+          << file.first;
+    }
+  }
+};
+
+} // anonymous namespace
+
+TEST(IncludeGraphDependencies, allLiveDependencies) {
+  llvm::cl::OptionCategory MyToolCategory("my-tool options");
+
+  const char *argv[] = {
+      "foo",
+      CMAKE_SOURCE_DIR
+      "/t/data/056-include-graph-all-live-dependencies/foo.cpp",
+      "--", "-xc++"};
+  int argc = sizeof(argv) / sizeof(argv[0]);
+
+  auto result = clang::tooling::CommonOptionsParser::create(
+      argc, argv, MyToolCategory, llvm::cl::OneOrMore);
+  ASSERT_TRUE(!!result);
+  clang::tooling::CommonOptionsParser &optionsParser = result.get();
+
+  clang::tooling::RefactoringTool tool(optionsParser.getCompilations(),
+                                       optionsParser.getSourcePathList());
+
+  clangmetatool::MetaToolFactory<
+      clangmetatool::MetaTool<AllLiveDependenciesTool>>
+      raf(tool.getReplacements());
+
+  ASSERT_EQ(0, tool.run(&raf));
+}
+
+// ----------------------------------------------------------------------------
+// Copyright 2026 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,199 @@
+#include "clangmetatool-testconfig.h"
+
+#include <algorithm>
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include <clangmetatool/collectors/include_graph.h>
+#include <clangmetatool/collectors/include_graph_data.h>
+#include <clangmetatool/include_graph_dependencies.h>
+#include <clangmetatool/meta_tool.h>
+#include <clangmetatool/meta_tool_factory.h>
+#include <clangmetatool/project_include_graph.h>
+
+#include <clang/Frontend/FrontendAction.h>
+#include <clang/Tooling/CommonOptionsParser.h>
+#include <clang/Tooling/Core/Replacement.h>
+#include <clang/Tooling/Tooling.h>
+#include <llvm/ADT/SmallString.h>
+#include <llvm/Support/CommandLine.h>
+#include <llvm/Support/FileSystem.h>
+
+namespace {
+
+using clangmetatool::IncludeGraphDependencies;
+using clangmetatool::ProjectIncludeGraph;
+using clangmetatool::types::FileGraphEdge;
+using clangmetatool::types::FileUID;
+
+const std::string dataDir =
+    CMAKE_SOURCE_DIR "/t/data/057-project-include-graph/";
+
+ProjectIncludeGraph *project = nullptr;
+
+std::mutex headerCountMutex;
+size_t headerCount = 0;
+
+class MyTool {
+private:
+  clang::CompilerInstance *ci;
+  clangmetatool::collectors::IncludeGraph includeGraph;
+
+public:
+  MyTool(clang::CompilerInstance *ci, clang::ast_matchers::MatchFinder *f)
+      : ci(ci), includeGraph(ci, f) {}
+
+  void postProcessing(
+      std::map<std::string, clang::tooling::Replacements> &replacementsMap) {
+    clangmetatool::collectors::IncludeGraphData *data = includeGraph.getData();
+    project->add(data, ci->getSourceManager());
+
+    // Largest number of references from common.h to detail.h seen in a
+    // single translation unit
+    for (const auto &p : data->usage_reference_count) {
+      auto from = data->fuid2name.find(p.first.first);
+      if (from != data->fuid2name.end() &&
+          (from->second == "common.h" || from->second == "copy/common.h")) {
+        std::lock_guard<std::mutex> lock(headerCountMutex);
+        headerCount = std::max(headerCount, p.second);
+      }
+    }
+  }
+};
+
+std::string realPath(const std::string &name) {
+  llvm::SmallString<256> path;
+  EXPECT_FALSE(llvm::sys::fs::real_path(dataDir + name, path));
+  return path.str().str();
+}
+
+void run(ProjectIncludeGraph &graph) {
+  llvm::cl::OptionCategory MyToolCategory("my-tool options");
+
+  std::string a = dataDir + "a.cpp";
+  std::string b = dataDir + "b.cpp";
+  std::string c = dataDir + "c.cpp";
+  const char *argv[] = {"foo", a.c_str(), b.c_str(), c.c_str(), "--", "-xc++"};
+  int argc = sizeof(argv) / sizeof(argv[0]);
+
+  auto result = clang::tooling::CommonOptionsParser::create(
+      argc, argv, MyToolCategory, llvm::cl::OneOrMore);
+  ASSERT_TRUE(!!result);
+  clang::tooling::CommonOptionsParser &optionsParser = result.get();
+
+  std::map<std::string, clang::tooling::Replacements> replacements;
+  clangmetatool::MetaToolFactory<clangmetatool::MetaTool<MyTool>> raf(
+      replacements);
+  project = &graph;
+  ASSERT_EQ(0, raf.runParallel(optionsParser.getCompilations(),
+                               optionsParser.getSourcePathList(), 2));
+  project = nullptr;
+}
+
+std::map<std::string, FileUID>
+uidsByPath(const clangmetatool::collectors::IncludeGraphData &data) {
+  std::map<std::string, FileUID> uid;
+  for (const auto &file : data.fuid2name) {
+    uid[file.second] = file.first;
+  }
+  return uid;
+}
+
+} // anonymous namespace
+
+TEST(ProjectIncludeGraph, mergesByRealPath) {
+  ProjectIncludeGraph graph;
+  run(graph);
+
+  EXPECT_EQ(3u, graph.getNumTranslationUnits());
+  // The main files, common.h, detail.h, only_a.h, the placeholders and
+  // both copies
+  ASSERT_EQ(10u, graph.getNumFiles());
+
+  clangmetatool::collectors::IncludeGraphData data = graph.getData();
+  auto uid = uidsByPath(data);
+  ASSERT_EQ(10u, uid.size());
+
+  FileUID a = uid[realPath("a.cpp")];
+  FileUID b = uid[realPath("b.cpp")];
+  FileUID c = uid[realPath("c.cpp")];
+  FileUID common = uid[realPath("common.h")];
+  FileUID detail = uid[realPath("detail.h")];
+  FileUID onlyA = uid[realPath("only_a.h")];
+  FileUID placeholderA = uid[realPath("placeholder_a.h")];
+  FileUID placeholderB = uid[realPath("placeholder_b.h")];
+  FileUID copyCommon = uid[realPath("copy/common.h")];
+  FileUID copyDetail = uid[realPath("copy/detail.h")];
+
+  std::set<FileGraphEdge> expected = {
+      {a, common},      {a, onlyA},        {a, placeholderA},
+      {b, common},      {b, placeholderB}, {c, copyCommon},
+      {common, detail}, {copyCommon, copyDetail},
+  };
+  EXPECT_EQ(expected, data.include_graph);
+
+  // Every translation unit parses common.h, its references are counted
+  // once
+  ASSERT_EQ(1u, data.usage_reference_count.count({common, detail}));
+  EXPECT_EQ(headerCount, data.usage_reference_count[{common, detail}]);
+
+  std::set<FileUID> live = {common, onlyA};
+  EXPECT_EQ(live, IncludeGraphDependencies::liveDependencies(&data, a));
+  live = {detail};
+  EXPECT_EQ(live, IncludeGraphDependencies::liveDependencies(&data, common));
+  live = {copyCommon};
+  EXPECT_EQ(live, IncludeGraphDependencies::liveDependencies(&data, c));
+}
+
+TEST(ProjectIncludeGraph, mergesCopiesByContentHash) {
+  ProjectIncludeGraph graph(ProjectIncludeGraph::FileIdentity::ContentHash);
+  run(graph);
+
+  // The copies are the same files as the originals, but the empty
+  // placeholders, which have different names, are different files
+  ASSERT_EQ(8u, graph.getNumFiles());
+
+  clangmetatool::collectors::IncludeGraphData data = graph.getData();
+  auto uid = uidsByPath(data);
+  ASSERT_EQ(8u, uid.size());
+  EXPECT_EQ(0u, uid.count(realPath("copy/common.h")));
+
+  FileUID a = uid[realPath("a.cpp")];
+  FileUID b = uid[realPath("b.cpp")];
+  FileUID c = uid[realPath("c.cpp")];
+  FileUID common = uid[realPath("common.h")];
+  FileUID detail = uid[realPath("detail.h")];
+  FileUID onlyA = uid[realPath("only_a.h")];
+  FileUID placeholderA = uid[realPath("placeholder_a.h")];
+  FileUID placeholderB = uid[realPath("placeholder_b.h")];
+  EXPECT_NE(placeholderA, placeholderB);
+
+  std::set<FileGraphEdge> expected = {
+      {a, common},       {a, onlyA}, {a, placeholderA}, {b, common},
+      {b, placeholderB}, {c, common}, {common, detail},
+  };
+  EXPECT_EQ(expected, data.include_graph);
+
+  std::set<FileUID> live = {common};
+  EXPECT_EQ(live, IncludeGraphDependencies::liveDependencies(&data, c));
+}
+
+// ----------------------------------------------------------------------------
+// Copyright 2026 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,198 @@
+#include "clangmetatool-testconfig.h"
+
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include <clangmetatool/collectors/include_graph.h>
+#include <clangmetatool/collectors/include_graph_data.h>
+#include <clangmetatool/include_graph_csr.h>
+#include <clangmetatool/include_graph_dependencies.h>
+#include <clangmetatool/include_graph_snapshot.h>
+#include <clangmetatool/meta_tool.h>
+#include <clangmetatool/meta_tool_factory.h>
+
+#include <clang/Frontend/FrontendAction.h>
+#include <clang/Tooling/CommonOptionsParser.h>
+#include <clang/Tooling/Core/Replacement.h>
+#include <clang/Tooling/Refactoring.h>
+#include <clang/Tooling/Tooling.h>
+#include <llvm/Support/CommandLine.h>
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/MemoryBuffer.h>
+#include <llvm/Support/Path.h>
+#include <llvm/Support/raw_ostream.h>
+
+namespace {
+
+using clangmetatool::IncludeGraphCSR;
+using clangmetatool::IncludeGraphDependencies;
+using clangmetatool::IncludeGraphSnapshot;
+using clangmetatool::types::FileGraphEdge;
+using clangmetatool::types::FileUID;
+
+const std::string snapshotPath =
+    CMAKE_BINARY_DIR "/t/058-include-graph-snapshot.bin";
+
+class SnapshotTool {
+private:
+  clang::CompilerInstance *ci;
+  clangmetatool::collectors::IncludeGraph includeGraph;
+
+public:
+  SnapshotTool(clang::CompilerInstance *ci,
+               clang::ast_matchers::MatchFinder *f)
+      : ci(ci), includeGraph(ci, f) {}
+
+  void postProcessing(
+      std::map<std::string, clang::tooling::Replacements> &replacementsMap) {
+    clangmetatool::collectors::IncludeGraphData *data = includeGraph.getData();
+    clang::SourceManager &sm = ci->getSourceManager();
+    {
+      std::error_code ec;
+      llvm::raw_fd_ostream os(snapshotPath, ec, llvm::sys::fs::OF_None);
+      ASSERT_FALSE(ec);
+      IncludeGraphSnapshot::write(data, &sm, os);
+    }
+
+    std::unique_ptr<IncludeGraphSnapshot> snapshot =
+        IncludeGraphSnapshot::load(snapshotPath);
+    ASSERT_NE(nullptr, snapshot);
+    const IncludeGraphCSR &graph = snapshot->getGraph();
+
+    std::map<std::string, IncludeGraphCSR::Index> index;
+    for (IncludeGraphCSR::Index i = 0; i < snapshot->numNodes(); ++i) {
+      index[snapshot->getName(i).str()] = i;
+    }
+    ASSERT_EQ(4u, index.size());
+    IncludeGraphCSR::Index foo = index[""];
+    IncludeGraphCSR::Index all = index["all.h"];
+    IncludeGraphCSR::Index limits = index["limits.h"];
+    IncludeGraphCSR::Index point = index["point.h"];
+    EXPECT_EQ(sm.getFileEntryForID(sm.getMainFileID())->getUID(),
+              graph.getUID(foo));
+    EXPECT_EQ("point.h", llvm::sys::path::filename(snapshot->getPath(point)));
+    EXPECT_FALSE(snapshot->isSystem(point));
+
+    // The queries give the same answers on the snapshot as on the data
+    for (IncludeGraphCSR::Index i = 0; i < graph.numNodes(); ++i) {
+      FileUID uid = graph.getUID(i);
+      EXPECT_EQ(IncludeGraphDependencies::liveDependencies(data, uid),
+                IncludeGraphDependencies::liveDependencies(&graph, uid));
+      EXPECT_EQ(IncludeGraphDependencies::collectAllIncludes(data, uid),
+                IncludeGraphDependencies::collectAllIncludes(&graph, uid));
+      EXPECT_EQ(IncludeGraphDependencies::liveWeakDependencies(data, uid),
+                IncludeGraphDependencies::liveWeakDependencies(&graph, uid));
+
+      llvm::ArrayRef<IncludeGraphCSR::Index> used =
+          graph.getUsageGraph().successors(i);
+      llvm::ArrayRef<IncludeGraphSnapshot::UsageCounts> counts =
+          snapshot->getUsageCounts(i);
+      ASSERT_EQ(used.size(), counts.size());
+      for (size_t k = 0; k < used.size(); ++k) {
+        FileGraphEdge edge(uid, graph.getUID(used[k]));
+        EXPECT_EQ(data->usage_reference_count[edge], counts[k].total);
+        EXPECT_EQ(data->macro_references.count(edge), counts[k].macros);
+        EXPECT_EQ(data->decl_references.count(edge), counts[k].declarations);
+        EXPECT_EQ(data->type_references.count(edge), counts[k].types);
+        EXPECT_EQ(data->redeclarations.count(edge),
+                  counts[k].redeclarations);
+      }
+    }
+
+    // limits.h is also reached through all.h, which comes first
+    std::set<FileUID> expected = {graph.getUID(all)};
+    EXPECT_EQ(expected, IncludeGraphDependencies::liveDependencies(
+                            &graph, graph.getUID(foo)));
+
+    // LIMIT is the only name foo.cpp uses from limits.h
+    llvm::ArrayRef<IncludeGraphCSR::Index> used =
+        graph.getUsageGraph().successors(foo);
+    auto it = std::find(used.begin(), used.end(), limits);
+    ASSERT_NE(used.end(), it);
+    const IncludeGraphSnapshot::UsageCounts &limitsCounts =
+        snapshot->getUsageCounts(foo)[it - used.begin()];
+    EXPECT_EQ(1u, limitsCounts.total);
+    EXPECT_EQ(1u, limitsCounts.macros);
+
+    llvm::ArrayRef<IncludeGraphSnapshot::IncludeStatement> statements =
+        snapshot->getIncludeStatements(foo, all);
+    ASSERT_EQ(1u, statements.size());
+    EXPECT_EQ(0u, statements[0].begin);
+    statements = snapshot->getIncludeStatements(foo, limits);
+    ASSERT_EQ(1u, statements.size());
+    EXPECT_EQ(17u, statements[0].begin);
+    EXPECT_TRUE(snapshot->getIncludeStatements(foo, point).empty());
+
+    // A truncated snapshot is rejected
+    auto buffer = llvm::MemoryBuffer::getFile(snapshotPath);
+    ASSERT_TRUE(!!buffer);
+    llvm::StringRef contents = (*buffer)->getBuffer();
+    EXPECT_EQ(nullptr,
+              IncludeGraphSnapshot::load(llvm::MemoryBuffer::getMemBufferCopy(
+                  contents.drop_back(4))));
+
+    // So is one whose includes of foo.cpp are out of order, which would
+    // make the lookup of include statements miss them
+    std::unique_ptr<llvm::MemoryBuffer> copy =
+        llvm::MemoryBuffer::getMemBufferCopy(contents);
+    const char *start = copy->getBufferStart();
+    std::unique_ptr<IncludeGraphSnapshot> reloaded =
+        IncludeGraphSnapshot::load(std::move(copy));
+    ASSERT_NE(nullptr, reloaded);
+    llvm::ArrayRef<IncludeGraphCSR::Index> row =
+        reloaded->getGraph().getIncludeGraph().successors(foo);
+    ASSERT_EQ(2u, row.size());
+    size_t at = reinterpret_cast<const char *>(row.data()) - start;
+    ASSERT_LE(at + 2 * sizeof(row[0]), contents.size());
+    std::string swapped = contents.str();
+    std::swap_ranges(&swapped[at], &swapped[at + sizeof(row[0])],
+                     &swapped[at + sizeof(row[0])]);
+    EXPECT_EQ(nullptr, IncludeGraphSnapshot::load(
+                           llvm::MemoryBuffer::getMemBufferCopy(swapped)));
+  }
+};
+
+} // anonymous namespace
+
+TEST(IncludeGraphSnapshot, roundTrip) {
+  llvm::cl::OptionCategory MyToolCategory("my-tool options");
+
+  const char *argv[] = {
+      "foo", CMAKE_SOURCE_DIR "/t/data/058-include-graph-snapshot/foo.cpp",
+      "--", "-xc++"};
+  int argc = sizeof(argv) / sizeof(argv[0]);
+
+  auto result = clang::tooling::CommonOptionsParser::create(
+      argc, argv, MyToolCategory, llvm::cl::OneOrMore);
+  ASSERT_TRUE(!!result);
+  clang::tooling::CommonOptionsParser &optionsParser = result.get();
+
+  clang::tooling::RefactoringTool tool(optionsParser.getCompilations(),
+                                       optionsParser.getSourcePathList());
+
+  clangmetatool::MetaToolFactory<clangmetatool::MetaTool<SnapshotTool>> raf(
+      tool.getReplacements());
+
+  ASSERT_EQ(0, tool.run(&raf));
+}
+
+// ----------------------------------------------------------------------------
+// Copyright 2026 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,112 @@
+#include "clangmetatool-testconfig.h"
+
+#include <map>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include <clangmetatool/collectors/include_graph.h>
+#include <clangmetatool/collectors/include_graph_data.h>
+#include <clangmetatool/meta_tool.h>
+#include <clangmetatool/meta_tool_factory.h>
+
+#include <clang/Frontend/FrontendAction.h>
+#include <clang/Tooling/CommonOptionsParser.h>
+#include <clang/Tooling/Core/Replacement.h>
+#include <clang/Tooling/Refactoring.h>
+#include <clang/Tooling/Tooling.h>
+#include <llvm/Support/CommandLine.h>
+
+namespace {
+
+using clangmetatool::collectors::IncludeGraph;
+using clangmetatool::collectors::IncludeGraphData;
+
+class CountingOnlyTool {
+private:
+  IncludeGraph full;
+  IncludeGraph counting;
+  IncludeGraph macros;
+
+public:
+  CountingOnlyTool(clang::CompilerInstance *ci,
+                   clang::ast_matchers::MatchFinder *f)
+      : full(ci, f), counting(ci, f, IncludeGraphData::NoDetails),
+        macros(ci, f, IncludeGraphData::MacroReferenceDetails) {}
+
+  void postProcessing(
+      std::map<std::string, clang::tooling::Replacements> &replacementsMap) {
+    IncludeGraphData *fullData = full.getData();
+    IncludeGraphData *countingData = counting.getData();
+    IncludeGraphData *macrosData = macros.getData();
+
+    // foo.cpp uses a macro, a type and a function, and redeclares reset
+    EXPECT_EQ(IncludeGraphData::AllDetails, fullData->details);
+    EXPECT_FALSE(fullData->macro_references.empty());
+    EXPECT_FALSE(fullData->redeclarations.empty());
+    EXPECT_FALSE(fullData->decl_references.empty());
+    EXPECT_FALSE(fullData->type_references.empty());
+
+    // The graphs and the counts are the same without the details
+    for (IncludeGraphData *data : {countingData, macrosData}) {
+      EXPECT_EQ(fullData->include_graph, data->include_graph);
+      EXPECT_EQ(fullData->include_statements.size(),
+                data->include_statements.size());
+      EXPECT_EQ(fullData->use_graph, data->use_graph);
+      EXPECT_EQ(fullData->usage_reference_count,
+                data->usage_reference_count);
+      EXPECT_EQ(fullData->fuid2name, data->fuid2name);
+    }
+
+    EXPECT_TRUE(countingData->macro_references.empty());
+    EXPECT_TRUE(countingData->redeclarations.empty());
+    EXPECT_TRUE(countingData->decl_references.empty());
+    EXPECT_TRUE(countingData->type_references.empty());
+
+    EXPECT_EQ(fullData->macro_references.size(),
+              macrosData->macro_references.size());
+    EXPECT_TRUE(macrosData->redeclarations.empty());
+    EXPECT_TRUE(macrosData->decl_references.empty());
+    EXPECT_TRUE(macrosData->type_references.empty());
+  }
+};
+
+} // anonymous namespace
+
+TEST(IncludeGraph, countingOnly) {
+  llvm::cl::OptionCategory MyToolCategory("my-tool options");
+
+  const char *argv[] = {
+      "foo", CMAKE_SOURCE_DIR "/t/data/059-includegraph-counting-only/foo.cpp",
+      "--", "-xc++"};
+  int argc = sizeof(argv) / sizeof(argv[0]);
+
+  auto result = clang::tooling::CommonOptionsParser::create(
+      argc, argv, MyToolCategory, llvm::cl::OneOrMore);
+  ASSERT_TRUE(!!result);
+  clang::tooling::CommonOptionsParser &optionsParser = result.get();
+
+  clang::tooling::RefactoringTool tool(optionsParser.getCompilations(),
+                                       optionsParser.getSourcePathList());
+
+  clangmetatool::MetaToolFactory<clangmetatool::MetaTool<CountingOnlyTool>>
+      raf(tool.getReplacements());
+
+  ASSERT_EQ(0, tool.run(&raf));
+}
+
+// ----------------------------------------------------------------------------
+// Copyright 2026 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,124 @@
+#include "clangmetatool-testconfig.h"
+
+#include <algorithm>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <clangmetatool/collectors/include_graph.h>
+#include <clangmetatool/collectors/include_graph_data.h>
+#include <clangmetatool/meta_tool.h>
+#include <clangmetatool/meta_tool_factory.h>
+
+#include <clang/Frontend/FrontendAction.h>
+#include <clang/Tooling/CommonOptionsParser.h>
+#include <clang/Tooling/Core/Replacement.h>
+#include <clang/Tooling/Refactoring.h>
+#include <clang/Tooling/Tooling.h>
+#include <llvm/ADT/SmallString.h>
+#include <llvm/Support/CommandLine.h>
+#include <llvm/Support/FileSystem.h>
+
+namespace {
+
+using clangmetatool::collectors::IncludeGraphData;
+using clangmetatool::types::FileUID;
+
+const std::string dataDir =
+    CMAKE_SOURCE_DIR "/t/data/060-includegraph-indices/";
+
+class IndicesTool {
+private:
+  clang::CompilerInstance *ci;
+  clangmetatool::collectors::IncludeGraph includeGraph;
+
+public:
+  IndicesTool(clang::CompilerInstance *ci, clang::ast_matchers::MatchFinder *f)
+      : ci(ci), includeGraph(ci, f) {}
+
+  void postProcessing(
+      std::map<std::string, clang::tooling::Replacements> &replacementsMap) {
+    IncludeGraphData *data = includeGraph.getData();
+    clang::SourceManager &sm = ci->getSourceManager();
+    FileUID foo = sm.getFileEntryForID(sm.getMainFileID())->getUID();
+
+    ASSERT_EQ(1u, data->name2fuid.count("a.h"));
+    ASSERT_EQ(1u, data->name2fuid.count("b.h"));
+    FileUID a = data->name2fuid.find("a.h")->second;
+    FileUID b = data->name2fuid.find("b.h")->second;
+    EXPECT_EQ("a.h", data->fuid2name[a]);
+    EXPECT_EQ(0u, data->name2fuid.count("foo.cpp"));
+
+    llvm::SmallString<256> path;
+    ASSERT_FALSE(llvm::sys::fs::real_path(dataDir + "a.h", path));
+    ASSERT_EQ(1u, data->path2fuid.count(path.str().str()));
+    EXPECT_EQ(a, data->path2fuid[path.str().str()]);
+    ASSERT_FALSE(llvm::sys::fs::real_path(dataDir + "foo.cpp", path));
+    ASSERT_EQ(1u, data->path2fuid.count(path.str().str()));
+    EXPECT_EQ(foo, data->path2fuid[path.str().str()]);
+
+    // foo.cpp includes b.h twice, it is listed once
+    std::vector<FileUID> includers = data->included_by[b];
+    std::sort(includers.begin(), includers.end());
+    std::vector<FileUID> expected = {std::min(foo, a), std::max(foo, a)};
+    EXPECT_EQ(expected, includers);
+    expected = {foo};
+    EXPECT_EQ(expected, data->included_by[a]);
+    EXPECT_EQ(0u, data->included_by.count(foo));
+
+    // The indices agree with the data they index
+    size_t edges = 0;
+    for (const auto &p : data->included_by) {
+      for (FileUID includer : p.second) {
+        EXPECT_EQ(1u, data->include_graph.count({includer, p.first}));
+        ++edges;
+      }
+    }
+    EXPECT_EQ(data->include_graph.size(), edges);
+    for (const auto &p : data->name2fuid) {
+      EXPECT_EQ(p.first, data->fuid2name[p.second]);
+    }
+  }
+};
+
+} // anonymous namespace
+
+TEST(IncludeGraph, indices) {
+  llvm::cl::OptionCategory MyToolCategory("my-tool options");
+
+  std::string foo = dataDir + "foo.cpp";
+  const char *argv[] = {"foo", foo.c_str(), "--", "-xc++"};
+  int argc = sizeof(argv) / sizeof(argv[0]);
+
+  auto result = clang::tooling::CommonOptionsParser::create(
+      argc, argv, MyToolCategory, llvm::cl::OneOrMore);
+  ASSERT_TRUE(!!result);
+  clang::tooling::CommonOptionsParser &optionsParser = result.get();
+
+  clang::tooling::RefactoringTool tool(optionsParser.getCompilations(),
+                                       optionsParser.getSourcePathList());
+
+  clangmetatool::MetaToolFactory<clangmetatool::MetaTool<IndicesTool>> raf(
+      tool.getReplacements());
+
+  ASSERT_EQ(0, tool.run(&raf));
+}
+
+// ----------------------------------------------------------------------------
+// Copyright 2026 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,157 @@
+#include "clangmetatool-testconfig.h"
+
+#include <map>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <clangmetatool/collectors/include_graph.h>
+#include <clangmetatool/collectors/include_graph_data.h>
+#include <clangmetatool/meta_tool.h>
+#include <clangmetatool/meta_tool_factory.h>
+#include <clangmetatool/phase_timings.h>
+#include <clangmetatool/preprocessor_meta_tool.h>
+
+#include <clang/Frontend/FrontendAction.h>
+#include <clang/Tooling/CommonOptionsParser.h>
+#include <clang/Tooling/Core/Replacement.h>
+#include <clang/Tooling/Refactoring.h>
+#include <clang/Tooling/Tooling.h>
+#include <llvm/Support/CommandLine.h>
+
+namespace {
+
+using clangmetatool::collectors::IncludeGraphData;
+using clangmetatool::types::FileGraphEdge;
+
+typedef std::pair<std::string, std::string> NamedEdge;
+
+/**
+ * What the tool saw of a translation unit, by file name, the main file
+ * being "".
+ */
+struct Summary {
+  std::set<NamedEdge> includes;
+  size_t includeStatements = 0;
+  std::map<NamedEdge, size_t> macroReferences;
+  size_t declReferences = 0;
+  size_t typeReferences = 0;
+};
+
+Summary summary;
+
+class MyTool {
+private:
+  clangmetatool::collectors::IncludeGraph includeGraph;
+
+  NamedEdge named(const IncludeGraphData *data, const FileGraphEdge &edge) {
+    auto name = [data](clangmetatool::types::FileUID uid) {
+      auto it = data->fuid2name.find(uid);
+      return it == data->fuid2name.end() ? std::string() : it->second;
+    };
+    return NamedEdge(name(edge.first), name(edge.second));
+  }
+
+public:
+  MyTool(clang::CompilerInstance *ci, clang::ast_matchers::MatchFinder *f)
+      : includeGraph(ci, f) {}
+
+  void postProcessing(
+      std::map<std::string, clang::tooling::Replacements> &replacementsMap) {
+    IncludeGraphData *data = includeGraph.getData();
+    summary = Summary();
+    for (const auto &edge : data->include_graph) {
+      summary.includes.insert(named(data, edge));
+    }
+    summary.includeStatements = data->include_statements.size();
+    for (const auto &p : data->macro_references) {
+      ++summary.macroReferences[named(data, p.first)];
+    }
+    summary.declReferences = data->decl_references.size();
+    summary.typeReferences = data->type_references.size();
+  }
+};
+
+template <class Action>
+Summary run(clangmetatool::PhaseTimingsLog *timingsLog = nullptr) {
+  llvm::cl::OptionCategory MyToolCategory("my-tool options");
+
+  const char *argv[] = {
+      "foo", CMAKE_SOURCE_DIR "/t/data/061-preprocessor-meta-tool/foo.cpp",
+      "--", "-xc++"};
+  int argc = sizeof(argv) / sizeof(argv[0]);
+
+  auto result = clang::tooling::CommonOptionsParser::create(
+      argc, argv, MyToolCategory, llvm::cl::OneOrMore);
+  EXPECT_TRUE(!!result);
+  clang::tooling::CommonOptionsParser &optionsParser = result.get();
+
+  clang::tooling::RefactoringTool tool(optionsParser.getCompilations(),
+                                       optionsParser.getSourcePathList());
+
+  clangmetatool::MetaToolFactory<Action> raf(tool.getReplacements());
+  raf.setTimingsLog(timingsLog);
+
+  EXPECT_EQ(0, tool.run(&raf));
+  return summary;
+}
+
+} // anonymous namespace
+
+TEST(PreprocessorMetaTool, collectsIncludesAndMacros) {
+  Summary full = run<clangmetatool::MetaTool<MyTool>>();
+  Summary preprocessed = run<clangmetatool::PreprocessorMetaTool<MyTool>>();
+
+  std::set<NamedEdge> includes = {
+      {"", "config.h"}, {"", "item.h"}, {"item.h", "config.h"}};
+  EXPECT_EQ(includes, preprocessed.includes);
+  EXPECT_EQ(3u, preprocessed.includeStatements);
+
+  // VERSION in the #if and TWICE in the code
+  std::map<NamedEdge, size_t> macroReferences = {{{"", "config.h"}, 2}};
+  EXPECT_EQ(macroReferences, preprocessed.macroReferences);
+
+  // Only the matchers see the declarations and types
+  EXPECT_EQ(0u, preprocessed.declReferences);
+  EXPECT_EQ(0u, preprocessed.typeReferences);
+  EXPECT_LT(0u, full.typeReferences);
+
+  EXPECT_EQ(full.includes, preprocessed.includes);
+  EXPECT_EQ(full.includeStatements, preprocessed.includeStatements);
+  EXPECT_EQ(full.macroReferences, preprocessed.macroReferences);
+}
+
+TEST(PreprocessorMetaTool, recordsPhaseTimings) {
+  clangmetatool::PhaseTimingsLog log;
+  run<clangmetatool::PreprocessorMetaTool<MyTool>>(&log);
+
+  std::vector<clangmetatool::PhaseTimings> timings = log.getTimings();
+  ASSERT_EQ(1u, timings.size());
+  const clangmetatool::PhaseTimings &t = timings[0];
+  EXPECT_NE(std::string::npos, t.mainFile.find("foo.cpp"));
+  EXPECT_LT(0.0, t.frontendSeconds);
+  // No matchers run
+  EXPECT_EQ(0.0, t.matchSeconds);
+  EXPECT_LE(t.setupSeconds + t.frontendSeconds + t.postProcessingSeconds,
+            t.totalSeconds);
+  EXPECT_LT(0u, t.processPeakMemoryKB);
+}
+
+// ----------------------------------------------------------------------------
+// Copyright 2026 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,141 @@
+#include "clangmetatool-testconfig.h"
+
+#include <map>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include <clangmetatool/collectors/include_graph.h>
+#include <clangmetatool/collectors/include_graph_data.h>
+#include <clangmetatool/header_cost_report.h>
+#include <clangmetatool/meta_tool.h>
+#include <clangmetatool/meta_tool_factory.h>
+#include <clangmetatool/project_include_graph.h>
+
+#include <clang/Frontend/FrontendAction.h>
+#include <clang/Tooling/CommonOptionsParser.h>
+#include <clang/Tooling/Core/Replacement.h>
+#include <clang/Tooling/Tooling.h>
+#include <llvm/ADT/SmallString.h>
+#include <llvm/Support/CommandLine.h>
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/raw_ostream.h>
+
+namespace {
+
+using clangmetatool::HeaderCostReport;
+using clangmetatool::types::FileGraphEdge;
+using clangmetatool::types::FileUID;
+
+const std::string dataDir =
+    CMAKE_SOURCE_DIR "/t/data/062-header-cost-report/";
+
+clangmetatool::ProjectIncludeGraph project;
+
+class MyTool {
+private:
+  clang::CompilerInstance *ci;
+  clangmetatool::collectors::IncludeGraph includeGraph;
+
+public:
+  MyTool(clang::CompilerInstance *ci, clang::ast_matchers::MatchFinder *f)
+      : ci(ci), includeGraph(ci, f) {}
+
+  void postProcessing(
+      std::map<std::string, clang::tooling::Replacements> &replacementsMap) {
+    project.add(includeGraph.getData(), ci->getSourceManager());
+  }
+};
+
+std::string realPath(const std::string &name) {
+  llvm::SmallString<256> path;
+  EXPECT_FALSE(llvm::sys::fs::real_path(dataDir + name, path));
+  return path.str().str();
+}
+
+} // anonymous namespace
+
+TEST(HeaderCostReport, ranksHeadersAndIncludes) {
+  llvm::cl::OptionCategory MyToolCategory("my-tool options");
+
+  std::string a = dataDir + "a.cpp";
+  std::string b = dataDir + "b.cpp";
+  const char *argv[] = {"foo", a.c_str(), b.c_str(), "--", "-xc++"};
+  int argc = sizeof(argv) / sizeof(argv[0]);
+
+  auto result = clang::tooling::CommonOptionsParser::create(
+      argc, argv, MyToolCategory, llvm::cl::OneOrMore);
+  ASSERT_TRUE(!!result);
+  clang::tooling::CommonOptionsParser &optionsParser = result.get();
+
+  std::map<std::string, clang::tooling::Replacements> replacements;
+  clangmetatool::MetaToolFactory<clangmetatool::MetaTool<MyTool>> raf(
+      replacements);
+  ASSERT_EQ(0, raf.runParallel(optionsParser.getCompilations(),
+                               optionsParser.getSourcePathList(), 2));
+
+  clangmetatool::collectors::IncludeGraphData data = project.getData();
+  HeaderCostReport report(&data);
+  EXPECT_EQ(2u, report.getNumTranslationUnits());
+
+  std::map<std::string, FileUID> uid;
+  for (const auto &p : data.fuid2name) {
+    uid[p.second] = p.first;
+  }
+  std::map<std::string, HeaderCostReport::Size> size;
+  for (const char *name : {"a.cpp", "b.cpp", "big.h", "small.h", "detail.h"}) {
+    size[name] = HeaderCostReport::measure(realPath(name));
+  }
+  EXPECT_EQ(11u, size["small.h"].tokens);
+
+  // Both translation units include big.h, which includes detail.h
+  const std::vector<HeaderCostReport::HeaderCost> &headers =
+      report.getHeaders();
+  ASSERT_EQ(3u, headers.size());
+  EXPECT_EQ(realPath("big.h"), headers[0].path);
+  EXPECT_EQ(size["big.h"].bytes, headers[0].own.bytes);
+  EXPECT_EQ(size["big.h"].bytes + size["detail.h"].bytes,
+            headers[0].closure.bytes);
+  EXPECT_EQ(2u, headers[0].translationUnits);
+  EXPECT_EQ(2 * headers[0].closure.bytes, headers[0].build.bytes);
+  EXPECT_EQ(2 * headers[0].closure.tokens, headers[0].build.tokens);
+
+  std::map<FileGraphEdge, HeaderCostReport::IncludeCost> includes;
+  for (const auto &include : report.getIncludes()) {
+    includes[include.edge] = include;
+  }
+  ASSERT_EQ(5u, includes.size());
+  FileUID aUID = uid[realPath("a.cpp")];
+  FileUID bUID = uid[realPath("b.cpp")];
+  FileUID big = uid[realPath("big.h")];
+  FileUID detail = uid[realPath("detail.h")];
+
+  // a.cpp still gets detail.h through small.h without big.h
+  EXPECT_EQ(size["big.h"].bytes, includes[{aUID, big}].removed.bytes);
+  EXPECT_EQ(size["big.h"].bytes + size["detail.h"].bytes,
+            includes[{bUID, big}].removed.bytes);
+  EXPECT_EQ(size["detail.h"].bytes, includes[{big, detail}].removed.bytes);
+  EXPECT_EQ(1u, includes[{big, detail}].translationUnits);
+  EXPECT_EQ(includes[{bUID, big}].edge, report.getIncludes()[0].edge);
+
+  std::string text;
+  llvm::raw_string_ostream os(text);
+  report.printReport(os);
+  EXPECT_NE(std::string::npos, os.str().find(realPath("big.h")));
+}
+
+// ----------------------------------------------------------------------------
+// Copyright 2026 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,160 @@
+#include "clangmetatool-testconfig.h"
+
+#include <map>
+#include <set>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include <clangmetatool/collectors/include_graph.h>
+#include <clangmetatool/collectors/include_graph_data.h>
+#include <clangmetatool/include_pruner.h>
+#include <clangmetatool/meta_tool.h>
+#include <clangmetatool/meta_tool_factory.h>
+
+#include <clang/Frontend/FrontendAction.h>
+#include <clang/Tooling/CommonOptionsParser.h>
+#include <clang/Tooling/Core/Replacement.h>
+#include <clang/Tooling/Tooling.h>
+#include <llvm/ADT/SmallString.h>
+#include <llvm/Support/CommandLine.h>
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/MemoryBuffer.h>
+#include <llvm/Support/Path.h>
+
+namespace {
+
+using clangmetatool::collectors::IncludeGraphData;
+
+const std::string dataDir = CMAKE_SOURCE_DIR "/t/data/063-include-pruner/";
+
+clangmetatool::IncludePruner pruner;
+
+// Names of the includes removable in each translation unit
+std::map<std::string, std::set<std::pair<std::string, std::string>>>
+    removable;
+
+class MyTool {
+private:
+  clang::CompilerInstance *ci;
+  clangmetatool::collectors::IncludeGraph includeGraph;
+
+public:
+  MyTool(clang::CompilerInstance *ci, clang::ast_matchers::MatchFinder *f)
+      : ci(ci), includeGraph(ci, f, IncludeGraphData::NoDetails) {}
+
+  void postProcessing(
+      std::map<std::string, clang::tooling::Replacements> &replacementsMap) {
+    const IncludeGraphData *data = includeGraph.getData();
+    pruner.add(data, ci->getSourceManager());
+
+    const clang::SourceManager &sm = ci->getSourceManager();
+    std::string main = llvm::sys::path::filename(
+                           sm.getFilename(sm.getLocForStartOfFile(
+                               sm.getMainFileID())))
+                           .str();
+    auto nameOf = [&](clangmetatool::types::FileUID uid) {
+      auto name = data->fuid2name.find(uid);
+      return name == data->fuid2name.end() ? main : name->second;
+    };
+    for (const auto &edge :
+         clangmetatool::IncludePruner::removableIncludes(data)) {
+      removable[main].emplace(nameOf(edge.first), nameOf(edge.second));
+    }
+  }
+};
+
+std::string realPath(const std::string &name) {
+  llvm::SmallString<256> path;
+  EXPECT_FALSE(llvm::sys::fs::real_path(dataDir + name, path));
+  return path.str().str();
+}
+
+} // anonymous namespace
+
+TEST(IncludePruner, agreesAcrossTranslationUnits) {
+  llvm::cl::OptionCategory MyToolCategory("my-tool options");
+
+  std::string a = dataDir + "a.cpp";
+  std::string b = dataDir + "b.cpp";
+  std::string c = dataDir + "c.cpp";
+  const char *argv[] = {"foo", a.c_str(), b.c_str(), c.c_str(), "--",
+                        "-xc++"};
+  int argc = sizeof(argv) / sizeof(argv[0]);
+
+  auto result = clang::tooling::CommonOptionsParser::create(
+      argc, argv, MyToolCategory, llvm::cl::OneOrMore);
+  ASSERT_TRUE(!!result);
+  clang::tooling::CommonOptionsParser &optionsParser = result.get();
+
+  std::map<std::string, clang::tooling::Replacements> replacements;
+  clangmetatool::MetaToolFactory<clangmetatool::MetaTool<MyTool>> raf(
+      replacements);
+  ASSERT_EQ(0, raf.runParallel(optionsParser.getCompilations(),
+                               optionsParser.getSourcePathList(), 2));
+  EXPECT_EQ(3u, pruner.getNumTranslationUnits());
+
+  // a.cpp needs extra.h through shared.h and b.cpp needs helper.h, so
+  // shared.h keeps both. Nothing uses kept.h, only its pragma keeps it.
+  std::set<std::pair<std::string, std::string>> expectedA = {
+      {"a.cpp", "kept.h"},
+      {"a.cpp", "unused.h"},
+      {"shared.h", "helper.h"},
+      {"shared.h", "unused.h"}};
+  std::set<std::pair<std::string, std::string>> expectedB = {
+      {"shared.h", "extra.h"}, {"shared.h", "unused.h"}};
+  EXPECT_EQ(expectedA, removable["a.cpp"]);
+  EXPECT_EQ(expectedB, removable["b.cpp"]);
+
+  // c.cpp doesn't use first.h, but second.h does without including it.
+  // The same goes for order_a.h within wrapper.h, which c.cpp doesn't
+  // need at all.
+  std::set<std::pair<std::string, std::string>> expectedC = {
+      {"c.cpp", "wrapper.h"}};
+  EXPECT_EQ(expectedC, removable["c.cpp"]);
+
+  std::map<std::string, clang::tooling::Replacements> pruned =
+      pruner.getReplacements();
+  ASSERT_EQ(3u, pruned.size());
+
+  std::map<std::string, std::string> expected = {
+      {"a.cpp", "#include \"used.h\"\n"
+                "#include \"kept.h\" // IWYU pragma: keep\n"
+                "#include \"shared.h\"\n"
+                "\n"
+                "int a() { return used() + extra(); }\n"},
+      {"c.cpp", "#include \"first.h\"\n"
+                "#include \"second.h\"\n"
+                "\n"
+                "int c() { return second(); }\n"},
+      {"shared.h", "#pragma once\n"
+                   "\n"
+                   "#include \"extra.h\"\n"
+                   "#include \"helper.h\"\n"}};
+  for (const auto &p : expected) {
+    std::string path = realPath(p.first);
+    ASSERT_EQ(1u, pruned.count(path));
+    auto buffer = llvm::MemoryBuffer::getFile(path);
+    ASSERT_TRUE(!!buffer);
+    auto code = clang::tooling::applyAllReplacements((*buffer)->getBuffer(),
+                                                     pruned[path]);
+    ASSERT_TRUE(!!code);
+    EXPECT_EQ(p.second, *code);
+  }
+}
+
+// ----------------------------------------------------------------------------
+// Copyright 2026 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
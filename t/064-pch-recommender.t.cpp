@@ -0,0 +1,154 @@
+#include "clangmetatool-testconfig.h"
+
+#include <chrono>
+#include <map>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include <clangmetatool/collectors/include_graph.h>
+#include <clangmetatool/collectors/include_graph_data.h>
+#include <clangmetatool/meta_tool.h>
+#include <clangmetatool/meta_tool_factory.h>
+#include <clangmetatool/pch_recommender.h>
+#include <clangmetatool/project_include_graph.h>
+
+#include <clang/Frontend/FrontendAction.h>
+#include <clang/Tooling/CommonOptionsParser.h>
+#include <clang/Tooling/Core/Replacement.h>
+#include <clang/Tooling/Tooling.h>
+#include <llvm/ADT/SmallString.h>
+#include <llvm/Support/CommandLine.h>
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/raw_ostream.h>
+
+namespace {
+
+using clangmetatool::PCHRecommender;
+using clangmetatool::types::FileUID;
+
+const std::string dataDir = CMAKE_SOURCE_DIR "/t/data/064-pch-recommender/";
+
+clangmetatool::ProjectIncludeGraph project;
+
+class MyTool {
+private:
+  clang::CompilerInstance *ci;
+  clangmetatool::collectors::IncludeGraph includeGraph;
+
+public:
+  MyTool(clang::CompilerInstance *ci, clang::ast_matchers::MatchFinder *f)
+      : ci(ci), includeGraph(ci, f) {}
+
+  void postProcessing(
+      std::map<std::string, clang::tooling::Replacements> &replacementsMap) {
+    project.add(includeGraph.getData(), ci->getSourceManager());
+  }
+};
+
+std::string realPath(const std::string &name) {
+  llvm::SmallString<256> path;
+  EXPECT_FALSE(llvm::sys::fs::real_path(dataDir + name, path));
+  return path.str().str();
+}
+
+} // anonymous namespace
+
+TEST(PCHRecommender, picksStableCommonHeaders) {
+  llvm::cl::OptionCategory MyToolCategory("my-tool options");
+
+  std::string a = dataDir + "a.cpp";
+  std::string b = dataDir + "b.cpp";
+  std::string c = dataDir + "c.cpp";
+  const char *argv[] = {"foo", a.c_str(), b.c_str(), c.c_str(), "--",
+                        "-xc++"};
+  int argc = sizeof(argv) / sizeof(argv[0]);
+
+  auto result = clang::tooling::CommonOptionsParser::create(
+      argc, argv, MyToolCategory, llvm::cl::OneOrMore);
+  ASSERT_TRUE(!!result);
+  clang::tooling::CommonOptionsParser &optionsParser = result.get();
+
+  std::map<std::string, clang::tooling::Replacements> replacements;
+  clangmetatool::MetaToolFactory<clangmetatool::MetaTool<MyTool>> raf(
+      replacements);
+  ASSERT_EQ(0, raf.runParallel(optionsParser.getCompilations(),
+                               optionsParser.getSourcePathList(), 2));
+
+  clangmetatool::collectors::IncludeGraphData data = project.getData();
+
+  // fresh.h was just changed, everything else is old
+  auto now = std::chrono::system_clock::now();
+  std::map<FileUID, PCHRecommender::FileStatus> files;
+  for (const char *name :
+       {"a.cpp", "b.cpp", "c.cpp", "common.h", "base.h", "fresh.h", "rare.h"}) {
+    PCHRecommender::FileStatus file;
+    file.bytes = 100;
+    file.modified = now - std::chrono::hours(24 * 100);
+    auto uid = data.path2fuid.find(realPath(name));
+    ASSERT_NE(data.path2fuid.end(), uid);
+    files[uid->second] = file;
+  }
+  files[data.path2fuid[realPath("fresh.h")]].modified =
+      now - std::chrono::hours(1);
+
+  PCHRecommender::Options options;
+  PCHRecommender recommender(&data, files, options, now);
+  EXPECT_EQ(3u, recommender.getNumTranslationUnits());
+
+  // rare.h is only in one translation unit of three
+  std::map<std::string, PCHRecommender::Candidate> candidates;
+  for (const auto &candidate : recommender.getCandidates()) {
+    candidates[candidate.path] = candidate;
+  }
+  ASSERT_EQ(2u, candidates.size());
+  EXPECT_EQ(200u, candidates[realPath("common.h")].closureBytes);
+  EXPECT_EQ(3u, candidates[realPath("common.h")].translationUnits);
+  EXPECT_TRUE(candidates[realPath("common.h")].selected);
+  EXPECT_EQ(100u, candidates[realPath("base.h")].closureBytes);
+  EXPECT_FALSE(candidates[realPath("base.h")].selected);
+  EXPECT_EQ(realPath("common.h"), recommender.getCandidates()[0].path);
+
+  ASSERT_EQ(1u, recommender.getSelection().size());
+  EXPECT_EQ(realPath("common.h"), recommender.getSelection()[0].path);
+  EXPECT_EQ(200u, recommender.getBytes());
+  EXPECT_EQ(3u, recommender.getSavedBytes().size());
+  EXPECT_DOUBLE_EQ(200.0, recommender.getAverageSavedBytes());
+
+  std::string header;
+  llvm::raw_string_ostream os(header);
+  recommender.writeHeader(os);
+  EXPECT_NE(std::string::npos,
+            os.str().find("#include \"" + realPath("common.h") + "\"\n"));
+  EXPECT_EQ(std::string::npos, os.str().find(realPath("fresh.h")));
+
+  // With a lower threshold fresh.h still isn't stable, rare.h gets in
+  options.minTranslationUnitFraction = 0.3;
+  PCHRecommender lower(&data, files, options, now);
+  EXPECT_EQ(2u, lower.getSelection().size());
+  EXPECT_EQ(300u, lower.getBytes());
+
+  // common.h doesn't fit, but what it includes does
+  options.maxBytes = 150;
+  PCHRecommender small(&data, files, options, now);
+  ASSERT_EQ(1u, small.getSelection().size());
+  EXPECT_EQ(realPath("base.h"), small.getSelection()[0].path);
+  EXPECT_EQ(100u, small.getBytes());
+  EXPECT_DOUBLE_EQ(100.0, small.getAverageSavedBytes());
+}
+
+// ----------------------------------------------------------------------------
+// Copyright 2026 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
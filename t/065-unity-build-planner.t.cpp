@@ -0,0 +1,125 @@
+#include "clangmetatool-testconfig.h"
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <clangmetatool/collectors/definitions.h>
+#include <clangmetatool/collectors/include_graph.h>
+#include <clangmetatool/meta_tool.h>
+#include <clangmetatool/meta_tool_factory.h>
+#include <clangmetatool/unity_build_planner.h>
+
+#include <clang/Frontend/FrontendAction.h>
+#include <clang/Tooling/CommonOptionsParser.h>
+#include <clang/Tooling/Core/Replacement.h>
+#include <clang/Tooling/Tooling.h>
+#include <llvm/ADT/SmallString.h>
+#include <llvm/Support/CommandLine.h>
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/raw_ostream.h>
+
+namespace {
+
+using clangmetatool::UnityBuildPlanner;
+
+const std::string dataDir =
+    CMAKE_SOURCE_DIR "/t/data/065-unity-build-planner/";
+
+UnityBuildPlanner planner;
+
+class MyTool {
+private:
+  clang::CompilerInstance *ci;
+  clangmetatool::collectors::IncludeGraph includeGraph;
+  clangmetatool::collectors::Definitions definitions;
+
+public:
+  MyTool(clang::CompilerInstance *ci, clang::ast_matchers::MatchFinder *f)
+      : ci(ci), includeGraph(ci, f), definitions(ci, f) {}
+
+  void postProcessing(
+      std::map<std::string, clang::tooling::Replacements> &replacementsMap) {
+    planner.add(includeGraph.getData(), definitions.getData(),
+                ci->getSourceManager());
+  }
+};
+
+std::string realPath(const std::string &name) {
+  llvm::SmallString<256> path;
+  EXPECT_FALSE(llvm::sys::fs::real_path(dataDir + name, path));
+  return path.str().str();
+}
+
+} // anonymous namespace
+
+TEST(UnityBuildPlanner, groupsSimilarTranslationUnits) {
+  llvm::cl::OptionCategory MyToolCategory("my-tool options");
+
+  std::vector<std::string> sources;
+  for (const char *name : {"a.cpp", "b.cpp", "c.cpp", "d.cpp", "e.cpp"}) {
+    sources.push_back(dataDir + name);
+  }
+  const char *argv[] = {"foo",
+                        sources[0].c_str(),
+                        sources[1].c_str(),
+                        sources[2].c_str(),
+                        sources[3].c_str(),
+                        sources[4].c_str(),
+                        "--",
+                        "-xc++"};
+  int argc = sizeof(argv) / sizeof(argv[0]);
+
+  auto result = clang::tooling::CommonOptionsParser::create(
+      argc, argv, MyToolCategory, llvm::cl::OneOrMore);
+  ASSERT_TRUE(!!result);
+  clang::tooling::CommonOptionsParser &optionsParser = result.get();
+
+  std::map<std::string, clang::tooling::Replacements> replacements;
+  clangmetatool::MetaToolFactory<clangmetatool::MetaTool<MyTool>> raf(
+      replacements);
+  ASSERT_EQ(0, raf.runParallel(optionsParser.getCompilations(),
+                               optionsParser.getSourcePathList(), 2));
+  EXPECT_EQ(5u, planner.getNumTranslationUnits());
+
+  // a.cpp, b.cpp, d.cpp and e.cpp include the same headers, but d.cpp
+  // defines a helper in an anonymous namespace, and a.cpp a static one,
+  // while e.cpp defines a counter function where b.cpp has an internal
+  // counter
+  std::vector<UnityBuildPlanner::Group> groups = planner.plan();
+  ASSERT_EQ(3u, groups.size());
+  std::vector<std::string> ab = {realPath("a.cpp"), realPath("b.cpp")};
+  EXPECT_EQ(ab, groups[0].translationUnits);
+  std::vector<std::string> de = {realPath("d.cpp"), realPath("e.cpp")};
+  EXPECT_EQ(de, groups[1].translationUnits);
+  EXPECT_EQ(std::vector<std::string>{realPath("c.cpp")},
+            groups[2].translationUnits);
+
+  std::string text;
+  llvm::raw_string_ostream os(text);
+  UnityBuildPlanner::writeUnitySource(groups[0], os);
+  EXPECT_EQ("#include \"" + ab[0] + "\"\n#include \"" + ab[1] + "\"\n",
+            os.str());
+
+  UnityBuildPlanner::Options options;
+  options.maxTranslationUnits = 1;
+  EXPECT_EQ(5u, planner.plan(options).size());
+}
+
+// ----------------------------------------------------------------------------
+// Copyright 2026 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
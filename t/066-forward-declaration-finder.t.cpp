@@ -0,0 +1,261 @@
+#include "clangmetatool-testconfig.h"
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <clangmetatool/collectors/include_graph.h>
+#include <clangmetatool/collectors/include_graph_data.h>
+#include <clangmetatool/forward_declaration_finder.h>
+#include <clangmetatool/header_cost_report.h>
+#include <clangmetatool/meta_tool.h>
+#include <clangmetatool/meta_tool_factory.h>
+#include <clangmetatool/project_include_graph.h>
+
+#include <clang/Frontend/FrontendAction.h>
+#include <clang/Tooling/CommonOptionsParser.h>
+#include <clang/Tooling/Core/Replacement.h>
+#include <clang/Tooling/Tooling.h>
+#include <llvm/ADT/SmallString.h>
+#include <llvm/Support/CommandLine.h>
+#include <llvm/Support/FileSystem.h>
+
+namespace {
+
+using clangmetatool::ForwardDeclarationFinder;
+using clangmetatool::HeaderCostReport;
+using clangmetatool::collectors::IncludeGraphData;
+using clangmetatool::types::FileGraphEdge;
+using clangmetatool::types::FileUID;
+
+const std::string dataDir =
+    CMAKE_SOURCE_DIR "/t/data/066-forward-declaration-finder/";
+
+clangmetatool::ProjectIncludeGraph project;
+
+std::string realPath(const std::string &name) {
+  llvm::SmallString<256> path;
+  EXPECT_FALSE(llvm::sys::fs::real_path(dataDir + name, path));
+  return path.str().str();
+}
+
+FileGraphEdge edgeOf(const IncludeGraphData *data, const std::string &from,
+                     const std::string &to) {
+  auto a = data->path2fuid.find(realPath(from));
+  auto b = data->path2fuid.find(realPath(to));
+  EXPECT_NE(data->path2fuid.end(), a);
+  EXPECT_NE(data->path2fuid.end(), b);
+  if (a == data->path2fuid.end() || b == data->path2fuid.end()) {
+    return FileGraphEdge(0, 0);
+  }
+  return FileGraphEdge(a->second, b->second);
+}
+
+class MyTool {
+private:
+  clang::CompilerInstance *ci;
+  clangmetatool::collectors::IncludeGraph includeGraph;
+
+public:
+  MyTool(clang::CompilerInstance *ci, clang::ast_matchers::MatchFinder *f)
+      : ci(ci),
+        includeGraph(ci, f,
+                     IncludeGraphData::AllDetails |
+                         IncludeGraphData::ForwardDeclarationDetails) {}
+
+  void postProcessing(
+      std::map<std::string, clang::tooling::Replacements> &replacementsMap) {
+    IncludeGraphData *data = includeGraph.getData();
+
+    // widget.h only names Gadget behind a pointer, or in function
+    // declarations, but it holds a Util
+    FileGraphEdge gadget = edgeOf(data, "widget.h", "gadget.h");
+    EXPECT_EQ(1u, data->use_graph.count(gadget));
+    EXPECT_EQ(0u, data->definition_uses.count(gadget));
+    EXPECT_LT(0u, data->forward_declarable_type_references.count(gadget));
+    EXPECT_EQ(data->type_references.count(gadget),
+              data->forward_declarable_type_references.count(gadget));
+
+    FileGraphEdge util = edgeOf(data, "widget.h", "util.h");
+    EXPECT_EQ(1u, data->definition_uses.count(util));
+    EXPECT_EQ(0u, data->forward_declarable_type_references.count(util));
+
+    project.add(data, ci->getSourceManager());
+  }
+};
+
+size_t definitionUses = 0;
+size_t forwardDeclarableTypeReferences = 0;
+
+class DefaultDetailsTool {
+private:
+  clangmetatool::collectors::IncludeGraph includeGraph;
+
+public:
+  DefaultDetailsTool(clang::CompilerInstance *ci,
+                     clang::ast_matchers::MatchFinder *f)
+      : includeGraph(ci, f) {}
+
+  void postProcessing(
+      std::map<std::string, clang::tooling::Replacements> &replacementsMap) {
+    IncludeGraphData *data = includeGraph.getData();
+    definitionUses += data->definition_uses.size();
+    forwardDeclarableTypeReferences +=
+        data->forward_declarable_type_references.size();
+  }
+};
+
+/**
+ * Whether each file of shapes.cpp needs the definition of shape.h.
+ */
+std::map<std::string, bool> needsShapeDefinition;
+
+class ShapesTool {
+private:
+  clangmetatool::collectors::IncludeGraph includeGraph;
+
+public:
+  ShapesTool(clang::CompilerInstance *ci, clang::ast_matchers::MatchFinder *f)
+      : includeGraph(ci, f, IncludeGraphData::ForwardDeclarationDetails) {}
+
+  void postProcessing(
+      std::map<std::string, clang::tooling::Replacements> &replacementsMap) {
+    IncludeGraphData *data = includeGraph.getData();
+    for (const char *name :
+         {"keep_shape.h", "delete_shape.h", "base_of_shape.h", "next_shape.h",
+          "shape_at.h", "copy_shape.h"}) {
+      FileGraphEdge edge = edgeOf(data, name, "shape.h");
+      EXPECT_EQ(1u, data->use_graph.count(edge)) << name;
+      needsShapeDefinition[name] = data->definition_uses.count(edge);
+    }
+  }
+};
+
+} // anonymous namespace
+
+TEST(ForwardDeclarationFinder, findsIncludesOfPointedTypes) {
+  llvm::cl::OptionCategory MyToolCategory("my-tool options");
+
+  std::string a = dataDir + "a.cpp";
+  std::string b = dataDir + "b.cpp";
+  const char *argv[] = {"foo", a.c_str(), b.c_str(), "--", "-xc++"};
+  int argc = sizeof(argv) / sizeof(argv[0]);
+
+  auto result = clang::tooling::CommonOptionsParser::create(
+      argc, argv, MyToolCategory, llvm::cl::OneOrMore);
+  ASSERT_TRUE(!!result);
+  clang::tooling::CommonOptionsParser &optionsParser = result.get();
+
+  std::map<std::string, clang::tooling::Replacements> replacements;
+  clangmetatool::MetaToolFactory<clangmetatool::MetaTool<MyTool>> raf(
+      replacements);
+  ASSERT_EQ(0, raf.runParallel(optionsParser.getCompilations(),
+                               optionsParser.getSourcePathList(), 2));
+
+  IncludeGraphData data = project.getData();
+
+  // a.cpp calls a member of Gadget, which it gets through widget.h
+  EXPECT_EQ(1u,
+            data.definition_uses.count(edgeOf(&data, "a.cpp", "gadget.h")));
+
+  std::map<FileUID, HeaderCostReport::Size> sizes;
+  for (const char *name :
+       {"a.cpp", "b.cpp", "widget.h", "gadget.h", "part.h", "util.h"}) {
+    sizes[data.path2fuid[realPath(name)]].bytes = 100;
+  }
+  sizes[data.path2fuid[realPath("util.h")]].bytes = 50;
+
+  ForwardDeclarationFinder finder(&data, HeaderCostReport(&data, sizes));
+  const std::vector<ForwardDeclarationFinder::Candidate> &candidates =
+      finder.getCandidates();
+  ASSERT_EQ(2u, candidates.size());
+
+  // Without gadget.h, a.cpp stops reaching gadget.h and part.h, b.cpp
+  // includes it itself
+  EXPECT_EQ(edgeOf(&data, "widget.h", "gadget.h"), candidates[0].edge);
+  EXPECT_EQ(realPath("widget.h"), candidates[0].includer);
+  EXPECT_EQ(realPath("gadget.h"), candidates[0].included);
+  EXPECT_EQ(std::vector<FileUID>{data.path2fuid[realPath("gadget.h")]},
+            candidates[0].declared);
+  EXPECT_EQ(std::vector<FileUID>{data.path2fuid[realPath("a.cpp")]},
+            candidates[0].dependents);
+  EXPECT_EQ(200u, candidates[0].saved.bytes);
+  EXPECT_EQ(1u, candidates[0].translationUnits);
+
+  // b.cpp only takes a Widget by reference
+  EXPECT_EQ(edgeOf(&data, "b.cpp", "widget.h"), candidates[1].edge);
+  EXPECT_EQ(std::vector<FileUID>{data.path2fuid[realPath("widget.h")]},
+            candidates[1].declared);
+  EXPECT_TRUE(candidates[1].dependents.empty());
+  EXPECT_EQ(150u, candidates[1].saved.bytes);
+}
+
+TEST(ForwardDeclarationFinder, isNotCollectedByDefault) {
+  llvm::cl::OptionCategory MyToolCategory("my-tool options");
+
+  std::string a = dataDir + "a.cpp";
+  const char *argv[] = {"foo", a.c_str(), "--", "-xc++"};
+  int argc = sizeof(argv) / sizeof(argv[0]);
+
+  auto result = clang::tooling::CommonOptionsParser::create(
+      argc, argv, MyToolCategory, llvm::cl::OneOrMore);
+  ASSERT_TRUE(!!result);
+  clang::tooling::CommonOptionsParser &optionsParser = result.get();
+
+  clang::tooling::ClangTool tool(optionsParser.getCompilations(),
+                                 optionsParser.getSourcePathList());
+  std::map<std::string, clang::tooling::Replacements> replacements;
+  clangmetatool::MetaToolFactory<clangmetatool::MetaTool<DefaultDetailsTool>>
+      raf(replacements);
+  ASSERT_EQ(0, tool.run(&raf));
+
+  EXPECT_EQ(0u, definitionUses);
+  EXPECT_EQ(0u, forwardDeclarableTypeReferences);
+}
+
+TEST(ForwardDeclarationFinder, recordsUsesThroughPointers) {
+  llvm::cl::OptionCategory MyToolCategory("my-tool options");
+
+  std::string shapes = dataDir + "shapes.cpp";
+  const char *argv[] = {"foo", shapes.c_str(), "--", "-xc++"};
+  int argc = sizeof(argv) / sizeof(argv[0]);
+
+  auto result = clang::tooling::CommonOptionsParser::create(
+      argc, argv, MyToolCategory, llvm::cl::OneOrMore);
+  ASSERT_TRUE(!!result);
+  clang::tooling::CommonOptionsParser &optionsParser = result.get();
+
+  clang::tooling::ClangTool tool(optionsParser.getCompilations(),
+                                 optionsParser.getSourcePathList());
+  std::map<std::string, clang::tooling::Replacements> replacements;
+  clangmetatool::MetaToolFactory<clangmetatool::MetaTool<ShapesTool>> raf(
+      replacements);
+  ASSERT_EQ(0, tool.run(&raf));
+
+  // Every file names Shape behind a pointer only, but all except
+  // keep_shape.h need its size or its bases
+  EXPECT_FALSE(needsShapeDefinition["keep_shape.h"]);
+  EXPECT_TRUE(needsShapeDefinition["delete_shape.h"]);
+  EXPECT_TRUE(needsShapeDefinition["base_of_shape.h"]);
+  EXPECT_TRUE(needsShapeDefinition["next_shape.h"]);
+  EXPECT_TRUE(needsShapeDefinition["shape_at.h"]);
+  EXPECT_TRUE(needsShapeDefinition["copy_shape.h"]);
+}
+
+// ----------------------------------------------------------------------------
+// Copyright 2026 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
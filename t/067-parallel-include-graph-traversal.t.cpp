@@ -0,0 +1,152 @@
+#include "clangmetatool-testconfig.h"
+
+#include <atomic>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <clangmetatool/collectors/include_graph_data.h>
+#include <clangmetatool/include_graph_csr.h>
+#include <clangmetatool/include_graph_dependencies.h>
+#include <clangmetatool/parallel_executor.h>
+#include <clangmetatool/parallel_include_graph_traversal.h>
+
+#include <llvm/ADT/BitVector.h>
+
+namespace {
+
+using clangmetatool::IncludeGraphCSR;
+using clangmetatool::IncludeGraphDependencies;
+using clangmetatool::ParallelExecutor;
+using clangmetatool::ParallelIncludeGraphTraversal;
+using clangmetatool::collectors::IncludeGraphData;
+using clangmetatool::types::FileUID;
+
+/**
+ * A graph of numFiles files that mostly include files after them, with
+ * a few includes back to make cycles, and uses along some of them.
+ */
+IncludeGraphData randomGraph(std::mt19937 &rng, unsigned numFiles,
+                             unsigned numIncludes) {
+  IncludeGraphData data;
+  for (FileUID file = 0; file < numFiles; ++file) {
+    data.fuid2name[file] = "file" + std::to_string(file);
+    for (unsigned i = 0; i < numIncludes; ++i) {
+      FileUID included = rng() % numFiles;
+      if (included > file || rng() % 10 == 0) {
+        data.include_graph.insert({file, included});
+      }
+      if (rng() % 3 == 0) {
+        data.usage_reference_count[{file, FileUID(rng() % numFiles)}] =
+            rng() % 2;
+      }
+    }
+  }
+  return data;
+}
+
+} // anonymous namespace
+
+TEST(ParallelIncludeGraphTraversal, matchesSequentialTraversals) {
+  std::mt19937 rng(67);
+  ParallelExecutor executor(4);
+
+  // Small graphs check every file, large ones have levels big enough to
+  // be split in jobs and to go bottom-up
+  for (unsigned numFiles : {1u, 7u, 40u, 50000u}) {
+    IncludeGraphData data = randomGraph(rng, numFiles, 5);
+    IncludeGraphCSR csr(&data);
+    ParallelIncludeGraphTraversal traversal(&csr, &executor);
+
+    for (unsigned i = 0; i < 40 && i < numFiles; ++i) {
+      FileUID file = numFiles > 40 ? rng() % numFiles : i;
+      EXPECT_EQ(IncludeGraphDependencies::collectAllIncludes(&csr, file),
+                IncludeGraphDependencies::collectAllIncludes(&traversal, file))
+          << numFiles << " " << file;
+      EXPECT_EQ(IncludeGraphDependencies::liveDependencies(&csr, file),
+                IncludeGraphDependencies::liveDependencies(&traversal, file))
+          << numFiles << " " << file;
+      EXPECT_EQ(
+          IncludeGraphDependencies::liveWeakDependencies(&csr, file),
+          IncludeGraphDependencies::liveWeakDependencies(&traversal, file))
+          << numFiles << " " << file;
+    }
+  }
+}
+
+TEST(ParallelIncludeGraphTraversal, reachesUnknownFileAlone) {
+  IncludeGraphData data;
+  data.include_graph.insert({1, 2});
+  IncludeGraphCSR csr(&data);
+  ParallelExecutor executor(2);
+  ParallelIncludeGraphTraversal traversal(&csr, &executor);
+
+  EXPECT_EQ(std::set<FileUID>({1, 2}),
+            IncludeGraphDependencies::collectAllIncludes(&traversal, 1));
+  EXPECT_EQ(std::set<FileUID>({3}),
+            IncludeGraphDependencies::collectAllIncludes(&traversal, 3));
+}
+
+TEST(ParallelIncludeGraphTraversal, labelsManySources) {
+  std::mt19937 rng(670);
+  ParallelExecutor executor(4);
+  IncludeGraphData data = randomGraph(rng, 20000, 5);
+  IncludeGraphCSR csr(&data);
+  ParallelIncludeGraphTraversal traversal(&csr, &executor);
+
+  // More than one batch of sources, with a repeated one
+  std::vector<ParallelIncludeGraphTraversal::Index> sources;
+  for (unsigned i = 0; i < 150; ++i) {
+    sources.push_back(rng() % csr.numNodes());
+  }
+  sources.push_back(sources[3]);
+  std::vector<ParallelIncludeGraphTraversal::Index> targets;
+  for (unsigned i = 0; i < 200; ++i) {
+    targets.push_back(rng() % csr.numNodes());
+  }
+
+  std::vector<llvm::BitVector> labels =
+      traversal.reachingSources(sources, targets);
+  ASSERT_EQ(targets.size(), labels.size());
+  for (size_t s = 0; s < sources.size(); ++s) {
+    llvm::BitVector reached = traversal.reach(sources[s]);
+    for (size_t t = 0; t < targets.size(); ++t) {
+      EXPECT_EQ(reached.test(targets[t]), labels[t].test(s)) << s << " " << t;
+    }
+  }
+}
+
+TEST(ParallelExecutor, reusesWorkersAndRunsNestedJobs) {
+  ParallelExecutor executor(4);
+  std::atomic<size_t> sum(0);
+  for (unsigned i = 0; i < 100; ++i) {
+    executor.run(10, [&](size_t job) { sum += job; });
+  }
+  EXPECT_EQ(100u * 45u, sum.load());
+
+  // A job running jobs of its own can't wait for the busy workers
+  sum = 0;
+  executor.run(4, [&](size_t) {
+    executor.run(10, [&](size_t job) { sum += job; });
+  });
+  EXPECT_EQ(4u * 45u, sum.load());
+}
+
+// ----------------------------------------------------------------------------
+// Copyright 2026 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
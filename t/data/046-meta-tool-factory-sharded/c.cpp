@@ -0,0 +1 @@
+int c_function() { return 2; }
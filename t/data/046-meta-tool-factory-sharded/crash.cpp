@@ -0,0 +1,3 @@
+#include "shared.h"
+
+int crash_function() { return 3; }
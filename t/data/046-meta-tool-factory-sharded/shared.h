@@ -0,0 +1 @@
+void shared_function();
@@ -0,0 +1 @@
+int light() { return 0; }
@@ -0,0 +1,3 @@
+#include "shared.h"
+
+int a_function() { return 0; }
@@ -0,0 +1,6 @@
+#include "common.h"
+#include "other.h"
+
+int a_function() {
+  return common_function() + other_function() + COMMON_VALUE;
+}
@@ -0,0 +1,5 @@
+#include "common.h"
+#include "other.h"
+#define B_VALUE 1
+
+int b_function() { return common_function() + B_VALUE + COMMON_VALUE; }
@@ -0,0 +1,3 @@
+#include "other.h"
+
+int c_function() { return other_function(); }
@@ -0,0 +1,8 @@
+#ifndef INCLUDED_COMMON_H
+#define INCLUDED_COMMON_H
+
+#define COMMON_VALUE 2
+
+int common_function();
+
+#endif
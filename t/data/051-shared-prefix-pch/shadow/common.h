@@ -0,0 +1 @@
+#define SHADOWED_COMMON 1
@@ -0,0 +1 @@
+int a_function() { return 0; }
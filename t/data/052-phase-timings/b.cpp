@@ -0,0 +1,3 @@
+struct B { int value; };
+
+int b_function(B b) { return b.value; }
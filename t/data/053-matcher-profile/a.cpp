@@ -0,0 +1,3 @@
+#include "a.h"
+
+int a_function() { return A_VALUE; }
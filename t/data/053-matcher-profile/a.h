@@ -0,0 +1 @@
+#define A_VALUE 42
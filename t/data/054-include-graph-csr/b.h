@@ -0,0 +1,7 @@
+#ifndef B_H
+#define B_H
+
+#include "def1.h"
+#include "def2.h"
+
+#endif
@@ -0,0 +1,6 @@
+#ifndef DIAM_H
+#define DIAM_H
+
+#include "def2.h"
+
+#endif
@@ -0,0 +1,9 @@
+#include "a.h"
+#include "b.h"
+#include "diam.h"
+#include "unused.h"
+
+int foo() {
+  C c;
+  return B + c.value;
+}
@@ -0,0 +1,6 @@
+#ifndef UNUSED_H
+#define UNUSED_H
+
+int unused();
+
+#endif
@@ -0,0 +1,8 @@
+#ifndef A_H
+#define A_H
+
+#include "b.h"
+
+const int A = 1;
+
+#endif
@@ -0,0 +1,7 @@
+#ifndef B_H
+#define B_H
+
+#include "a.h"
+#include "d.h"
+
+#endif
@@ -0,0 +1,6 @@
+#ifndef C_H
+#define C_H
+
+#include "d.h"
+
+#endif
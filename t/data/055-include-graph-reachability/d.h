@@ -0,0 +1,6 @@
+#ifndef D_H
+#define D_H
+
+const int D = 2;
+
+#endif
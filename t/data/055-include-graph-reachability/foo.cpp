@@ -0,0 +1,4 @@
+#include "a.h"
+#include "c.h"
+
+int foo() { return A + D; }
@@ -0,0 +1,6 @@
+#ifndef A_H
+#define A_H
+
+#include "def1.h"
+
+#endif
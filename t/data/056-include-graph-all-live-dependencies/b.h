@@ -0,0 +1,8 @@
+#ifndef B_H
+#define B_H
+
+#include "def1.h"
+#include "def2.h"
+#include "b2.h"
+
+#endif
@@ -0,0 +1,9 @@
+#ifndef B2_H
+#define B2_H
+
+#include "b.h"
+#include "def3.h"
+
+inline int b2() { return D3; }
+
+#endif
@@ -0,0 +1,6 @@
+#ifndef DEF1_H
+#define DEF1_H
+
+extern int B;
+
+#endif
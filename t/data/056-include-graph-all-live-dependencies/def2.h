@@ -0,0 +1,8 @@
+#ifndef DEF2_H
+#define DEF2_H
+
+struct C {
+  int value;
+};
+
+#endif
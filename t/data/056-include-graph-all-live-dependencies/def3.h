@@ -0,0 +1,6 @@
+#ifndef DEF3_H
+#define DEF3_H
+
+#define D3 3
+
+#endif
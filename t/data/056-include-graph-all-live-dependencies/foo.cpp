@@ -0,0 +1,8 @@
+#include "a.h"
+#include "b.h"
+#include "diam.h"
+
+int foo() {
+  C c;
+  return B + c.value + D3;
+}
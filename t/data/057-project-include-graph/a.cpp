@@ -0,0 +1,5 @@
+#include "common.h"
+#include "only_a.h"
+#include "placeholder_a.h"
+
+int a() { return common_value() + only_a(); }
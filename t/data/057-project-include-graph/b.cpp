@@ -0,0 +1,4 @@
+#include "common.h"
+#include "placeholder_b.h"
+
+int b() { return common_value(); }
@@ -0,0 +1,3 @@
+#include "copy/common.h"
+
+int c() { return common_value() * 2; }
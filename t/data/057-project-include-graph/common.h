@@ -0,0 +1,3 @@
+#include "detail.h"
+
+inline int common_value() { return detail_value(); }
@@ -0,0 +1,2 @@
+#include "limits.h"
+#include "point.h"
@@ -0,0 +1,8 @@
+#include "all.h"
+#include "limits.h"
+
+int foo() {
+  Point p;
+  p.x = origin();
+  return p.x + LIMIT;
+}
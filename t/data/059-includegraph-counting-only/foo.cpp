@@ -0,0 +1,10 @@
+#include "macros.h"
+#include "widget.h"
+
+void reset();
+
+int foo() {
+  Widget w;
+  w.size = make_size() * SCALE;
+  return w.size;
+}
@@ -0,0 +1,7 @@
+struct Widget {
+  int size;
+};
+
+int make_size();
+
+void reset();
@@ -0,0 +1,5 @@
+#include "a.h"
+#include "b.h"
+#include "b.h"
+
+int foo() { return a() + b(); }
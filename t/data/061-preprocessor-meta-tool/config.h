@@ -0,0 +1,4 @@
+#pragma once
+
+#define VERSION 2
+#define TWICE(x) ((x) * 2)
@@ -0,0 +1,6 @@
+#include "config.h"
+#include "item.h"
+
+#if VERSION > 1
+int foo(Item i) { return TWICE(i.weight); }
+#endif
@@ -0,0 +1,7 @@
+#pragma once
+
+#include "config.h"
+
+struct Item {
+  int weight;
+};
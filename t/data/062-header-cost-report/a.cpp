@@ -0,0 +1,4 @@
+#include "big.h"
+#include "small.h"
+
+int a() { return big0() + small(); }
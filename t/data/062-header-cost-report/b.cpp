@@ -0,0 +1,3 @@
+#include "big.h"
+
+int b() { return big1(); }
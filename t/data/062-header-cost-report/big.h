@@ -0,0 +1,44 @@
+#pragma once
+
+#include "detail.h"
+
+inline int big0() { return detail() + 0; }
+inline int big1() { return detail() + 1; }
+inline int big2() { return detail() + 2; }
+inline int big3() { return detail() + 3; }
+inline int big4() { return detail() + 4; }
+inline int big5() { return detail() + 5; }
+inline int big6() { return detail() + 6; }
+inline int big7() { return detail() + 7; }
+inline int big8() { return detail() + 8; }
+inline int big9() { return detail() + 9; }
+inline int big10() { return detail() + 10; }
+inline int big11() { return detail() + 11; }
+inline int big12() { return detail() + 12; }
+inline int big13() { return detail() + 13; }
+inline int big14() { return detail() + 14; }
+inline int big15() { return detail() + 15; }
+inline int big16() { return detail() + 16; }
+inline int big17() { return detail() + 17; }
+inline int big18() { return detail() + 18; }
+inline int big19() { return detail() + 19; }
+inline int big20() { return detail() + 20; }
+inline int big21() { return detail() + 21; }
+inline int big22() { return detail() + 22; }
+inline int big23() { return detail() + 23; }
+inline int big24() { return detail() + 24; }
+inline int big25() { return detail() + 25; }
+inline int big26() { return detail() + 26; }
+inline int big27() { return detail() + 27; }
+inline int big28() { return detail() + 28; }
+inline int big29() { return detail() + 29; }
+inline int big30() { return detail() + 30; }
+inline int big31() { return detail() + 31; }
+inline int big32() { return detail() + 32; }
+inline int big33() { return detail() + 33; }
+inline int big34() { return detail() + 34; }
+inline int big35() { return detail() + 35; }
+inline int big36() { return detail() + 36; }
+inline int big37() { return detail() + 37; }
+inline int big38() { return detail() + 38; }
+inline int big39() { return detail() + 39; }
@@ -0,0 +1,4 @@
+#pragma once
+
+#include "detail.h"
+int small();
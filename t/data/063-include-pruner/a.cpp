@@ -0,0 +1,6 @@
+#include "used.h"
+#include "unused.h"
+#include "kept.h" // IWYU pragma: keep
+#include "shared.h"
+
+int a() { return used() + extra(); }
@@ -0,0 +1,5 @@
+#include "first.h"
+#include "second.h"
+#include "wrapper.h"
+
+int c() { return second(); }
@@ -0,0 +1,4 @@
+#pragma once
+
+// Relies on order_a.h being included before
+inline int order_b() { return order_a(); }
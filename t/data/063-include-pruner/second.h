@@ -0,0 +1,4 @@
+#pragma once
+
+// Relies on first.h being included before
+inline int second() { return first(); }
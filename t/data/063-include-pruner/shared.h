@@ -0,0 +1,5 @@
+#pragma once
+
+#include "extra.h"
+#include "helper.h"
+#include "unused.h"
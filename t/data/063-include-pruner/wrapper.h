@@ -0,0 +1,6 @@
+#pragma once
+
+#include "order_a.h"
+#include "order_b.h"
+
+inline int wrapper() { return order_b(); }
@@ -0,0 +1,5 @@
+#include "common.h"
+#include "fresh.h"
+#include "rare.h"
+
+int a() { return common() + fresh() + rare(); }
@@ -0,0 +1,4 @@
+#include "common.h"
+#include "fresh.h"
+
+int b() { return common() + fresh(); }
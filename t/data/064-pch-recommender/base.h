@@ -0,0 +1,3 @@
+#pragma once
+
+inline int base() { return 41; }
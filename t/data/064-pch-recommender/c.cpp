@@ -0,0 +1,3 @@
+#include "common.h"
+
+int c() { return common(); }
@@ -0,0 +1,5 @@
+#pragma once
+
+#include "base.h"
+
+inline int common() { return base() + 1; }
@@ -0,0 +1,3 @@
+#pragma once
+
+inline int fresh() { return 2; }
@@ -0,0 +1,3 @@
+#pragma once
+
+inline int rare() { return 3; }
@@ -0,0 +1,6 @@
+#include "common.h"
+#include "heavy.h"
+
+static int helper() { return 1; }
+
+int a() { return helper() + heavy(); }
@@ -0,0 +1,8 @@
+#include "common.h"
+#include "heavy.h"
+
+namespace {
+int counter = 0;
+}
+
+int b() { return counter + heavy(); }
@@ -0,0 +1,5 @@
+#include "other.h"
+
+static int helper() { return 3; }
+
+int c() { return helper() + other(); }
@@ -0,0 +1,8 @@
+#include "common.h"
+#include "heavy.h"
+
+namespace {
+int helper() { return 2; }
+} // namespace
+
+int d() { return helper() + heavy(); }
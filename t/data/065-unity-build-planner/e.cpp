@@ -0,0 +1,4 @@
+#include "common.h"
+#include "heavy.h"
+
+int counter() { return heavy(); }
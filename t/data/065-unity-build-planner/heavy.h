@@ -0,0 +1,5 @@
+#pragma once
+
+#include "common.h"
+
+inline int heavy() { return common() * 2; }
@@ -0,0 +1,3 @@
+#include "widget.h"
+
+int use(Widget &widget) { return widget.gadget->size(); }
@@ -0,0 +1,4 @@
+#include "gadget.h"
+#include "widget.h"
+
+int use(Widget &widget, Gadget &gadget) { return gadget.part.value; }
@@ -0,0 +1,8 @@
+#ifndef INCLUDED_BASE_OF_SHAPE_H
+#define INCLUDED_BASE_OF_SHAPE_H
+
+#include "shape.h"
+
+inline Base *baseOfShape(Shape *shape) { return shape; }
+
+#endif
@@ -0,0 +1,10 @@
+#ifndef INCLUDED_COPY_SHAPE_H
+#define INCLUDED_COPY_SHAPE_H
+
+#include "shape.h"
+
+void takeShape(Shape shape);
+
+inline void copyShape(const Shape *shape) { takeShape(*shape); }
+
+#endif
@@ -0,0 +1,8 @@
+#ifndef INCLUDED_DELETE_SHAPE_H
+#define INCLUDED_DELETE_SHAPE_H
+
+#include "shape.h"
+
+inline void deleteShape(Shape *shape) { delete shape; }
+
+#endif
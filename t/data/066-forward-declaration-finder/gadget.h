@@ -0,0 +1,12 @@
+#ifndef INCLUDED_GADGET_H
+#define INCLUDED_GADGET_H
+
+#include "part.h"
+
+class Gadget {
+public:
+  int size() const;
+  Part part;
+};
+
+#endif
@@ -0,0 +1,8 @@
+#ifndef INCLUDED_NEXT_SHAPE_H
+#define INCLUDED_NEXT_SHAPE_H
+
+#include "shape.h"
+
+inline Shape *nextShape(Shape *shape) { return shape + 1; }
+
+#endif
@@ -0,0 +1,8 @@
+#ifndef INCLUDED_PART_H
+#define INCLUDED_PART_H
+
+struct Part {
+  int value;
+};
+
+#endif
@@ -0,0 +1,14 @@
+#ifndef INCLUDED_SHAPE_H
+#define INCLUDED_SHAPE_H
+
+class Base {
+public:
+  int size;
+};
+
+class Shape : public Base {
+public:
+  int sides;
+};
+
+#endif
@@ -0,0 +1,8 @@
+#ifndef INCLUDED_SHAPE_AT_H
+#define INCLUDED_SHAPE_AT_H
+
+#include "shape.h"
+
+inline Shape *shapeAt(Shape *shapes, int i) { return &shapes[i]; }
+
+#endif
@@ -0,0 +1,6 @@
+#include "base_of_shape.h"
+#include "copy_shape.h"
+#include "delete_shape.h"
+#include "keep_shape.h"
+#include "next_shape.h"
+#include "shape_at.h"
@@ -0,0 +1,8 @@
+#ifndef INCLUDED_UTIL_H
+#define INCLUDED_UTIL_H
+
+struct Util {
+  int value;
+};
+
+#endif
@@ -0,0 +1,16 @@
+#ifndef INCLUDED_WIDGET_H
+#define INCLUDED_WIDGET_H
+
+#include "gadget.h"
+#include "util.h"
+
+class Widget {
+public:
+  Gadget *gadget;
+  Util util;
+};
+
+void attach(Widget &widget, Gadget gadget);
+Gadget copy(const Widget &widget);
+
+#endif